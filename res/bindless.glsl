@@ -0,0 +1,86 @@
+// Bindless heap of VulkanBindlessHeap, bound at set 0 by VulkanRenderer::DrawGeometry. Include it with
+// GL_GOOGLE_include_directive and index the arrays with the slots returned by the Register functions.
+// Vertex shaders read the world matrix and material index through DrawWorldMatrix and DrawMaterialIndex, never from
+// g_draw directly: VulkanDrawInstancer merges the draws of any bindless material and VulkanGpuCuller draws the gpu
+// driven ones indirectly, both pass each object's data in a record instead of the push constants
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
+#extension GL_EXT_buffer_reference : require
+
+layout(set = 0, binding = 0) uniform texture2D g_textures[];
+layout(set = 0, binding = 1) uniform sampler g_samplers[];
+layout(set = 0, binding = 2) readonly buffer BindlessBuffer
+{
+    uint words[];
+} g_buffers[];
+
+// Matches GPUDrawPushConstants. Only the vertex stage sees it, pass materialIndex on to fragment shaders as a flat
+// output
+layout(push_constant) uniform DrawConstants
+{
+    mat4 worldMatrix;
+    uint64_t vertexBuffer;
+    uint materialIndex;
+    uint padding;
+    // Set for instanced and indirect draws, worldMatrix and materialIndex are unset then
+    uint64_t drawObjects;
+    // The frame's Hush GPUSceneData, see SceneViewProjection
+    uint64_t sceneData;
+} g_draw;
+
+vec4 SampleBindless(uint textureIndex, uint samplerIndex, vec2 uv)
+{
+    return texture(sampler2D(g_textures[nonuniformEXT(textureIndex)], g_samplers[nonuniformEXT(samplerIndex)]), uv);
+}
+
+// Matches Hush::GpuDrawObject
+struct DrawObject
+{
+    mat4 worldMatrix;
+    vec4 sphere;
+    vec4 extents;
+    uint indexCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint materialIndex;
+    uint batch;
+    uint padding0;
+    uint padding1;
+    uint padding2;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer DrawObjects
+{
+    DrawObject objects[];
+};
+
+// Matches GPUSceneData
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer SceneData
+{
+    mat4 viewProjection;
+};
+
+// VulkanGpuCuller puts the object's index in firstInstance, VulkanDrawInstancer the first record of the instances
+mat4 DrawWorldMatrix()
+{
+    if (g_draw.drawObjects != 0ul)
+    {
+        return DrawObjects(g_draw.drawObjects).objects[gl_InstanceIndex].worldMatrix;
+    }
+    return g_draw.worldMatrix;
+}
+
+// Camera projection times view of the frame, identity when the DrawContext has none
+mat4 SceneViewProjection()
+{
+    return SceneData(g_draw.sceneData).viewProjection;
+}
+
+uint DrawMaterialIndex()
+{
+    if (g_draw.drawObjects != 0ul)
+    {
+        return DrawObjects(g_draw.drawObjects).objects[gl_InstanceIndex].materialIndex;
+    }
+    return g_draw.materialIndex;
+}
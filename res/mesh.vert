@@ -0,0 +1,37 @@
+#version 460
+// Vertex shader of meshes in the geometry pool (Hush::VulkanGeometryPool). Every way the renderer records a draw works
+// with it: one by one, instanced by VulkanDrawInstancer and indirect from VulkanGpuCuller, which is what
+// MaterialPipeline::gpuDriven needs. Pair it with colored_triangle.frag, or any fragment shader reading the color at
+// location 0
+#extension GL_GOOGLE_include_directive : require
+
+#include "bindless.glsl"
+
+// Matches Vertex in MaterialDefinitions.hpp
+struct Vertex
+{
+    vec3 position;
+    float uvX;
+    vec3 normal;
+    float uvY;
+    vec4 color;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer Vertices
+{
+    Vertex vertices[];
+};
+
+layout(location = 0) out vec3 outColor;
+layout(location = 1) out vec2 outUV;
+layout(location = 2) flat out uint outMaterialIndex;
+
+void main()
+{
+    // gl_VertexIndex already includes the mesh's vertexOffset
+    Vertex vertex = Vertices(g_draw.vertexBuffer).vertices[gl_VertexIndex];
+    gl_Position = SceneViewProjection() * DrawWorldMatrix() * vec4(vertex.position, 1.0);
+    outColor = vertex.color.rgb;
+    outUV = vec2(vertex.uvX, vertex.uvY);
+    outMaterialIndex = DrawMaterialIndex();
+}
@@ -0,0 +1,119 @@
+/*! \file CullingBenchmark.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Frustum culls a million scattered objects, on one thread and on the job system, and reports the cost per
+    object
+*/
+
+#include "JobSystem.hpp"
+#include "Logger.hpp"
+#include "Shared/Camera.hpp"
+#include "Shared/FrustumCulling.hpp"
+
+#include <glm/ext/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+constexpr uint32_t DEFAULT_OBJECT_COUNT = 1'000'000;
+constexpr uint32_t REPETITIONS = 10;
+/// @brief Half the size of the cube the objects are scattered in, the camera sits at its center
+constexpr float WORLD_EXTENT = 500.0f;
+
+/// @brief Unit cubes with random positions, rotations and scales, the camera sees roughly a tenth of them
+static std::vector<RenderObject> CreateObjects(uint32_t count)
+{
+    std::mt19937 random(1234u);
+    std::uniform_real_distribution<float> position(-WORLD_EXTENT, WORLD_EXTENT);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> scale(0.5f, 4.0f);
+
+    std::vector<RenderObject> objects(count);
+    for (RenderObject &object : objects)
+    {
+        object = {};
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(position(random), position(random),
+                                                                         position(random)));
+        transform = glm::rotate(transform, angle(random), glm::normalize(glm::vec3(0.3f, 1.0f, 0.2f)));
+        object.transform = glm::scale(transform, glm::vec3(scale(random)));
+        object.bounds.origin = glm::vec3(0.0f);
+        object.bounds.extents = glm::vec3(1.0f);
+        object.bounds.sphereRadius = glm::length(object.bounds.extents);
+    }
+    return objects;
+}
+
+/// @return The best time of REPETITIONS runs, in nanoseconds per object
+static double MeasureNsPerObject(Hush::FrustumCuller &culler, const Hush::Frustum &frustum,
+                                 const std::vector<RenderObject> &objects, std::vector<uint32_t> &visible,
+                                 Hush::JobSystem *jobSystem)
+{
+    double bestNs = 1e30;
+    for (uint32_t repetition = 0; repetition < REPETITIONS; repetition++)
+    {
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        culler.Cull(frustum, objects, visible, jobSystem);
+        std::chrono::duration<double, std::nano> elapsed = BenchmarkClock::now() - start;
+        bestNs = std::min(bestNs, elapsed.count() / static_cast<double>(std::max<size_t>(objects.size(), 1u)));
+    }
+    return bestNs;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t objectCount = DEFAULT_OBJECT_COUNT;
+    if (argc > 2 && std::string_view(argv[1]) == "--objects")
+    {
+        objectCount = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+    }
+
+    std::vector<RenderObject> objects = CreateObjects(objectCount);
+    Hush::Camera camera(70.0f, 1920.0f, 1080.0f, 0.1f, WORLD_EXTENT);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.2f, 0.5f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Hush::Frustum frustum = camera.GetFrustum(view);
+
+    Hush::FrustumCuller culler;
+    std::vector<uint32_t> visible;
+    culler.Cull(frustum, objects, visible, nullptr);
+
+    // The SIMD lanes have to agree with the scalar test object for object
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < objectCount; i++)
+    {
+        if (Hush::FrustumCuller::IsVisible(frustum, objects[i]))
+        {
+            expected.push_back(i);
+        }
+    }
+    if (visible != expected)
+    {
+        Hush::LogFormat(Hush::ELogLevel::Error, "SIMD culling found {} visible objects, the scalar test found {}",
+                        visible.size(), expected.size());
+        return EXIT_FAILURE;
+    }
+
+    Hush::LogFormat(Hush::ELogLevel::Info, "Culling benchmark, {} objects, {} visible, {} objects per SIMD test",
+                    objectCount, visible.size(), Hush::FrustumCuller::SIMD_WIDTH);
+    Hush::LogInfo("threads | ns per object | ms per cull");
+
+    double singleThreadNs = MeasureNsPerObject(culler, frustum, objects, visible, nullptr);
+    Hush::LogFormat(Hush::ELogLevel::Info, "{:7} | {:13.3f} | {:11.3f}", 1, singleThreadNs,
+                    singleThreadNs * objectCount / 1e6);
+
+    Hush::JobSystem jobSystem;
+    double parallelNs = MeasureNsPerObject(culler, frustum, objects, visible, &jobSystem);
+    if (visible != expected)
+    {
+        Hush::LogError("Parallel culling disagrees with the single threaded result");
+        return EXIT_FAILURE;
+    }
+    Hush::LogFormat(Hush::ELogLevel::Info, "{:7} | {:13.3f} | {:11.3f}", jobSystem.GetThreadCount(), parallelNs,
+                    parallelNs * objectCount / 1e6);
+    return EXIT_SUCCESS;
+}
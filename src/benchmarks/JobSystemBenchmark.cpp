@@ -0,0 +1,95 @@
+/*! \file JobSystemBenchmark.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Measures the scheduling overhead of the job system and how it scales with the amount of threads
+*/
+
+#include "JobSystem.hpp"
+#include "Logger.hpp"
+
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+constexpr uint32_t EMPTY_JOB_COUNT = 100'000;
+constexpr uint32_t EMPTY_JOB_BATCH = 1024;
+constexpr uint32_t WORK_ITEM_COUNT = 1u << 22u;
+constexpr uint32_t WORK_BATCH_SIZE = 4096;
+constexpr uint32_t REPETITIONS = 5;
+
+/// @brief Schedules empty jobs in batches and waits on them, anything measured here is pure overhead
+static double MeasureOverheadPerJobNs(Hush::JobSystem &jobSystem)
+{
+    std::vector<Hush::Job> jobs(EMPTY_JOB_BATCH);
+    for (Hush::Job &job : jobs)
+    {
+        job.function = [](void *) {};
+    }
+
+    double bestNs = 1e30;
+    for (uint32_t repetition = 0; repetition < REPETITIONS; repetition++)
+    {
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (uint32_t scheduled = 0; scheduled < EMPTY_JOB_COUNT; scheduled += EMPTY_JOB_BATCH)
+        {
+            Hush::JobCounter counter;
+            jobSystem.Run(jobs.data(), EMPTY_JOB_BATCH, &counter);
+            jobSystem.WaitFor(counter);
+        }
+        std::chrono::duration<double, std::nano> elapsed = BenchmarkClock::now() - start;
+        bestNs = std::min(bestNs, elapsed.count() / EMPTY_JOB_COUNT);
+    }
+    return bestNs;
+}
+
+/// @brief Runs a CPU bound workload through ParallelFor
+static double MeasureWorkloadMs(Hush::JobSystem &jobSystem, std::vector<float> &values)
+{
+    double bestMs = 1e30;
+    for (uint32_t repetition = 0; repetition < REPETITIONS; repetition++)
+    {
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        jobSystem.ParallelFor(WORK_ITEM_COUNT, WORK_BATCH_SIZE, [&values](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                float value = static_cast<float>(i);
+                for (uint32_t iteration = 0; iteration < 16; iteration++)
+                {
+                    value = std::sqrt(value * 1.0001f + 1.0f);
+                }
+                values[i] = value;
+            }
+        });
+        std::chrono::duration<double, std::milli> elapsed = BenchmarkClock::now() - start;
+        bestMs = std::min(bestMs, elapsed.count());
+    }
+    return bestMs;
+}
+
+int main()
+{
+    uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<float> values(WORK_ITEM_COUNT);
+
+    Hush::LogFormat(Hush::ELogLevel::Info, "Job system benchmark, up to {} threads", maxThreads);
+    Hush::LogInfo("threads | overhead per job (ns) | workload (ms) | speedup");
+
+    double singleThreadMs = 0.0;
+    for (uint32_t threads = 1; threads <= maxThreads; threads++)
+    {
+        // The worker count doesn't include the calling thread
+        Hush::JobSystem jobSystem(threads - 1);
+        double overheadNs = MeasureOverheadPerJobNs(jobSystem);
+        double workloadMs = MeasureWorkloadMs(jobSystem, values);
+        if (threads == 1)
+        {
+            singleThreadMs = workloadMs;
+        }
+        Hush::LogFormat(Hush::ELogLevel::Info, "{:7} | {:21.1f} | {:13.2f} | {:7.2f}x", threads, overheadNs,
+                        workloadMs, singleThreadMs / workloadMs);
+    }
+    return 0;
+}
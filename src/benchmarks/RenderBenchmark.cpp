@@ -0,0 +1,300 @@
+/*! \file RenderBenchmark.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Renders a synthetic scene with a headless VulkanRenderer and reports CPU and GPU frame timings, runs on CI
+    machines without a display (e.g. lavapipe). With mesh.vert built, --readback 1 prints the same checksum with
+    --gpu-driven 0 and 1 only if the instanced and indirect draws read each object's own record
+*/
+
+#define VK_NO_PROTOTYPES
+#include "Logger.hpp"
+#include "Profiler.hpp"
+#include "Shared/Camera.hpp"
+#include "Vulkan/VulkanPipelineBuilder.hpp"
+#include "Vulkan/VulkanRenderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <glm/ext/matrix_transform.hpp>
+#include <map>
+#include <string_view>
+#include <vector>
+#include <volk.h>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+constexpr uint32_t WARMUP_FRAMES = 16;
+
+struct BenchmarkOptions
+{
+    uint32_t frames = 500;
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    uint32_t draws = 1000;
+    bool readback = false;
+    /// @brief Draws the scene through VulkanGpuCuller's indirect draws instead of one vkCmdDrawIndexed each
+    bool gpuDriven = false;
+};
+
+/// @brief GPU objects of the synthetic scene, every draw is the same triangle placed by its own transform. Without
+/// mesh.vert.spv it falls back to colored_triangle.vert, which ignores the transforms but keeps the per draw cost
+struct BenchmarkScene
+{
+    MaterialPipeline pipeline{};
+    MaterialInstance material{};
+    MeshGeometry triangle{};
+    /// @brief Looks at the grid FillDrawContext lays out, every draw is inside its frustum
+    Hush::Camera camera{};
+    glm::mat4 view{1.0f};
+};
+
+static BenchmarkOptions ParseOptions(int argc, char *argv[])
+{
+    BenchmarkOptions options;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string_view argument = argv[i];
+        auto value = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        if (argument == "--frames")
+        {
+            options.frames = value;
+        }
+        else if (argument == "--width")
+        {
+            options.width = value;
+        }
+        else if (argument == "--height")
+        {
+            options.height = value;
+        }
+        else if (argument == "--draws")
+        {
+            options.draws = value;
+        }
+        else if (argument == "--readback")
+        {
+            options.readback = value != 0u;
+        }
+        else if (argument == "--gpu-driven")
+        {
+            options.gpuDriven = value != 0u;
+        }
+        else
+        {
+            Hush::LogFormat(Hush::ELogLevel::Warn, "Unknown benchmark argument {}", argument);
+        }
+    }
+    return options;
+}
+
+static void CreateScene(Hush::VulkanRenderer &renderer, BenchmarkScene &scene, bool gpuDriven)
+{
+    // mesh.vert is compiled by the build, the fragment shader is the renderer's triangle one
+    const Hush::ShaderAsset *vertexShader = renderer.GetShaderLibrary().Load("mesh.vert.spv");
+    if (vertexShader == nullptr)
+    {
+        Hush::LogWarn("mesh.vert.spv was not built, drawing colored_triangle.vert without the transforms");
+        vertexShader = renderer.GetShaderLibrary().Load("colored_triangle.vert.spv");
+    }
+    const Hush::ShaderAsset *fragmentShader = renderer.GetShaderLibrary().Load("colored_triangle.frag.spv");
+    HUSH_ASSERT(vertexShader != nullptr && fragmentShader != nullptr, "Could not load the benchmark shaders");
+
+    // The bindless layout declares the draw constants DrawRenderObject pushes, and the draws never bind a set
+    scene.pipeline.layout = renderer.GetBindlessPipelineLayout();
+
+    Hush::VulkanPipelineBuilder pipelineBuilder(scene.pipeline.layout);
+    pipelineBuilder.SetShaders(vertexShader->module, fragmentShader->module)
+        .SetInputTopology(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST)
+        .SetPolygonMode(VK_POLYGON_MODE_FILL)
+        .SetCullMode(VK_CULL_MODE_NONE, VK_FRONT_FACE_CLOCKWISE)
+        .SetMultiSamplingNone()
+        .DisableBlending()
+        .DisableDepthTest()
+        .SetColorAttachmentFormat(renderer.GetDrawImageFormat())
+        .SetDepthFormat(renderer.GetDepthImageFormat());
+    scene.pipeline.registered = renderer.GetPipelineRegistry().Acquire(pipelineBuilder);
+    HUSH_ASSERT(scene.pipeline.registered != nullptr, "Could not build the benchmark pipeline");
+    scene.pipeline.pipeline = scene.pipeline.registered->Get();
+    // Instanced either way: mesh.vert reads the draw's record when there is one, colored_triangle.vert reads no per
+    // draw data at all. gpuDriven only moves the draws to VulkanGpuCuller
+    scene.pipeline.gpuDriven = gpuDriven;
+
+    scene.material.pipeline = &scene.pipeline;
+    scene.material.materialSet = nullptr;
+    scene.material.passType = EMaterialPass::MainColor;
+
+    // The same triangle colored_triangle.vert builds from gl_VertexIndex. It goes through the geometry pool like any
+    // mesh would, the first frame waits for its upload
+    const Vertex vertices[] = {
+        {glm::vec3(1.0f, 1.0f, 0.0f), 0.0f, glm::vec3(0.0f, 0.0f, 1.0f), 0.0f, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)},
+        {glm::vec3(-1.0f, 1.0f, 0.0f), 0.0f, glm::vec3(0.0f, 0.0f, 1.0f), 0.0f, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f)},
+        {glm::vec3(0.0f, -1.0f, 0.0f), 0.0f, glm::vec3(0.0f, 0.0f, 1.0f), 0.0f, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)},
+    };
+    constexpr uint32_t indices[] = {0u, 1u, 2u};
+    scene.triangle = renderer.GetGeometryPool().AddMesh(renderer.GetUploadManager(), vertices, 3u, indices, 3u);
+    HUSH_ASSERT(scene.triangle.indexCount == 3u, "Could not add the benchmark triangle to the geometry pool");
+
+    // Orthographic over the [-1, 1] grid at z = 0, one unit away. Vulkan's [0, 1] depth, reversed like the renderer's
+    constexpr float nearPlane = 0.1f;
+    constexpr float farPlane = 10.0f;
+    scene.camera.SetProjectionMatrix(glm::orthoRH_ZO(-1.0f, 1.0f, -1.0f, 1.0f, farPlane, nearPlane),
+                                     glm::orthoRH_ZO(-1.0f, 1.0f, -1.0f, 1.0f, nearPlane, farPlane));
+    scene.view = glm::lookAt(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+static void DestroyScene(Hush::VulkanRenderer &renderer, BenchmarkScene &scene)
+{
+    VkDevice device = renderer.GetVulkanDevice();
+    vkDeviceWaitIdle(device);
+    renderer.RemoveMeshAfterFrame(scene.triangle);
+    renderer.ReleasePipelineAfterFrame(scene.pipeline.registered);
+}
+
+/// @brief Lays the transforms out on a grid covering the draw image. The scene's camera sees all of it, so the frustum
+/// and occlusion culling run their full cost without dropping a draw. The triangles never overlap, so the image doesn't
+/// depend on the order the draws were recorded or compacted in
+static void FillDrawContext(DrawContext &drawContext, BenchmarkScene &scene, uint32_t draws, uint32_t frame)
+{
+    drawContext.opaqueSurfaces.clear();
+    drawContext.transparentSurfaces.clear();
+    drawContext.SetCamera(scene.camera, scene.view);
+    auto columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(std::max(draws, 1u)))));
+    float cellSize = 2.0f / static_cast<float>(columns);
+    float wobble = 0.1f * std::sin(static_cast<float>(frame) * 0.05f);
+    for (uint32_t i = 0; i < draws; i++)
+    {
+        float x = -1.0f + (static_cast<float>(i % columns) + 0.5f) * cellSize;
+        float y = -1.0f + (static_cast<float>(i / columns) + 0.5f) * cellSize;
+
+        RenderObject &renderObject = drawContext.opaqueSurfaces.emplace_back();
+        renderObject.indexCount = scene.triangle.indexCount;
+        renderObject.firstIndex = scene.triangle.firstIndex;
+        renderObject.vertexOffset = scene.triangle.vertexOffset;
+        renderObject.material = &scene.material;
+        // A unit box around the origin, the transform scales it to 0.7 of the cell so the wobble stays inside it
+        renderObject.bounds = {glm::vec3(0.0f), std::sqrt(3.0f), glm::vec3(1.0f)};
+        renderObject.transform = glm::mat4(0.35f * cellSize);
+        renderObject.transform[3] = glm::vec4(x + wobble * cellSize, y, 0.0f, 1.0f);
+    }
+}
+
+/// @brief FNV-1a over the raw pixels, lets CI catch a frame that rendered differently
+static uint64_t HashPixels(const std::vector<uint8_t> &pixels)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (uint8_t byte : pixels)
+    {
+        hash = (hash ^ byte) * 1099511628211ull;
+    }
+    return hash;
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkOptions options = ParseOptions(argc, argv);
+    HUSH_PROFILE_THREAD("Main");
+
+    Hush::VulkanRenderer renderer(nullptr);
+    renderer.CreateSwapChain(options.width, options.height);
+    renderer.InitRendering();
+
+    BenchmarkScene scene;
+    CreateScene(renderer, scene, options.gpuDriven);
+
+    Hush::LogFormat(Hush::ELogLevel::Info, "Render benchmark, {} frames at {}x{} with {} {} draws", options.frames,
+                    options.width, options.height, options.draws, options.gpuDriven ? "gpu driven" : "CPU recorded");
+    // Run twice to compare, the first run on a machine (or after a driver update) writes the cache the second loads
+    Hush::LogFormat(Hush::ELogLevel::Info, "Startup pipelines: {:.2f} ms ({} pipeline cache)",
+                    renderer.GetPipelineStartupMilliseconds(), renderer.IsPipelineCacheWarm() ? "warm" : "cold");
+
+    std::map<std::string_view, double> gpuPassMs;
+    uint64_t measuredSinceTicks = 0u;
+    BenchmarkClock::time_point start{};
+    for (uint32_t frame = 0; frame < WARMUP_FRAMES + options.frames; frame++)
+    {
+        if (frame == WARMUP_FRAMES)
+        {
+            // Pipeline creation, first uploads and driver warmup would skew the averages
+            measuredSinceTicks = Hush::Profiler::Now();
+            start = BenchmarkClock::now();
+        }
+        {
+            HUSH_PROFILE_SCOPE(Hush::Profiler::FRAME_ZONE_NAME);
+            FillDrawContext(renderer.GetDrawContext(), scene, options.draws, frame);
+            renderer.PublishFrame();
+            renderer.Draw();
+        }
+        if (frame >= WARMUP_FRAMES)
+        {
+            for (const Hush::GpuPassTiming &timing : renderer.GetGpuPassTimings())
+            {
+                gpuPassMs[timing.name] += timing.milliseconds;
+            }
+        }
+    }
+    vkDeviceWaitIdle(renderer.GetVulkanDevice());
+    std::chrono::duration<double, std::milli> elapsed = BenchmarkClock::now() - start;
+
+    auto frameCount = static_cast<double>(std::max(options.frames, 1u));
+    Hush::LogFormat(Hush::ELogLevel::Info, "{:.3f} ms per frame ({:.1f} FPS)", elapsed.count() / frameCount,
+                    1000.0 * frameCount / elapsed.count());
+
+#if HUSH_ENABLE_PROFILER
+    // Only the newest zones survive in the rings, so long runs average over what's left of them
+    std::vector<Hush::ThreadProfile> threads;
+    Hush::Profiler::Collect(threads, measuredSinceTicks);
+    std::map<std::string_view, std::pair<double, uint32_t>> cpuZones;
+    for (const Hush::ThreadProfile &thread : threads)
+    {
+        for (const Hush::ProfileZone &zone : thread.zones)
+        {
+            std::pair<double, uint32_t> &total = cpuZones[zone.name];
+            total.first += Hush::Profiler::TicksToMicroseconds(zone.endTicks - zone.startTicks) / 1000.0;
+            total.second++;
+        }
+    }
+    Hush::LogInfo("CPU zone | average (ms) | count");
+    for (const auto &[name, total] : cpuZones)
+    {
+        Hush::LogFormat(Hush::ELogLevel::Info, "{:40} | {:12.4f} | {}", name, total.first / total.second,
+                        total.second);
+    }
+#else
+    (void)measuredSinceTicks;
+#endif
+
+    Hush::VulkanRenderGraph::Stats graphStats = renderer.GetRenderGraphStats();
+    Hush::LogFormat(Hush::ELogLevel::Info, "Render graph: {} passes ({} culled), {} image barriers in {} batches",
+                    graphStats.passCount, graphStats.culledPasses, graphStats.imageBarriers, graphStats.barrierBatches);
+    Hush::VulkanGpuCuller::Stats cullingStats = renderer.GetGpuCullingStats();
+    Hush::LogFormat(Hush::ELogLevel::Info, "Gpu driven: {} objects in {} indirect batches", cullingStats.objectCount,
+                    cullingStats.batchCount);
+    Hush::LogFormat(Hush::ELogLevel::Info, "Gpu culling: {} early and {} late draws, {} frustum and {} occlusion culled",
+                    cullingStats.earlyDraws, cullingStats.lateDraws, cullingStats.frustumCulled,
+                    cullingStats.occlusionCulled);
+    Hush::VulkanRenderer::DrawStats drawStats = renderer.GetDrawStats();
+    Hush::LogFormat(Hush::ELogLevel::Info,
+                    "Draw submission: {} draws, {} pipeline binds ({} skipped), {} set binds ({} skipped)",
+                    drawStats.draws, drawStats.pipelineBinds, drawStats.pipelineBindsSkipped,
+                    drawStats.descriptorSetBinds, drawStats.descriptorSetBindsSkipped);
+    Hush::LogFormat(Hush::ELogLevel::Info, "Instancing: {} objects in {} instanced draws", drawStats.instancedObjects,
+                    drawStats.instancedDraws);
+
+    Hush::LogInfo("GPU pass | average (ms)");
+    for (const auto &[name, totalMs] : gpuPassMs)
+    {
+        Hush::LogFormat(Hush::ELogLevel::Info, "{:40} | {:12.4f}", name, totalMs / frameCount);
+    }
+
+    if (options.readback)
+    {
+        std::vector<uint8_t> pixels;
+        renderer.ReadbackDrawImage(pixels);
+        Hush::LogFormat(Hush::ELogLevel::Info, "Draw image checksum: {:016x}", HashPixels(pixels));
+    }
+
+    DestroyScene(renderer, scene);
+    return 0;
+}
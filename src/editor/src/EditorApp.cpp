@@ -26,6 +26,11 @@ class EditorApp final : public Hush::IApplication
         Hush::UI::InitializePanels();
     }
 
+    void FixedUpdate() override
+    {
+
+    }
+
     void Update() override
     {
 
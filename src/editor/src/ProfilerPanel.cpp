@@ -0,0 +1,177 @@
+/*! \file ProfilerPanel.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Flame graph of the last frames recorded by the profiler
+*/
+
+#include "ProfilerPanel.hpp"
+#include <imgui/imgui.h>
+#include <memory/AllocationCounters.hpp>
+#include <memory/FrameMemory.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    bool IsFrameZone(const Hush::ProfileZone &zone) noexcept
+    {
+        return zone.depth == 0u && std::strcmp(zone.name, Hush::Profiler::FRAME_ZONE_NAME) == 0;
+    }
+
+    /// @brief Stable color per zone name, so the same zone is easy to follow across frames
+    ImU32 GetZoneColor(const char *name) noexcept
+    {
+        uint32_t hash = 2166136261u;
+        for (const char *character = name; *character != '\0'; character++)
+        {
+            hash = (hash ^ static_cast<uint8_t>(*character)) * 16777619u;
+        }
+        float hue = static_cast<float>(hash % 360u) / 360.0f;
+        return static_cast<ImU32>(ImColor::HSV(hue, 0.45f, 0.75f));
+    }
+} // namespace
+
+void Hush::ProfilerPanel::OnRender()
+{
+    if (ImGui::Begin("Profiler"))
+    {
+#if !HUSH_ENABLE_PROFILER
+        ImGui::TextUnformatted("The profiler was compiled out, configure with HUSH_ENABLE_PROFILER=ON");
+#endif
+        ImGui::Checkbox("Pause", &this->m_paused);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::SliderInt("Frames", &this->m_frameCount, 1, MAX_FRAMES);
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome trace"))
+        {
+            Profiler::ExportChromeTrace(TRACE_FILE_NAME);
+        }
+        if (!this->m_paused)
+        {
+            this->Capture();
+        }
+        ImGui::Text("Average frame: %.3f ms", this->m_averageFrameMs);
+        this->DrawMemoryStats();
+        this->DrawFlameGraph();
+    }
+    ImGui::End();
+}
+
+void Hush::ProfilerPanel::Capture()
+{
+    Profiler::Collect(this->m_threads, this->m_nextCaptureSinceTicks);
+
+    // The frames are marked by the main loop, the one still running isn't finished so it's not included
+    std::vector<const ProfileZone *> frames;
+    for (const ThreadProfile &thread : this->m_threads)
+    {
+        for (const ProfileZone &zone : thread.zones)
+        {
+            if (IsFrameZone(zone))
+            {
+                frames.push_back(&zone);
+            }
+        }
+    }
+    if (frames.empty())
+    {
+        this->m_nextCaptureSinceTicks = 0u;
+        return;
+    }
+
+    auto frameCount = std::min<size_t>(static_cast<size_t>(this->m_frameCount), frames.size());
+    const ProfileZone *firstFrame = frames[frames.size() - frameCount];
+    this->m_rangeStartTicks = firstFrame->startTicks;
+    this->m_rangeEndTicks = frames.back()->endTicks;
+    this->m_averageFrameMs =
+        Profiler::TicksToMicroseconds(this->m_rangeEndTicks - this->m_rangeStartTicks) / 1000.0 /
+        static_cast<double>(frameCount);
+    // Raising the frame count just makes the next capture read the whole rings again
+    this->m_nextCaptureSinceTicks =
+        frames.size() >= static_cast<size_t>(this->m_frameCount) ? this->m_rangeStartTicks : 0u;
+}
+
+void Hush::ProfilerPanel::DrawMemoryStats() const
+{
+    const FrameMemoryStats &stats = FrameMemory::GetLastFrameStats();
+    if (AllocationCounters::IS_TRACKING)
+    {
+        ImGui::Text("Heap allocations last frame: %llu (%.1f KB)",
+                    static_cast<unsigned long long>(stats.heapAllocations),
+                    static_cast<double>(stats.heapBytes) / 1024.0);
+    }
+    else
+    {
+        ImGui::TextUnformatted("Heap allocations aren't tracked, configure with HUSH_TRACK_ALLOCATIONS=ON");
+    }
+    ImGui::Text("Frame arenas: %.1f KB, %llu overflows", static_cast<double>(stats.arenaBytes) / 1024.0,
+                static_cast<unsigned long long>(stats.arenaOverflows));
+}
+
+void Hush::ProfilerPanel::DrawFlameGraph() const
+{
+    if (this->m_rangeEndTicks <= this->m_rangeStartTicks)
+    {
+        return;
+    }
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    const auto rangeTicks = static_cast<double>(this->m_rangeEndTicks - this->m_rangeStartTicks);
+    const float width = ImGui::GetContentRegionAvail().x;
+
+    for (const ThreadProfile &thread : this->m_threads)
+    {
+        uint32_t maxDepth = 0u;
+        bool hasZones = false;
+        for (const ProfileZone &zone : thread.zones)
+        {
+            if (zone.endTicks >= this->m_rangeStartTicks && zone.startTicks <= this->m_rangeEndTicks)
+            {
+                maxDepth = std::max(maxDepth, zone.depth);
+                hasZones = true;
+            }
+        }
+        if (!hasZones)
+        {
+            continue;
+        }
+
+        ImGui::Text("%s (%u)", thread.threadName != nullptr ? thread.threadName : "Thread", thread.threadId);
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        const float height = static_cast<float>(maxDepth + 1u) * ROW_HEIGHT;
+        ImGui::Dummy(ImVec2(width, height));
+
+        for (const ProfileZone &zone : thread.zones)
+        {
+            if (zone.endTicks < this->m_rangeStartTicks || zone.startTicks > this->m_rangeEndTicks)
+            {
+                continue;
+            }
+            uint64_t start = std::max(zone.startTicks, this->m_rangeStartTicks);
+            uint64_t end = std::min(zone.endTicks, this->m_rangeEndTicks);
+            auto startOffset = static_cast<double>(start - this->m_rangeStartTicks);
+            auto endOffset = static_cast<double>(end - this->m_rangeStartTicks);
+            float x0 = origin.x + static_cast<float>(startOffset / rangeTicks) * width;
+            float x1 = origin.x + static_cast<float>(endOffset / rangeTicks) * width;
+            // Keep tiny zones visible as a sliver
+            x1 = std::max(x1, x0 + 1.0f);
+            float y0 = origin.y + static_cast<float>(zone.depth) * ROW_HEIGHT;
+            ImVec2 min(x0, y0);
+            ImVec2 max(x1, y0 + ROW_HEIGHT - 1.0f);
+
+            drawList->AddRectFilled(min, max, GetZoneColor(zone.name));
+            if (x1 - x0 > 30.0f)
+            {
+                ImVec4 clip(min.x + 2.0f, min.y, max.x - 2.0f, max.y);
+                drawList->AddText(nullptr, 0.0f, ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32_WHITE, zone.name,
+                                  nullptr, 0.0f, &clip);
+            }
+            if (ImGui::IsMouseHoveringRect(min, max))
+            {
+                ImGui::SetTooltip("%s\n%.3f ms", zone.name,
+                                  Profiler::TicksToMicroseconds(zone.endTicks - zone.startTicks) / 1000.0);
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+/*! \file ProfilerPanel.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Flame graph of the last frames recorded by the profiler
+*/
+
+#pragma once
+
+#include "IEditorPanel.hpp"
+#include <Profiler.hpp>
+#include <vector>
+
+namespace Hush
+{
+    class ProfilerPanel final : public IEditorPanel
+    {
+      public:
+        void OnRender() override;
+
+      private:
+        /// @brief Copies the zones of the last m_frameCount finished frames
+        void Capture();
+
+        void DrawMemoryStats() const;
+
+        void DrawFlameGraph() const;
+
+        static constexpr int MAX_FRAMES = 60;
+        static constexpr float ROW_HEIGHT = 18.0f;
+        static constexpr const char *TRACE_FILE_NAME = "hush_trace.json";
+
+        std::vector<ThreadProfile> m_threads;
+        uint64_t m_rangeStartTicks = 0u;
+        uint64_t m_rangeEndTicks = 0u;
+        /// @brief Oldest tick the next capture needs, avoids copying the whole ring of every thread each frame
+        uint64_t m_nextCaptureSinceTicks = 0u;
+        double m_averageFrameMs = 0.0;
+        int m_frameCount = 3;
+        bool m_paused = false;
+    };
+} // namespace Hush
@@ -27,6 +27,12 @@ namespace Hush
 
         virtual void Init() = 0;
 
+        /// @brief Called zero or more times per frame, at a fixed rate of Time::GetFixedDeltaTime() seconds, before
+        /// Update. Put the simulation code that needs determinism here, apps without any can leave it out
+        virtual void FixedUpdate()
+        {
+        }
+
         virtual void Update() = 0;
 
         virtual void OnPreRender() = 0;
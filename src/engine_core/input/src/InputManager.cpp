@@ -70,8 +70,9 @@ void Hush::InputManager::SendMouseMovementEvent(int32_t posX, int32_t posY, int3
 {
     S_MOUSE_DATA.positionX = posX;
     S_MOUSE_DATA.positionY = posY;
-    S_MOUSE_DATA.accelerationX = accelerationX;
-    S_MOUSE_DATA.accelerationY = accelerationY;
+    // Several motion events can arrive on the same frame, accumulate them so no movement gets lost
+    S_MOUSE_DATA.accelerationX += accelerationX;
+    S_MOUSE_DATA.accelerationY += accelerationY;
     // if (DebugUI::MouseInfoEnabled())
     // {
     //     LogFormat(ELogLevel::Info, "Mouse position: ({}, {})", S_MOUSE_DATA.positionX, S_MOUSE_DATA.positionY);
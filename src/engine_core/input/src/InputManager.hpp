@@ -39,6 +39,7 @@ namespace Hush
 
         static void SendMouseButtonEvent(MouseButton mouseButton, EKeyState state);
 
+        /// @brief Updates the mouse position, relative movement is accumulated until ResetMouseAcceleration is called
         static void SendMouseMovementEvent(int32_t posX, int32_t posY, int32_t accelerationX, int32_t accelerationY);
 
         static void ResetMouseAcceleration();
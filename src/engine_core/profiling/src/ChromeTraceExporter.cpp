@@ -0,0 +1,81 @@
+/*! \file ChromeTraceExporter.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Writes profiler zones in the Chrome trace event format
+*/
+
+#include "ChromeTraceExporter.hpp"
+#include "Logger.hpp"
+
+#include <fstream>
+#include <limits>
+
+bool Hush::ChromeTraceExporter::Export(const std::vector<ThreadProfile> &threads, const std::string &filePath)
+{
+    // Timestamps are relative to the oldest zone, so they stay small and precise
+    uint64_t baseTicks = std::numeric_limits<uint64_t>::max();
+    for (const ThreadProfile &thread : threads)
+    {
+        if (!thread.zones.empty())
+        {
+            baseTicks = std::min(baseTicks, thread.zones.front().startTicks);
+        }
+    }
+
+    std::string output = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool firstEvent = true;
+    for (const ThreadProfile &thread : threads)
+    {
+        if (thread.threadName != nullptr)
+        {
+            output += firstEvent ? "" : ",";
+            output += fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"",
+                                  thread.threadId);
+            AppendEscaped(output, thread.threadName);
+            output += "\"}}";
+            firstEvent = false;
+        }
+        for (const ProfileZone &zone : thread.zones)
+        {
+            output += firstEvent ? "{\"name\":\"" : ",{\"name\":\"";
+            AppendEscaped(output, zone.name);
+            output += fmt::format("\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                  thread.threadId, Profiler::TicksToMicroseconds(zone.startTicks - baseTicks),
+                                  Profiler::TicksToMicroseconds(zone.endTicks - zone.startTicks));
+            firstEvent = false;
+        }
+    }
+    output += "]}";
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        LogFormat(ELogLevel::Error, "Could not open {} to write the profiler trace", filePath);
+        return false;
+    }
+    file.write(output.data(), static_cast<std::streamsize>(output.size()));
+    return static_cast<bool>(file);
+}
+
+void Hush::ChromeTraceExporter::AppendEscaped(std::string &output, const char *text)
+{
+    for (const char *character = text; *character != '\0'; character++)
+    {
+        switch (*character)
+        {
+        case '"':
+            output += "\\\"";
+            break;
+        case '\\':
+            output += "\\\\";
+            break;
+        default:
+            // Control characters have no place in a zone name
+            if (static_cast<unsigned char>(*character) >= 0x20)
+            {
+                output += *character;
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,25 @@
+/*! \file ChromeTraceExporter.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Writes profiler zones in the Chrome trace event format
+*/
+
+#pragma once
+#include "Profiler.hpp"
+#include <string>
+#include <vector>
+
+namespace Hush
+{
+    /// @brief Writes complete ("X") events with microsecond timestamps plus the thread names, the result opens in
+    /// chrome://tracing and https://ui.perfetto.dev
+    class ChromeTraceExporter
+    {
+      public:
+        /// @return false if the file couldn't be written
+        static bool Export(const std::vector<ThreadProfile> &threads, const std::string &filePath);
+
+      private:
+        static void AppendEscaped(std::string &output, const char *text);
+    };
+} // namespace Hush
@@ -0,0 +1,267 @@
+/*! \file Profiler.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Low overhead hierarchical CPU profiler, zones are recorded into per thread lock-free ring buffers
+*/
+
+#include "Profiler.hpp"
+#include "ChromeTraceExporter.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define HUSH_PROFILER_USE_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define HUSH_PROFILER_USE_TSC 0
+#endif
+
+namespace
+{
+    /// @brief Every thread buffer ever created, they are never freed so zones of finished threads can still be read
+    struct ProfilerRegistry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Hush::ProfileRingBuffer>> buffers;
+    };
+
+    ProfilerRegistry &GetRegistry()
+    {
+        static ProfilerRegistry registry;
+        return registry;
+    }
+
+    uint64_t GetSteadyNanoseconds() noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    /// @brief TSC and steady clock sampled together, the TSC frequency is measured between two of these
+    struct ClockSample
+    {
+        uint64_t ticks;
+        uint64_t nanoseconds;
+
+        static ClockSample Take() noexcept
+        {
+            return {Hush::Profiler::Now(), GetSteadyNanoseconds()};
+        }
+    };
+
+    const ClockSample &GetClockAnchor() noexcept
+    {
+        static const ClockSample anchor = ClockSample::Take();
+        return anchor;
+    }
+
+#if HUSH_PROFILER_USE_TSC
+    /// @brief Shortest span the TSC frequency is measured over, Profiler::Calibrate sleeps until the anchor is this old
+    constexpr uint64_t MIN_CALIBRATION_NS = 10'000'000;
+    /// @brief Span after which the measure is accurate enough to stop refining it
+    constexpr uint64_t STABLE_CALIBRATION_NS = 1'000'000'000;
+
+    // NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+    std::atomic<double> s_ticksPerMicrosecond{0.0};
+    std::atomic<bool> s_calibrationStable{false};
+    // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+    double MeasureTicksPerMicrosecond(const ClockSample &from, const ClockSample &to) noexcept
+    {
+        return static_cast<double>(to.ticks - from.ticks) /
+               (static_cast<double>(to.nanoseconds - from.nanoseconds) / 1000.0);
+    }
+#endif
+
+    double GetTicksPerMicrosecond() noexcept
+    {
+#if HUSH_PROFILER_USE_TSC
+        double ticksPerMicrosecond = s_ticksPerMicrosecond.load(std::memory_order_relaxed);
+        if (ticksPerMicrosecond <= 0.0)
+        {
+            // Nobody calibrated at startup, this first conversion pays for it
+            Hush::Profiler::Calibrate();
+            ticksPerMicrosecond = s_ticksPerMicrosecond.load(std::memory_order_relaxed);
+        }
+        if (s_calibrationStable.load(std::memory_order_relaxed))
+        {
+            return ticksPerMicrosecond;
+        }
+        // Refined against the anchor without waiting until a second has passed, then kept
+        const ClockSample &anchor = GetClockAnchor();
+        ClockSample current = ClockSample::Take();
+        if (current.nanoseconds - anchor.nanoseconds >= STABLE_CALIBRATION_NS)
+        {
+            ticksPerMicrosecond = MeasureTicksPerMicrosecond(anchor, current);
+            s_ticksPerMicrosecond.store(ticksPerMicrosecond, std::memory_order_relaxed);
+            s_calibrationStable.store(true, std::memory_order_relaxed);
+        }
+        return ticksPerMicrosecond;
+#else
+        return 1000.0;
+#endif
+    }
+
+    thread_local Hush::ProfileRingBuffer *tlsThreadBuffer = nullptr;
+    thread_local uint32_t tlsThreadDepth = 0u;
+} // namespace
+
+Hush::ProfileRingBuffer::ProfileRingBuffer(uint32_t threadId) noexcept : m_slots(CAPACITY), m_threadId(threadId)
+{
+}
+
+void Hush::ProfileRingBuffer::Read(std::vector<ProfileZone> &zones, uint64_t sinceTicks) const
+{
+    uint64_t end = this->m_writeIndex.load(std::memory_order_acquire);
+    uint64_t begin = end > CAPACITY ? end - CAPACITY : 0u;
+    size_t firstAppended = zones.size();
+
+    // Zones are pushed when they end, so walking backwards we can stop at the first one that's too old
+    uint64_t index = end;
+    while (index > begin)
+    {
+        const Slot &slot = this->m_slots[(index - 1u) & (CAPACITY - 1u)];
+        ProfileZone zone{slot.name.load(std::memory_order_relaxed), slot.startTicks.load(std::memory_order_relaxed),
+                         slot.endTicks.load(std::memory_order_relaxed), slot.depth.load(std::memory_order_relaxed)};
+        if (zone.endTicks < sinceTicks)
+        {
+            break;
+        }
+        zones.push_back(zone);
+        index--;
+    }
+
+    // Anything the writer could have overwritten while we copied may be torn, including the slot it might be writing
+    // right now
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t endAfterCopy = this->m_writeIndex.load(std::memory_order_relaxed) + 1u;
+    uint64_t firstValid = endAfterCopy > CAPACITY ? endAfterCopy - CAPACITY : 0u;
+    if (firstValid > index)
+    {
+        uint64_t staleCount = std::min<uint64_t>(firstValid - index, zones.size() - firstAppended);
+        zones.resize(zones.size() - staleCount);
+    }
+    std::reverse(zones.begin() + static_cast<std::ptrdiff_t>(firstAppended), zones.end());
+}
+
+uint32_t Hush::ProfileRingBuffer::GetThreadId() const noexcept
+{
+    return this->m_threadId;
+}
+
+const char *Hush::ProfileRingBuffer::GetThreadName() const noexcept
+{
+    return this->m_threadName.load(std::memory_order_acquire);
+}
+
+void Hush::ProfileRingBuffer::SetThreadName(const char *name) noexcept
+{
+    this->m_threadName.store(name, std::memory_order_release);
+}
+
+uint64_t Hush::Profiler::Now() noexcept
+{
+#if HUSH_PROFILER_USE_TSC
+    return __rdtsc();
+#else
+    return GetSteadyNanoseconds();
+#endif
+}
+
+void Hush::Profiler::Calibrate() noexcept
+{
+#if HUSH_PROFILER_USE_TSC
+    // Assumes an invariant TSC, which every x86 CPU from the last decade has
+    const ClockSample &anchor = GetClockAnchor();
+    uint64_t elapsedNanoseconds = GetSteadyNanoseconds() - anchor.nanoseconds;
+    if (elapsedNanoseconds < MIN_CALIBRATION_NS)
+    {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(MIN_CALIBRATION_NS - elapsedNanoseconds));
+    }
+    s_ticksPerMicrosecond.store(MeasureTicksPerMicrosecond(anchor, ClockSample::Take()), std::memory_order_relaxed);
+#endif
+}
+
+double Hush::Profiler::TicksToMicroseconds(uint64_t ticks) noexcept
+{
+    return static_cast<double>(ticks) / GetTicksPerMicrosecond();
+}
+
+uint64_t Hush::Profiler::MicrosecondsToTicks(double microseconds) noexcept
+{
+    return static_cast<uint64_t>(microseconds * GetTicksPerMicrosecond());
+}
+
+void Hush::Profiler::RecordZone(const char *name, uint64_t startTicks, uint64_t endTicks, uint32_t depth) noexcept
+{
+    GetThreadBuffer().Push(name, startTicks, endTicks, depth);
+}
+
+void Hush::Profiler::SetThreadName(const char *name) noexcept
+{
+    GetThreadBuffer().SetThreadName(name);
+}
+
+void Hush::Profiler::Collect(std::vector<ThreadProfile> &threads, uint64_t sinceTicks)
+{
+    ProfilerRegistry &registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    threads.resize(registry.buffers.size());
+    for (size_t i = 0; i < registry.buffers.size(); i++)
+    {
+        const ProfileRingBuffer &buffer = *registry.buffers[i];
+        ThreadProfile &thread = threads[i];
+        thread.threadName = buffer.GetThreadName();
+        thread.threadId = buffer.GetThreadId();
+        thread.zones.clear();
+        buffer.Read(thread.zones, sinceTicks);
+    }
+}
+
+bool Hush::Profiler::ExportChromeTrace(const std::string &filePath)
+{
+    std::vector<ThreadProfile> threads;
+    Collect(threads);
+    bool exported = ChromeTraceExporter::Export(threads, filePath);
+    if (exported)
+    {
+        LogFormat(ELogLevel::Info, "Profiler trace written to {}", filePath);
+    }
+    return exported;
+}
+
+uint32_t &Hush::Profiler::GetThreadDepth() noexcept
+{
+    return tlsThreadDepth;
+}
+
+Hush::ProfileRingBuffer &Hush::Profiler::GetThreadBuffer() noexcept
+{
+    if (tlsThreadBuffer == nullptr)
+    {
+        tlsThreadBuffer = &RegisterTrack(nullptr);
+    }
+    return *tlsThreadBuffer;
+}
+
+Hush::ProfileRingBuffer &Hush::Profiler::RegisterTrack(const char *name)
+{
+    // Start measuring the TSC frequency as soon as anything gets recorded
+    (void)GetClockAnchor();
+    ProfilerRegistry &registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    auto threadId = static_cast<uint32_t>(registry.buffers.size());
+    registry.buffers.push_back(std::make_unique<ProfileRingBuffer>(threadId));
+    registry.buffers.back()->SetThreadName(name);
+    return *registry.buffers.back();
+}
@@ -0,0 +1,170 @@
+/*! \file Profiler.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Low overhead hierarchical CPU profiler, zones are recorded into per thread lock-free ring buffers
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef HUSH_ENABLE_PROFILER
+#define HUSH_ENABLE_PROFILER 0
+#endif
+
+namespace Hush
+{
+    /// @brief A finished zone, times are in profiler ticks, see Profiler::TicksToMicroseconds
+    struct ProfileZone
+    {
+        /// @brief Must have static storage duration (a string literal or __func__)
+        const char *name;
+        uint64_t startTicks;
+        uint64_t endTicks;
+        /// @brief Amount of zones this one is nested in on its thread
+        uint32_t depth;
+    };
+
+    /// @brief Zones of a single thread, ordered by the time they ended
+    struct ThreadProfile
+    {
+        const char *threadName;
+        uint32_t threadId;
+        std::vector<ProfileZone> zones;
+    };
+
+    /// @brief Fixed size ring of zones, only written by the thread that owns it, so recording never locks. Readers copy
+    /// the latest zones and discard the ones the writer could have overwritten while copying
+    class ProfileRingBuffer
+    {
+      public:
+        /// @brief Zones kept per thread, the oldest ones are overwritten
+        static constexpr uint32_t CAPACITY = 1u << 15u;
+
+        ProfileRingBuffer(uint32_t threadId) noexcept;
+
+        /// @brief Owning thread only
+        void Push(const char *name, uint64_t startTicks, uint64_t endTicks, uint32_t depth) noexcept
+        {
+            uint64_t index = this->m_writeIndex.load(std::memory_order_relaxed);
+            Slot &slot = this->m_slots[index & (CAPACITY - 1u)];
+            slot.name.store(name, std::memory_order_relaxed);
+            slot.startTicks.store(startTicks, std::memory_order_relaxed);
+            slot.endTicks.store(endTicks, std::memory_order_relaxed);
+            slot.depth.store(depth, std::memory_order_relaxed);
+            this->m_writeIndex.store(index + 1u, std::memory_order_release);
+        }
+
+        /// @brief Any thread, appends the zones that ended at or after sinceTicks
+        void Read(std::vector<ProfileZone> &zones, uint64_t sinceTicks) const;
+
+        [[nodiscard]] uint32_t GetThreadId() const noexcept;
+
+        [[nodiscard]] const char *GetThreadName() const noexcept;
+
+        void SetThreadName(const char *name) noexcept;
+
+      private:
+        // Relaxed atomics compile to plain moves, they only make the concurrent read well defined
+        struct Slot
+        {
+            std::atomic<const char *> name{nullptr};
+            std::atomic<uint64_t> startTicks{0};
+            std::atomic<uint64_t> endTicks{0};
+            std::atomic<uint32_t> depth{0};
+        };
+
+        std::vector<Slot> m_slots;
+        alignas(64) std::atomic<uint64_t> m_writeIndex{0};
+        std::atomic<const char *> m_threadName{nullptr};
+        uint32_t m_threadId;
+    };
+
+    /// @brief Static facade of the profiler, use the HUSH_PROFILE_* macros to record zones so they compile out when
+    /// HUSH_ENABLE_PROFILER is off
+    class Profiler
+    {
+      public:
+        /// @brief Name of the zone that wraps every iteration of the main loop, marks the frames in the profiler panel
+        static constexpr const char *FRAME_ZONE_NAME = "Frame";
+
+        /// @brief Current time in profiler ticks (the TSC on x86, nanoseconds of the steady clock otherwise)
+        static uint64_t Now() noexcept;
+
+        /// @brief Measures how many ticks make a microsecond, sleeping 10 ms at most. Call once at startup, otherwise
+        /// the first tick conversion does it. The measure keeps being refined for the first second
+        static void Calibrate() noexcept;
+
+        static double TicksToMicroseconds(uint64_t ticks) noexcept;
+
+        static uint64_t MicrosecondsToTicks(double microseconds) noexcept;
+
+        static void RecordZone(const char *name, uint64_t startTicks, uint64_t endTicks, uint32_t depth) noexcept;
+
+        /// @brief Names the calling thread on the profiler output
+        /// @param name must have static storage duration
+        static void SetThreadName(const char *name) noexcept;
+
+        /// @brief Creates a track that isn't tied to the calling thread, used for timings measured elsewhere (the GPU).
+        /// Only one thread may push to it at a time, and zones must be pushed in the order they end
+        /// @param name must have static storage duration
+        static ProfileRingBuffer &RegisterTrack(const char *name);
+
+        /// @brief Copies the zones of every thread that ended at or after sinceTicks
+        static void Collect(std::vector<ThreadProfile> &threads, uint64_t sinceTicks = 0u);
+
+        /// @brief Writes the recorded zones as a Chrome trace (chrome://tracing, Perfetto)
+        /// @return false if the file couldn't be written
+        static bool ExportChromeTrace(const std::string &filePath);
+
+        /// @brief Nesting depth of the calling thread, used by ProfileScope
+        static uint32_t &GetThreadDepth() noexcept;
+
+      private:
+        static ProfileRingBuffer &GetThreadBuffer() noexcept;
+    };
+
+    /// @brief Records a zone from its construction until the end of the scope
+    class ProfileScope
+    {
+      public:
+        explicit ProfileScope(const char *name) noexcept
+            : m_name(name), m_depth(Profiler::GetThreadDepth()++), m_startTicks(Profiler::Now())
+        {
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+        ProfileScope(ProfileScope &&) = delete;
+        ProfileScope &operator=(ProfileScope &&) = delete;
+
+        ~ProfileScope()
+        {
+            uint64_t endTicks = Profiler::Now();
+            Profiler::GetThreadDepth()--;
+            Profiler::RecordZone(this->m_name, this->m_startTicks, endTicks, this->m_depth);
+        }
+
+      private:
+        const char *m_name;
+        uint32_t m_depth;
+        uint64_t m_startTicks;
+    };
+} // namespace Hush
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#if HUSH_ENABLE_PROFILER
+#define HUSH_PROFILE_CONCAT_IMPL(a, b) a##b
+#define HUSH_PROFILE_CONCAT(a, b) HUSH_PROFILE_CONCAT_IMPL(a, b)
+/// @brief Profiles the rest of the scope, name must be a string literal
+#define HUSH_PROFILE_SCOPE(name) const ::Hush::ProfileScope HUSH_PROFILE_CONCAT(hushProfileScope, __LINE__)(name)
+#define HUSH_PROFILE_FUNCTION() HUSH_PROFILE_SCOPE(__func__)
+#define HUSH_PROFILE_THREAD(name) ::Hush::Profiler::SetThreadName(name)
+#else
+#define HUSH_PROFILE_SCOPE(name) (void)0
+#define HUSH_PROFILE_FUNCTION() (void)0
+#define HUSH_PROFILE_THREAD(name) (void)0
+#endif
+// NOLINTEND(cppcoreguidelines-macro-usage)
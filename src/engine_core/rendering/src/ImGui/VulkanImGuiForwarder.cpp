@@ -56,11 +56,45 @@ void Hush::VulkanImGuiForwarder::Dispose() noexcept
     ImGui_ImplVulkan_Shutdown();
 }
 
-void Hush::VulkanImGuiForwarder::RenderFrame(VkCommandBuffer cmd)
+ImDrawData *Hush::VulkanImGuiForwarder::CaptureFrame(ImDrawData *copyTarget)
 {
     ImGui::EndFrame();
     ImGui::Render();
-    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), cmd);
+    ImDrawData *drawData = ImGui::GetDrawData();
+    if (copyTarget == nullptr)
+    {
+        return drawData;
+    }
+
+    ReleaseDrawDataCopy(copyTarget);
+    // Copy every field but the lists, swapping them out keeps the copy from reallocating our list storage
+    ImVector<ImDrawList *> targetLists;
+    ImVector<ImDrawList *> sourceLists;
+    targetLists.swap(copyTarget->CmdLists);
+    sourceLists.swap(drawData->CmdLists);
+    *copyTarget = *drawData;
+    drawData->CmdLists.swap(sourceLists);
+    copyTarget->CmdLists.swap(targetLists);
+
+    for (ImDrawList *drawList : drawData->CmdLists)
+    {
+        copyTarget->CmdLists.push_back(drawList->CloneOutput());
+    }
+    return copyTarget;
+}
+
+void Hush::VulkanImGuiForwarder::RenderDrawData(ImDrawData *drawData, VkCommandBuffer cmd)
+{
+    ImGui_ImplVulkan_RenderDrawData(drawData, cmd);
+}
+
+void Hush::VulkanImGuiForwarder::ReleaseDrawDataCopy(ImDrawData *copy) noexcept
+{
+    for (ImDrawList *drawList : copy->CmdLists)
+    {
+        IM_DELETE(drawList);
+    }
+    copy->CmdLists.resize(0);
 }
 
 ImGui_ImplVulkan_InitInfo Hush::VulkanImGuiForwarder::CreateInitData(VulkanRenderer *vulkanRenderer) const noexcept
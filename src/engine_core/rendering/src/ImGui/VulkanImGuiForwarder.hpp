@@ -24,7 +24,15 @@ namespace Hush
 
         void Dispose() noexcept override;
 
-        void RenderFrame(VkCommandBuffer cmd);
+        /// @brief Ends the UI frame and generates its draw data
+        /// @param copyTarget if not null, the draw lists get cloned into it so they outlive the next NewFrame
+        /// @return the draw data to pass to RenderDrawData, either ImGui's own or copyTarget
+        ImDrawData *CaptureFrame(ImDrawData *copyTarget);
+
+        void RenderDrawData(ImDrawData *drawData, VkCommandBuffer cmd);
+
+        /// @brief Frees the draw lists cloned by CaptureFrame
+        static void ReleaseDrawDataCopy(ImDrawData *copy) noexcept;
 
       private:
         [[nodiscard]] ImGui_ImplVulkan_InitInfo CreateInitData(VulkanRenderer *vulkanRenderer) const noexcept;
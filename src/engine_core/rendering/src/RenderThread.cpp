@@ -0,0 +1,67 @@
+/*! \file RenderThread.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Dedicated thread that draws the frames published by the game thread
+*/
+
+#include "RenderThread.hpp"
+#include "Assertions.hpp"
+#include "Profiler.hpp"
+
+Hush::RenderThread::RenderThread(IRenderer *renderer) noexcept : m_renderer(renderer)
+{
+}
+
+Hush::RenderThread::~RenderThread()
+{
+    this->Stop();
+}
+
+void Hush::RenderThread::Start()
+{
+    HUSH_ASSERT(!this->m_thread.joinable(), "Render thread already started!");
+    this->m_running = true;
+    this->m_thread = std::thread(&RenderThread::Loop, this);
+}
+
+void Hush::RenderThread::Stop()
+{
+    if (!this->m_thread.joinable())
+    {
+        return;
+    }
+    {
+        std::lock_guard lock(this->m_wakeMutex);
+        this->m_running = false;
+    }
+    this->m_wakeCondition.notify_one();
+    this->m_thread.join();
+}
+
+void Hush::RenderThread::NotifyFramePublished()
+{
+    // The frame itself goes through the renderer's lock-free snapshot, the lock only avoids missing a wake up between
+    // the render thread checking for a frame and going to sleep
+    {
+        std::lock_guard lock(this->m_wakeMutex);
+    }
+    this->m_wakeCondition.notify_one();
+}
+
+void Hush::RenderThread::Loop()
+{
+    HUSH_PROFILE_THREAD("Render");
+    while (true)
+    {
+        {
+            std::unique_lock lock(this->m_wakeMutex);
+            this->m_wakeCondition.wait(lock,
+                                       [this]() { return !this->m_running || this->m_renderer->HasPendingFrame(); });
+            if (!this->m_running)
+            {
+                return;
+            }
+        }
+        this->m_renderer->Draw();
+    }
+}
@@ -0,0 +1,47 @@
+/*! \file RenderThread.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Dedicated thread that draws the frames published by the game thread
+*/
+
+#pragma once
+#include "Renderer.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Hush
+{
+    /// @brief Calls IRenderer::Draw on its own thread every time the game thread publishes a frame, so simulating frame
+    /// N + 1 overlaps with recording and submitting frame N. Sleeps while there's nothing new to draw
+    class RenderThread
+    {
+      public:
+        /// @param renderer must have been created with SetThreadedRendering(true) and outlive this thread
+        RenderThread(IRenderer *renderer) noexcept;
+
+        RenderThread(const RenderThread &) = delete;
+        RenderThread &operator=(const RenderThread &) = delete;
+        RenderThread(RenderThread &&) = delete;
+        RenderThread &operator=(RenderThread &&) = delete;
+
+        ~RenderThread();
+
+        void Start();
+
+        /// @brief Waits for the frame being drawn (if any) and joins the thread
+        void Stop();
+
+        /// @brief Game thread, wakes the render thread up after IRenderer::PublishFrame
+        void NotifyFramePublished();
+
+      private:
+        void Loop();
+
+        IRenderer *m_renderer;
+        std::thread m_thread;
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wakeCondition;
+        bool m_running = false;
+    };
+} // namespace Hush
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "Shared/RenderObject.hpp"
 #include <SDL2/SDL.h>
 #include <cstdint>
 
@@ -31,8 +32,25 @@ namespace Hush
 
         virtual void InitImGui() = 0;
 
+        /// @brief Records and submits the latest frame handed over by PublishFrame, the last one gets drawn again if
+        /// nothing new was published. Only ever called from one thread, see SetThreadedRendering
         virtual void Draw() = 0;
 
+        /// @brief Game thread, scene to draw on the frame currently being built, it starts empty every frame
+        virtual DrawContext &GetDrawContext() noexcept = 0;
+
+        /// @brief Game thread, ends the UI frame and hands the frame's scene and UI over to Draw. With threaded
+        /// rendering it first waits for Draw to take the previously published frame, so the game thread never gets
+        /// more than one frame ahead of the render thread
+        virtual void PublishFrame() = 0;
+
+        /// @brief Whether a frame was published and hasn't been drawn yet, safe to call from any thread
+        [[nodiscard]] virtual bool HasPendingFrame() const noexcept = 0;
+
+        /// @brief Set before the first frame, when enabled Draw runs on its own thread while the game thread builds the
+        /// next frame, so the UI draw data gets copied instead of being read from ImGui directly
+        virtual void SetThreadedRendering(bool enabled) noexcept = 0;
+
         /// @brief Initializes all the internal structures needed to begin rendering, call after a swapchain has been
         /// created!
         virtual void InitRendering() = 0;
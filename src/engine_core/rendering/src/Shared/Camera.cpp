@@ -5,8 +5,9 @@ Hush::Camera::Camera(const glm::mat4 &projectionMat, const glm::mat4 &unreversed
 {
 }
 
-Hush::Camera::Camera(float degFov, float width, float height, float nearP, float farP) noexcept : m_projectionMatrix(glm::perspectiveFov(glm::radians(degFov), width, height, farP, nearP)), m_unreversedProjectionMatrix(glm::perspectiveFov(glm::radians(degFov), width, height, nearP, farP))
+Hush::Camera::Camera(float degFov, float width, float height, float nearP, float farP) noexcept
 {
+    this->SetPerspectiveProjectionMatrix(glm::radians(degFov), width, height, nearP, farP);
 }
 
 const glm::mat4 &Hush::Camera::GetProjectionMatrix() const noexcept
@@ -19,6 +20,16 @@ const glm::mat4 &Hush::Camera::GetUnreversedProjectionMatrix() const noexcept
     return this->m_unreversedProjectionMatrix;
 }
 
+glm::mat4 Hush::Camera::GetViewProjectionMatrix(const glm::mat4 &view) const noexcept
+{
+    return this->m_projectionMatrix * view;
+}
+
+Hush::Frustum Hush::Camera::GetFrustum(const glm::mat4 &view) const noexcept
+{
+    return Frustum::FromViewProjection(this->GetViewProjectionMatrix(view));
+}
+
 void Hush::Camera::SetProjectionMatrix(const glm::mat4 projection, const glm::mat4 unReversedProjection)
 {
     this->m_projectionMatrix = projection;
@@ -30,6 +41,7 @@ void Hush::Camera::SetPerspectiveProjectionMatrix(const float radFov, const floa
 {
     //Yes, even though the last two parameters seem to be reversed, this is how other engines seem to be doing it
     //but, you know, adding this for future bugs and stuff
-    this->m_projectionMatrix = glm::perspectiveFov(radFov, width, height, farP, nearP);
-    this->m_unreversedProjectionMatrix = glm::perspectiveFov(radFov, width, height, nearP, farP);
+    // The _ZO variants map depth to Vulkan's [0, 1], plain perspectiveFov follows GLM's OpenGL default of [-1, 1]
+    this->m_projectionMatrix = glm::perspectiveFovRH_ZO(radFov, width, height, farP, nearP);
+    this->m_unreversedProjectionMatrix = glm::perspectiveFovRH_ZO(radFov, width, height, nearP, farP);
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "Frustum.hpp"
+
 #include <glm/glm.hpp>
 #include <glm/ext/matrix_clip_space.hpp>
 
@@ -23,6 +25,12 @@ namespace Hush
 
         [[nodiscard]] const glm::mat4 &GetUnreversedProjectionMatrix() const noexcept;
 
+        /// @brief The reversed depth projection times view, what DrawContext::viewProjection expects
+        [[nodiscard]] glm::mat4 GetViewProjectionMatrix(const glm::mat4 &view) const noexcept;
+
+        /// @brief Frustum seen through view, for DrawContext::cullingFrustum
+        [[nodiscard]] Frustum GetFrustum(const glm::mat4 &view) const noexcept;
+
         void SetProjectionMatrix(glm::mat4 projection, glm::mat4 unReversedProjection);
 
         void SetPerspectiveProjectionMatrix(const float radFov, const float width, const float height,
@@ -0,0 +1,160 @@
+/*! \file DrawSorting.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Orders the RenderObjects of a pass by 64 bit sort keys, radix sorted across the job system
+*/
+
+#include "DrawSorting.hpp"
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+    constexpr uint32_t PASS_BITS = 2u;
+    constexpr uint32_t STATE_BITS = 16u;
+    constexpr uint32_t DEPTH_BITS = 30u;
+    constexpr uint64_t PASS_MASK = (1ull << PASS_BITS) - 1u;
+    constexpr uint64_t DEPTH_MASK = (1ull << DEPTH_BITS) - 1u;
+    static_assert(PASS_BITS + 2u * STATE_BITS + DEPTH_BITS == 64u, "Sort key fields must fill 64 bits");
+
+    uint64_t HashState(const void *state) noexcept
+    {
+        // Fibonacci hashing, the top bits depend on every bit of the address
+        return (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(state)) * 11400714819323198485ull) >>
+               (64u - STATE_BITS);
+    }
+
+    uint64_t QuantizeDepth(float depth) noexcept
+    {
+        // Behind the camera (and NaN) sorts as nearest. Positive floats order like their bits, the sign bit is 0 and
+        // the lowest mantissa bit is dropped to fit
+        if (!(depth > 0.0f))
+        {
+            return 0u;
+        }
+        uint32_t bits = 0u;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return static_cast<uint64_t>(bits >> 1u);
+    }
+} // namespace
+
+uint64_t Hush::DrawSorter::MakeKey(const RenderObject &object, const std::optional<glm::mat4> &viewProjection,
+                                   EDrawOrder order) noexcept
+{
+    uint64_t depth = 0u;
+    if (viewProjection.has_value())
+    {
+        const glm::mat4 &transform = object.transform;
+        const glm::vec3 &origin = object.bounds.origin;
+        glm::vec3 center = glm::vec3(transform[0]) * origin.x + glm::vec3(transform[1]) * origin.y +
+                           glm::vec3(transform[2]) * origin.z + glm::vec3(transform[3]);
+        // Only the w row of the projection is needed
+        const glm::mat4 &matrix = *viewProjection;
+        depth = QuantizeDepth(matrix[0][3] * center.x + matrix[1][3] * center.y + matrix[2][3] * center.z +
+                              matrix[3][3]);
+    }
+
+    const MaterialInstance &material = *object.material;
+    uint64_t pass = static_cast<uint64_t>(material.passType) & PASS_MASK;
+    uint64_t pipeline = HashState(material.pipeline);
+    uint64_t materialSet = HashState(material.materialSet);
+    if (order == EDrawOrder::FrontToBack)
+    {
+        return (pass << 62u) | (pipeline << 46u) | (materialSet << DEPTH_BITS) | depth;
+    }
+    return (pass << 62u) | ((DEPTH_MASK - depth) << 32u) | (pipeline << STATE_BITS) | materialSet;
+}
+
+void Hush::DrawSorter::Sort(const std::vector<RenderObject> &objects, std::vector<uint32_t> &indices,
+                            const std::optional<glm::mat4> &viewProjection, EDrawOrder order, JobSystem *jobSystem)
+{
+    HUSH_PROFILE_SCOPE("DrawSorter::Sort");
+    auto count = static_cast<uint32_t>(indices.size());
+    if (count < 2u || (order == EDrawOrder::BackToFront && !viewProjection.has_value()))
+    {
+        return;
+    }
+
+    bool parallel = jobSystem != nullptr && count >= PARALLEL_THRESHOLD;
+    uint32_t batchCount = parallel ? (count + BATCH_SIZE - 1u) / BATCH_SIZE : 1u;
+    uint32_t batchSize = parallel ? BATCH_SIZE : count;
+    auto forEachBatch = [&](auto &&function) {
+        if (parallel)
+        {
+            jobSystem->ParallelFor(count, BATCH_SIZE, function);
+        }
+        else
+        {
+            function(0u, count);
+        }
+    };
+
+    this->m_keys.resize(count);
+    this->m_scratchKeys.resize(count);
+    this->m_scratchIndices.resize(count);
+    this->m_histograms.resize(static_cast<size_t>(batchCount) * RADIX);
+    forEachBatch([&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            this->m_keys[i] = MakeKey(objects[indices[i]], viewProjection, order);
+        }
+    });
+
+    uint64_t *keys = this->m_keys.data();
+    uint32_t *values = indices.data();
+    uint64_t *sortedKeys = this->m_scratchKeys.data();
+    uint32_t *sortedValues = this->m_scratchIndices.data();
+    for (uint32_t shift = 0u; shift < 64u; shift += 8u)
+    {
+        forEachBatch([&](uint32_t begin, uint32_t end) {
+            uint32_t *histogram = this->m_histograms.data() + static_cast<size_t>(begin / batchSize) * RADIX;
+            std::fill(histogram, histogram + RADIX, 0u);
+            for (uint32_t i = begin; i < end; i++)
+            {
+                histogram[(keys[i] >> shift) & (RADIX - 1u)]++;
+            }
+        });
+
+        // Digit major prefix sums, a digit's keys are written in batch order so the sort stays stable. A byte every
+        // key shares would leave them where they are
+        uint32_t offset = 0u;
+        bool shared = false;
+        for (uint32_t digit = 0u; digit < RADIX && !shared; digit++)
+        {
+            uint32_t digitBegin = offset;
+            for (uint32_t batch = 0u; batch < batchCount; batch++)
+            {
+                uint32_t &counter = this->m_histograms[static_cast<size_t>(batch) * RADIX + digit];
+                uint32_t digitCount = counter;
+                counter = offset;
+                offset += digitCount;
+            }
+            shared = offset - digitBegin == count;
+        }
+        if (shared)
+        {
+            continue;
+        }
+
+        forEachBatch([&](uint32_t begin, uint32_t end) {
+            uint32_t *offsets = this->m_histograms.data() + static_cast<size_t>(begin / batchSize) * RADIX;
+            for (uint32_t i = begin; i < end; i++)
+            {
+                uint32_t destination = offsets[(keys[i] >> shift) & (RADIX - 1u)]++;
+                sortedKeys[destination] = keys[i];
+                sortedValues[destination] = values[i];
+            }
+        });
+        std::swap(keys, sortedKeys);
+        std::swap(values, sortedValues);
+    }
+
+    if (values != indices.data())
+    {
+        std::memcpy(indices.data(), values, count * sizeof(uint32_t));
+    }
+}
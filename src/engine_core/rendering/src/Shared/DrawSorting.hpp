@@ -0,0 +1,64 @@
+/*! \file DrawSorting.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Orders the RenderObjects of a pass by 64 bit sort keys, radix sorted across the job system
+*/
+
+#pragma once
+#include "RenderObject.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Hush
+{
+    class JobSystem;
+
+    enum class EDrawOrder : uint8_t
+    {
+        /// @brief Grouped by state first, nearest first within the same state. For opaque surfaces, so the draws
+        /// after the first rebind as little as possible and fail the depth test early
+        FrontToBack,
+        /// @brief Farthest first, then grouped by state. For transparent surfaces, blending needs them in order
+        BackToFront
+    };
+
+    /// @brief Sorts draws so the ones sharing a pipeline and material set are recorded one after the other.
+    /// Every object gets a 64 bit key, from the highest bits down:
+    /// - FrontToBack: pass (2 bits), pipeline (16), material set (16), view depth (30)
+    /// - BackToFront: pass (2 bits), inverted view depth (30), pipeline (16), material set (16)
+    /// Pipelines and sets are hashed down to their 16 bits, a collision only costs the binds it interleaves. Depth
+    /// is the clip space w of the bounds' center, the view distance with a perspective projection. The keys are
+    /// then LSD radix sorted a byte at a time, skipping the bytes every key shares. Big lists build their keys and
+    /// histograms in batches across the job system.
+    /// Keeps its scratch memory between calls, use one per thread
+    class DrawSorter
+    {
+      public:
+        /// @brief Lists smaller than this are sorted on the calling thread
+        static constexpr uint32_t PARALLEL_THRESHOLD = 16384u;
+        static constexpr uint32_t BATCH_SIZE = 8192u;
+
+        /// @brief Reorders indices (into objects) by their objects' keys, equal keys keep their order
+        /// @param viewProjection unset gives every object the same depth. BackToFront leaves indices as they are then,
+        /// the submission order is all blending has
+        /// @param jobSystem splits lists of PARALLEL_THRESHOLD indices or more across it, nullptr sorts on the calling
+        /// thread
+        void Sort(const std::vector<RenderObject> &objects, std::vector<uint32_t> &indices,
+                  const std::optional<glm::mat4> &viewProjection, EDrawOrder order, JobSystem *jobSystem);
+
+        [[nodiscard]] static uint64_t MakeKey(const RenderObject &object,
+                                              const std::optional<glm::mat4> &viewProjection,
+                                              EDrawOrder order) noexcept;
+
+      private:
+        static constexpr uint32_t RADIX = 256u;
+
+        std::vector<uint64_t> m_keys;
+        std::vector<uint64_t> m_scratchKeys;
+        std::vector<uint32_t> m_scratchIndices;
+        /// @brief RADIX counters per batch, turned into the batch's write offsets before scattering
+        std::vector<uint32_t> m_histograms;
+    };
+} // namespace Hush
@@ -0,0 +1,30 @@
+/*! \file Frustum.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief View frustum planes, what the CPU and GPU culling test bounds against
+*/
+
+#include "Frustum.hpp"
+
+Hush::Frustum Hush::Frustum::FromViewProjection(const glm::mat4 &viewProjection) noexcept
+{
+    // glm is column major, so the rows of the matrix are gathered by hand
+    std::array<glm::vec4, 4> rows{};
+    for (glm::length_t row = 0; row < 4; row++)
+    {
+        rows[row] = glm::vec4(viewProjection[0][row], viewProjection[1][row], viewProjection[2][row],
+                              viewProjection[3][row]);
+    }
+
+    Frustum frustum;
+    // Vulkan clips depth to [0, w], not OpenGL's [-w, w], so one depth plane is z >= 0 on its own
+    frustum.planes = {rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1],
+                      rows[3] - rows[1], rows[2], rows[3] - rows[2]};
+    for (glm::vec4 &plane : frustum.planes)
+    {
+        float length = glm::length(glm::vec3(plane));
+        // Degenerate plane, e.g. the far plane of an infinite projection, everything is in front of it
+        plane = length > 1e-6f ? plane / length : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+    return frustum;
+}
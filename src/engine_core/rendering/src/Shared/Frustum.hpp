@@ -0,0 +1,28 @@
+/*! \file Frustum.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief View frustum planes, what the CPU and GPU culling test bounds against
+*/
+
+#pragma once
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace Hush
+{
+    /// @brief Left, right, bottom, top, near and far planes. xyz is the normal, pointing inside, and w the distance, so
+    /// dot(plane.xyz, point) + plane.w >= 0 for every point inside
+    struct Frustum
+    {
+        static constexpr size_t PLANE_COUNT = 6u;
+
+        std::array<glm::vec4, PLANE_COUNT> planes{};
+
+        /// @brief Extracts the normalized planes of a view projection (Gribb-Hartmann). The depth planes are Vulkan's
+        /// clip volume, 0 <= z <= w, so they match what the rasterizer keeps. Reversed depth only swaps which one is
+        /// near, and the missing far plane of an infinite projection never culls anything
+        /// @param viewProjection e.g. Camera::GetViewProjectionMatrix(view), or use Camera::GetFrustum
+        static Frustum FromViewProjection(const glm::mat4 &viewProjection) noexcept;
+    };
+} // namespace Hush
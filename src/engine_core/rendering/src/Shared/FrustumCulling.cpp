@@ -0,0 +1,459 @@
+/*! \file FrustumCulling.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Finds the RenderObjects inside a frustum, several at a time with SIMD and split across the job system
+*/
+
+#include "FrustumCulling.hpp"
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Only this file is built with HUSH_SIMD_AVX's flags, so the rest of the engine keeps running on any x86-64 CPU
+#if defined(__AVX__)
+#include <immintrin.h>
+#define HUSH_CULLING_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HUSH_CULLING_SSE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define HUSH_CULLING_NEON 1
+#endif
+
+namespace
+{
+    // Just the operations the plane tests need. Masks hold a lane per object, ToBits packs them in the low bits.
+    // Every backend does the same multiplies and adds in the same order as the scalar one, so they all agree
+#if HUSH_CULLING_AVX
+    using Lanes = __m256;
+    using Mask = __m256;
+    constexpr uint32_t LANE_COUNT = 8u;
+
+    inline Lanes Broadcast(float value) noexcept
+    {
+        return _mm256_set1_ps(value);
+    }
+
+    inline Lanes Load(const float *values) noexcept
+    {
+        return _mm256_load_ps(values);
+    }
+
+    inline Lanes Add(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm256_add_ps(lhs, rhs);
+    }
+
+    inline Lanes Subtract(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm256_sub_ps(lhs, rhs);
+    }
+
+    inline Lanes Multiply(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm256_mul_ps(lhs, rhs);
+    }
+
+    inline Mask Less(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ);
+    }
+
+    inline Mask GreaterEqual(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ);
+    }
+
+    inline Mask Or(Mask lhs, Mask rhs) noexcept
+    {
+        return _mm256_or_ps(lhs, rhs);
+    }
+
+    inline Mask And(Mask lhs, Mask rhs) noexcept
+    {
+        return _mm256_and_ps(lhs, rhs);
+    }
+
+    inline uint32_t ToBits(Mask mask) noexcept
+    {
+        return static_cast<uint32_t>(_mm256_movemask_ps(mask));
+    }
+#elif HUSH_CULLING_SSE
+    using Lanes = __m128;
+    using Mask = __m128;
+    constexpr uint32_t LANE_COUNT = 4u;
+
+    inline Lanes Broadcast(float value) noexcept
+    {
+        return _mm_set1_ps(value);
+    }
+
+    inline Lanes Load(const float *values) noexcept
+    {
+        return _mm_load_ps(values);
+    }
+
+    inline Lanes Add(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm_add_ps(lhs, rhs);
+    }
+
+    inline Lanes Subtract(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm_sub_ps(lhs, rhs);
+    }
+
+    inline Lanes Multiply(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm_mul_ps(lhs, rhs);
+    }
+
+    inline Mask Less(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm_cmplt_ps(lhs, rhs);
+    }
+
+    inline Mask GreaterEqual(Lanes lhs, Lanes rhs) noexcept
+    {
+        return _mm_cmpge_ps(lhs, rhs);
+    }
+
+    inline Mask Or(Mask lhs, Mask rhs) noexcept
+    {
+        return _mm_or_ps(lhs, rhs);
+    }
+
+    inline Mask And(Mask lhs, Mask rhs) noexcept
+    {
+        return _mm_and_ps(lhs, rhs);
+    }
+
+    inline uint32_t ToBits(Mask mask) noexcept
+    {
+        return static_cast<uint32_t>(_mm_movemask_ps(mask));
+    }
+#elif HUSH_CULLING_NEON
+    using Lanes = float32x4_t;
+    using Mask = uint32x4_t;
+    constexpr uint32_t LANE_COUNT = 4u;
+
+    inline Lanes Broadcast(float value) noexcept
+    {
+        return vdupq_n_f32(value);
+    }
+
+    inline Lanes Load(const float *values) noexcept
+    {
+        return vld1q_f32(values);
+    }
+
+    inline Lanes Add(Lanes lhs, Lanes rhs) noexcept
+    {
+        return vaddq_f32(lhs, rhs);
+    }
+
+    inline Lanes Subtract(Lanes lhs, Lanes rhs) noexcept
+    {
+        return vsubq_f32(lhs, rhs);
+    }
+
+    inline Lanes Multiply(Lanes lhs, Lanes rhs) noexcept
+    {
+        return vmulq_f32(lhs, rhs);
+    }
+
+    inline Mask Less(Lanes lhs, Lanes rhs) noexcept
+    {
+        return vcltq_f32(lhs, rhs);
+    }
+
+    inline Mask GreaterEqual(Lanes lhs, Lanes rhs) noexcept
+    {
+        return vcgeq_f32(lhs, rhs);
+    }
+
+    inline Mask Or(Mask lhs, Mask rhs) noexcept
+    {
+        return vorrq_u32(lhs, rhs);
+    }
+
+    inline Mask And(Mask lhs, Mask rhs) noexcept
+    {
+        return vandq_u32(lhs, rhs);
+    }
+
+    inline uint32_t ToBits(Mask mask) noexcept
+    {
+        const int32_t shifts[LANE_COUNT] = {0, 1, 2, 3};
+        return vaddvq_u32(vshlq_u32(vshrq_n_u32(mask, 31), vld1q_s32(shifts)));
+    }
+#else
+    using Lanes = float;
+    using Mask = uint32_t;
+    constexpr uint32_t LANE_COUNT = 1u;
+
+    inline Lanes Broadcast(float value) noexcept
+    {
+        return value;
+    }
+
+    inline Lanes Load(const float *values) noexcept
+    {
+        return *values;
+    }
+
+    inline Lanes Add(Lanes lhs, Lanes rhs) noexcept
+    {
+        return lhs + rhs;
+    }
+
+    inline Lanes Subtract(Lanes lhs, Lanes rhs) noexcept
+    {
+        return lhs - rhs;
+    }
+
+    inline Lanes Multiply(Lanes lhs, Lanes rhs) noexcept
+    {
+        return lhs * rhs;
+    }
+
+    inline Mask Less(Lanes lhs, Lanes rhs) noexcept
+    {
+        return lhs < rhs ? 1u : 0u;
+    }
+
+    inline Mask GreaterEqual(Lanes lhs, Lanes rhs) noexcept
+    {
+        return lhs >= rhs ? 1u : 0u;
+    }
+
+    inline Mask Or(Mask lhs, Mask rhs) noexcept
+    {
+        return lhs | rhs;
+    }
+
+    inline Mask And(Mask lhs, Mask rhs) noexcept
+    {
+        return lhs & rhs;
+    }
+
+    inline uint32_t ToBits(Mask mask) noexcept
+    {
+        return mask;
+    }
+#endif
+
+    constexpr uint32_t ALL_LANES = (1u << LANE_COUNT) - 1u;
+
+    struct WorldBounds
+    {
+        float center[3];
+        float radius;
+        float extents[3];
+    };
+
+    /// @brief The sphere grows with the biggest scale axis, the box becomes the world AABB around the rotated box
+    WorldBounds ToWorld(const RenderObject &object) noexcept
+    {
+        const glm::mat4 &transform = object.transform;
+        const Bounds &bounds = object.bounds;
+        WorldBounds world{};
+        float scaleSquared[3];
+        for (glm::length_t row = 0; row < 3; row++)
+        {
+            world.center[row] = transform[0][row] * bounds.origin.x + transform[1][row] * bounds.origin.y +
+                                transform[2][row] * bounds.origin.z + transform[3][row];
+            world.extents[row] = std::abs(transform[0][row]) * bounds.extents.x +
+                                 std::abs(transform[1][row]) * bounds.extents.y +
+                                 std::abs(transform[2][row]) * bounds.extents.z;
+            const glm::vec4 &axis = transform[row];
+            scaleSquared[row] = axis.x * axis.x + axis.y * axis.y + axis.z * axis.z;
+        }
+        world.radius = bounds.sphereRadius * std::sqrt(std::max({scaleSquared[0], scaleSquared[1], scaleSquared[2]}));
+        return world;
+    }
+
+    /// @brief Frustum planes broadcast to every lane, along with the absolute normals the box test uses
+    struct PlaneLanes
+    {
+        Lanes x[Hush::Frustum::PLANE_COUNT];
+        Lanes y[Hush::Frustum::PLANE_COUNT];
+        Lanes z[Hush::Frustum::PLANE_COUNT];
+        Lanes w[Hush::Frustum::PLANE_COUNT];
+        Lanes absX[Hush::Frustum::PLANE_COUNT];
+        Lanes absY[Hush::Frustum::PLANE_COUNT];
+        Lanes absZ[Hush::Frustum::PLANE_COUNT];
+    };
+
+    /// @brief World bounds of LANE_COUNT objects, one array per component so each loads straight into a register
+    struct alignas(32) BoundsLanes
+    {
+        float center[3][LANE_COUNT];
+        float radius[LANE_COUNT];
+        float extents[3][LANE_COUNT];
+    };
+
+    /// @return The bits of the lanes whose objects are visible
+    uint32_t TestLanes(const PlaneLanes &planes, const BoundsLanes &bounds) noexcept
+    {
+        Lanes zero = Broadcast(0.0f);
+        Lanes centerX = Load(bounds.center[0]);
+        Lanes centerY = Load(bounds.center[1]);
+        Lanes centerZ = Load(bounds.center[2]);
+        Lanes radius = Load(bounds.radius);
+
+        // Spheres first, they decide most objects: fully outside a plane or fully inside all of them
+        Mask sphereOutside = Less(zero, zero);
+        Mask sphereInside = GreaterEqual(zero, zero);
+        Lanes distances[Hush::Frustum::PLANE_COUNT];
+        for (size_t plane = 0; plane < Hush::Frustum::PLANE_COUNT; plane++)
+        {
+            Lanes distance = Add(Add(Add(Multiply(planes.x[plane], centerX), Multiply(planes.y[plane], centerY)),
+                                     Multiply(planes.z[plane], centerZ)),
+                                 planes.w[plane]);
+            distances[plane] = distance;
+            sphereOutside = Or(sphereOutside, Less(Add(distance, radius), zero));
+            sphereInside = And(sphereInside, GreaterEqual(Subtract(distance, radius), zero));
+        }
+        uint32_t outsideBits = ToBits(sphereOutside);
+        uint32_t insideBits = ToBits(sphereInside) & ~outsideBits;
+        if (((outsideBits | insideBits) & ALL_LANES) == ALL_LANES)
+        {
+            return insideBits;
+        }
+
+        // The rest straddle a plane, the box is tighter for long or flat objects
+        Lanes extentX = Load(bounds.extents[0]);
+        Lanes extentY = Load(bounds.extents[1]);
+        Lanes extentZ = Load(bounds.extents[2]);
+        Mask boxOutside = Less(zero, zero);
+        for (size_t plane = 0; plane < Hush::Frustum::PLANE_COUNT; plane++)
+        {
+            Lanes reach = Add(Add(Multiply(planes.absX[plane], extentX), Multiply(planes.absY[plane], extentY)),
+                              Multiply(planes.absZ[plane], extentZ));
+            boxOutside = Or(boxOutside, Less(Add(distances[plane], reach), zero));
+        }
+        return insideBits | (~(outsideBits | ToBits(boxOutside)) & ALL_LANES);
+    }
+
+    PlaneLanes BroadcastPlanes(const Hush::Frustum &frustum) noexcept
+    {
+        PlaneLanes planes{};
+        for (size_t plane = 0; plane < Hush::Frustum::PLANE_COUNT; plane++)
+        {
+            const glm::vec4 &value = frustum.planes[plane];
+            planes.x[plane] = Broadcast(value.x);
+            planes.y[plane] = Broadcast(value.y);
+            planes.z[plane] = Broadcast(value.z);
+            planes.w[plane] = Broadcast(value.w);
+            planes.absX[plane] = Broadcast(std::abs(value.x));
+            planes.absY[plane] = Broadcast(std::abs(value.y));
+            planes.absZ[plane] = Broadcast(std::abs(value.z));
+        }
+        return planes;
+    }
+
+    /// @brief Culls [begin, end) and writes the visible indices to output
+    /// @return How many were written
+    uint32_t CullRange(const PlaneLanes &planes, const RenderObject *objects, uint32_t begin, uint32_t end,
+                       uint32_t *output) noexcept
+    {
+        uint32_t visibleCount = 0u;
+        BoundsLanes bounds{};
+        for (uint32_t first = begin; first < end; first += LANE_COUNT)
+        {
+            uint32_t laneCount = std::min(LANE_COUNT, end - first);
+            for (uint32_t lane = 0; lane < laneCount; lane++)
+            {
+                WorldBounds world = ToWorld(objects[first + lane]);
+                for (size_t axis = 0; axis < 3; axis++)
+                {
+                    bounds.center[axis][lane] = world.center[axis];
+                    bounds.extents[axis][lane] = world.extents[axis];
+                }
+                bounds.radius[lane] = world.radius;
+            }
+            uint32_t visibleBits = TestLanes(planes, bounds) & ((1u << laneCount) - 1u);
+            for (uint32_t lane = 0; visibleBits != 0u; lane++, visibleBits >>= 1u)
+            {
+                if ((visibleBits & 1u) != 0u)
+                {
+                    output[visibleCount++] = first + lane;
+                }
+            }
+        }
+        return visibleCount;
+    }
+} // namespace
+
+const uint32_t Hush::FrustumCuller::SIMD_WIDTH = LANE_COUNT;
+
+uint32_t Hush::FrustumCuller::Cull(const Frustum &frustum, const std::vector<RenderObject> &objects,
+                                   std::vector<uint32_t> &visibleIndices, JobSystem *jobSystem)
+{
+    HUSH_PROFILE_SCOPE("FrustumCuller::Cull");
+    auto count = static_cast<uint32_t>(objects.size());
+    // Each batch writes from its own begin, then the results are packed to the front
+    visibleIndices.resize(count);
+    PlaneLanes planes = BroadcastPlanes(frustum);
+
+    if (jobSystem == nullptr || count < PARALLEL_THRESHOLD)
+    {
+        uint32_t visibleCount = CullRange(planes, objects.data(), 0u, count, visibleIndices.data());
+        visibleIndices.resize(visibleCount);
+        return visibleCount;
+    }
+
+    uint32_t batchCount = (count + BATCH_SIZE - 1u) / BATCH_SIZE;
+    this->m_batchCounts.assign(batchCount, 0u);
+    jobSystem->ParallelFor(count, BATCH_SIZE, [&](uint32_t begin, uint32_t end) {
+        this->m_batchCounts[begin / BATCH_SIZE] =
+            CullRange(planes, objects.data(), begin, end, visibleIndices.data() + begin);
+    });
+
+    uint32_t visibleCount = this->m_batchCounts[0];
+    for (uint32_t batch = 1; batch < batchCount; batch++)
+    {
+        std::memmove(visibleIndices.data() + visibleCount, visibleIndices.data() + batch * BATCH_SIZE,
+                     this->m_batchCounts[batch] * sizeof(uint32_t));
+        visibleCount += this->m_batchCounts[batch];
+    }
+    visibleIndices.resize(visibleCount);
+    return visibleCount;
+}
+
+bool Hush::FrustumCuller::IsVisible(const Frustum &frustum, const RenderObject &object) noexcept
+{
+    WorldBounds world = ToWorld(object);
+    bool inside = true;
+    float distances[Frustum::PLANE_COUNT];
+    for (size_t plane = 0; plane < Frustum::PLANE_COUNT; plane++)
+    {
+        const glm::vec4 &value = frustum.planes[plane];
+        distances[plane] = value.x * world.center[0] + value.y * world.center[1] + value.z * world.center[2] + value.w;
+        if (distances[plane] + world.radius < 0.0f)
+        {
+            return false;
+        }
+        inside = inside && distances[plane] - world.radius >= 0.0f;
+    }
+    if (inside)
+    {
+        return true;
+    }
+    for (size_t plane = 0; plane < Frustum::PLANE_COUNT; plane++)
+    {
+        const glm::vec4 &value = frustum.planes[plane];
+        float reach = std::abs(value.x) * world.extents[0] + std::abs(value.y) * world.extents[1] +
+                      std::abs(value.z) * world.extents[2];
+        if (distances[plane] + reach < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,46 @@
+/*! \file FrustumCulling.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Finds the RenderObjects inside a frustum, several at a time with SIMD and split across the job system
+*/
+
+#pragma once
+#include "Frustum.hpp"
+#include "RenderObject.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Hush
+{
+    class JobSystem;
+
+    /// @brief Tests the world space bounds of RenderObjects against a frustum. Each object's Bounds are moved to
+    /// world space with its transform, then tested as a sphere first. The world AABB is only tested for the objects
+    /// the sphere test couldn't decide. SIMD_WIDTH objects are tested at once (AVX, SSE2, NEON or scalar, picked at
+    /// compile time, see HUSH_SIMD_AVX), and big lists are split in batches across the job system.
+    /// Keeps its scratch memory between calls, use one per thread
+    class FrustumCuller
+    {
+      public:
+        /// @brief Objects tested together, 8 with AVX, 4 with SSE2 or NEON, 1 without SIMD
+        static const uint32_t SIMD_WIDTH;
+        /// @brief Lists smaller than this are culled on the calling thread
+        static constexpr uint32_t PARALLEL_THRESHOLD = 16384u;
+        static constexpr uint32_t BATCH_SIZE = 8192u;
+
+        /// @brief Writes the indices of the visible objects to visibleIndices, in increasing order
+        /// @param jobSystem splits lists of PARALLEL_THRESHOLD objects or more across it, nullptr culls on the calling
+        /// thread
+        /// @return The number of visible objects, visibleIndices is resized to it
+        uint32_t Cull(const Frustum &frustum, const std::vector<RenderObject> &objects,
+                      std::vector<uint32_t> &visibleIndices, JobSystem *jobSystem);
+
+        /// @brief Tests a single object without SIMD, same result as Cull
+        [[nodiscard]] static bool IsVisible(const Frustum &frustum, const RenderObject &object) noexcept;
+
+      private:
+        /// @brief Visible objects each batch of the last parallel Cull found
+        std::vector<uint32_t> m_batchCounts;
+    };
+} // namespace Hush
@@ -14,16 +14,32 @@ enum class EMaterialPass : uint8_t
     Transparent,
     Other
 };
+namespace Hush
+{
+    class RegisteredPipeline;
+}
+
 struct MaterialPipeline
 {
     VkPipeline pipeline;
     VkPipelineLayout layout;
+    /// @brief Set for pipelines from VulkanPipelineRegistry, draws then use registered->Get() instead of pipeline, so
+    /// an async build replaces its fallback as soon as it's ready
+    const Hush::RegisteredPipeline *registered = nullptr;
+    /// @brief The opaque objects using it are culled and drawn indirectly on the GPU, see VulkanGpuCuller. Its vertex
+    /// shader must read the world matrix and material index with the bindless.glsl helpers, which every bindless
+    /// material does anyway since VulkanDrawInstancer instances them
+    bool gpuDriven = false;
 };
 
 struct MaterialInstance {
     MaterialPipeline *pipeline;
+    /// @brief Only for pipelines that don't use the bindless layout, nullptr otherwise
     VkDescriptorSet materialSet;
     EMaterialPass passType;
+    /// @brief Bindless heap slot of the storage buffer holding this material's parameters (texture and sampler
+    /// indices, factors...), pushed with every draw
+    uint32_t materialIndex = 0u;
 };
 
 //< mat_types
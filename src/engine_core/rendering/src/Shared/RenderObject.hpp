@@ -6,9 +6,13 @@
 
 #pragma once
 #include <vulkan/vulkan.h>
+#include "Camera.hpp"
+#include "Frustum.hpp"
 #include "MaterialDefinitions.hpp"
+#include <optional>
 #include <vector>
 
+/// @brief Local space bounds, the transform of the RenderObject moves them to world space
 struct Bounds
 {
     glm::vec3 origin;
@@ -16,22 +20,43 @@ struct Bounds
     glm::vec3 extents;
 };
 
+/// @brief Where a mesh lives in the renderer's geometry pool, see VulkanGeometryPool
+struct MeshGeometry
+{
+    uint32_t firstIndex = 0u;
+    uint32_t indexCount = 0u;
+    int32_t vertexOffset = 0;
+    uint32_t vertexCount = 0u;
+};
+
+/// @brief Geometry is referenced by offsets into the geometry pool, which is bound once per frame
 struct RenderObject
 {
     uint32_t indexCount;
     uint32_t firstIndex;
-    VkBuffer indexBuffer; //TODO: Make this a generic index buffer class
+    int32_t vertexOffset;
 
     MaterialInstance *material;
     Bounds bounds;
     glm::mat4 transform;
-    VkDeviceAddress vertexBufferAddress;
 };
 
 struct DrawContext
 {
     std::vector<RenderObject> opaqueSurfaces;
     std::vector<RenderObject> transparentSurfaces;
+    /// @brief Objects whose bounds are outside it are not drawn, see Hush::FrustumCuller. Unset draws everything
+    std::optional<Hush::Frustum> cullingFrustum;
+    /// @brief Camera projection times view with reversed depth (near is 1), set it to also cull the gpu driven objects
+    /// hidden behind what was drawn. Only pipelines with EnableDepthTest(true, VK_COMPARE_OP_GREATER_OR_EQUAL) occlude
+    std::optional<glm::mat4> viewProjection;
+
+    /// @brief Culls and occludes with what the camera sees through view, sets cullingFrustum and viewProjection
+    void SetCamera(const Hush::Camera &camera, const glm::mat4 &view) noexcept
+    {
+        this->viewProjection = camera.GetViewProjectionMatrix(view);
+        this->cullingFrustum = Hush::Frustum::FromViewProjection(*this->viewProjection);
+    }
 };
 
 class IRenderable {
@@ -0,0 +1,26 @@
+/*! \file RenderSnapshot.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Everything needed to record a frame, handed from the game thread to the render thread
+*/
+
+#pragma once
+#include "RenderObject.hpp"
+#include <imgui/imgui.h>
+#include <cstdint>
+
+namespace Hush
+{
+    /// @brief Built by the game thread and only read by the render thread once published, so neither thread touches
+    /// the other's data
+    struct RenderSnapshot
+    {
+        DrawContext drawContext;
+        /// @brief UI to render, either ImGui's own draw data (single threaded rendering) or uiDrawDataCopy
+        ImDrawData *uiDrawData = nullptr;
+        /// @brief Copy of the UI draw lists, lets the game thread start the next ImGui frame while this one renders
+        ImDrawData uiDrawDataCopy;
+        /// @brief Game frame that produced this snapshot
+        uint64_t frameNumber = 0;
+    };
+} // namespace Hush
@@ -5,7 +5,8 @@
 */
 
 #pragma once
-#include "VulkanDeletionQueue.hpp"
+#include "VulkanGpuTimestamps.hpp"
+#include "VulkanVertexBuffer.hpp"
 #include <vulkan/vulkan.h>
 #include "VkDescriptors.hpp"
 
@@ -19,12 +20,21 @@ struct FrameData
     /// @brief Controls presenting the image to the OS once drawing is finished
     VkSemaphore renderSemaphore;
 
-    /// @brief Lets us wait for the draw commands of a given frame to be finished.
-    VkFence renderFence;
+    /// @brief Value of the frame timeline signaled by the last submission of this frame, once the GPU reaches it the
+    /// frame can be recorded again
+    uint64_t timelineValue = 0u;
 
     VkCommandBuffer mainCommandBuffer;
     VkCommandPool commandPool;
-    VulkanDeletionQueue deletionQueue;
 
     DescriptorAllocatorGrowable frameDescriptors;
+
+    /// @brief GPU time of the passes recorded in this frame, read back the next time the frame is used
+    Hush::GpuTimestampQueries timestampQueries;
+
+    /// @brief GPUSceneData of the frame, mapped. Pushed to every draw as GPUDrawPushConstants::sceneData
+    Hush::VulkanVertexBuffer sceneData;
+
+    /// @brief Profiler ticks when this frame was submitted, anchors its GPU timings on the profiler
+    uint64_t submitTicks = 0u;
 };
\ No newline at end of file
@@ -0,0 +1,411 @@
+/*! \file SpirvReflection.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Minimal SPIR-V reflection, enough to build descriptor set and pipeline layouts
+*/
+
+#define VK_NO_PROTOTYPES
+#include "SpirvReflection.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+// Opcodes, decorations and enums from the SPIR-V specification, only the ones the reflection looks at
+static constexpr uint32_t SPIRV_MAGIC = 0x07230203u;
+static constexpr size_t SPIRV_HEADER_WORDS = 5u;
+
+static constexpr uint32_t OP_ENTRY_POINT = 15u;
+static constexpr uint32_t OP_TYPE_BOOL = 20u;
+static constexpr uint32_t OP_TYPE_INT = 21u;
+static constexpr uint32_t OP_TYPE_FLOAT = 22u;
+static constexpr uint32_t OP_TYPE_VECTOR = 23u;
+static constexpr uint32_t OP_TYPE_MATRIX = 24u;
+static constexpr uint32_t OP_TYPE_IMAGE = 25u;
+static constexpr uint32_t OP_TYPE_SAMPLER = 26u;
+static constexpr uint32_t OP_TYPE_SAMPLED_IMAGE = 27u;
+static constexpr uint32_t OP_TYPE_ARRAY = 28u;
+static constexpr uint32_t OP_TYPE_RUNTIME_ARRAY = 29u;
+static constexpr uint32_t OP_TYPE_STRUCT = 30u;
+static constexpr uint32_t OP_TYPE_POINTER = 32u;
+static constexpr uint32_t OP_CONSTANT = 43u;
+static constexpr uint32_t OP_VARIABLE = 59u;
+static constexpr uint32_t OP_DECORATE = 71u;
+static constexpr uint32_t OP_MEMBER_DECORATE = 72u;
+static constexpr uint32_t OP_TYPE_ACCELERATION_STRUCTURE = 5341u;
+
+static constexpr uint32_t DECORATION_BUFFER_BLOCK = 3u;
+static constexpr uint32_t DECORATION_ARRAY_STRIDE = 6u;
+static constexpr uint32_t DECORATION_MATRIX_STRIDE = 7u;
+static constexpr uint32_t DECORATION_BINDING = 33u;
+static constexpr uint32_t DECORATION_DESCRIPTOR_SET = 34u;
+static constexpr uint32_t DECORATION_OFFSET = 35u;
+
+static constexpr uint32_t STORAGE_CLASS_UNIFORM_CONSTANT = 0u;
+static constexpr uint32_t STORAGE_CLASS_UNIFORM = 2u;
+static constexpr uint32_t STORAGE_CLASS_PUSH_CONSTANT = 9u;
+static constexpr uint32_t STORAGE_CLASS_STORAGE_BUFFER = 12u;
+
+static constexpr uint32_t IMAGE_DIM_BUFFER = 5u;
+static constexpr uint32_t IMAGE_DIM_SUBPASS_DATA = 6u;
+/// @brief OpTypeImage's Sampled operand for images used without a sampler
+static constexpr uint32_t IMAGE_STORAGE = 2u;
+
+/// @brief Nested types deeper than this are treated as malformed
+static constexpr uint32_t MAX_TYPE_DEPTH = 32u;
+
+namespace
+{
+    /// @brief What the reflection remembers of a result id
+    struct IdInfo
+    {
+        uint32_t opcode = 0u;
+        /// @brief Index of the defining instruction's first word
+        size_t instruction = 0u;
+        uint32_t set = UINT32_MAX;
+        uint32_t binding = UINT32_MAX;
+        uint32_t arrayStride = 0u;
+        bool bufferBlock = false;
+        std::vector<uint32_t> memberOffsets;
+        std::vector<uint32_t> memberMatrixStrides;
+    };
+
+    struct Module
+    {
+        const uint32_t *words;
+        std::vector<IdInfo> ids;
+
+        /// @brief Operand index of the defining instruction, 0 being the first word after the opcode
+        [[nodiscard]] uint32_t Operand(uint32_t id, size_t operand) const noexcept
+        {
+            return this->words[this->ids[id].instruction + 1u + operand];
+        }
+
+        [[nodiscard]] uint32_t WordCount(uint32_t id) const noexcept
+        {
+            return this->words[this->ids[id].instruction] >> 16u;
+        }
+    };
+} // namespace
+
+static VkShaderStageFlagBits StageFromExecutionModel(uint32_t executionModel) noexcept
+{
+    switch (executionModel)
+    {
+    case 0u:
+        return VK_SHADER_STAGE_VERTEX_BIT;
+    case 1u:
+        return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+    case 2u:
+        return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+    case 3u:
+        return VK_SHADER_STAGE_GEOMETRY_BIT;
+    case 4u:
+        return VK_SHADER_STAGE_FRAGMENT_BIT;
+    case 5u:
+        return VK_SHADER_STAGE_COMPUTE_BIT;
+    case 5364u:
+        return VK_SHADER_STAGE_TASK_BIT_EXT;
+    case 5365u:
+        return VK_SHADER_STAGE_MESH_BIT_EXT;
+    default:
+        return VK_SHADER_STAGE_ALL;
+    }
+}
+
+static void EnsureMember(std::vector<uint32_t> &values, uint32_t member)
+{
+    if (values.size() <= member)
+    {
+        values.resize(static_cast<size_t>(member) + 1u, 0u);
+    }
+}
+
+/// @brief Size in bytes of a type laid out with explicit offsets and strides, as push constant blocks are
+static uint32_t GetTypeSize(const Module &module, uint32_t typeId, uint32_t matrixStride, uint32_t depth)
+{
+    if (typeId >= module.ids.size() || depth > MAX_TYPE_DEPTH)
+    {
+        return 0u;
+    }
+    const IdInfo &type = module.ids[typeId];
+    switch (type.opcode)
+    {
+    case OP_TYPE_BOOL:
+        return 4u;
+    case OP_TYPE_INT:
+    case OP_TYPE_FLOAT:
+        return module.Operand(typeId, 1u) / 8u;
+    case OP_TYPE_VECTOR:
+        return GetTypeSize(module, module.Operand(typeId, 1u), 0u, depth + 1u) * module.Operand(typeId, 2u);
+    case OP_TYPE_MATRIX: {
+        uint32_t columnCount = module.Operand(typeId, 2u);
+        if (matrixStride != 0u)
+        {
+            return matrixStride * columnCount;
+        }
+        return GetTypeSize(module, module.Operand(typeId, 1u), 0u, depth + 1u) * columnCount;
+    }
+    case OP_TYPE_ARRAY: {
+        uint32_t lengthId = module.Operand(typeId, 2u);
+        if (lengthId >= module.ids.size() || module.ids[lengthId].opcode != OP_CONSTANT)
+        {
+            return 0u;
+        }
+        uint32_t length = module.Operand(lengthId, 2u);
+        uint32_t stride = type.arrayStride;
+        if (stride == 0u)
+        {
+            stride = GetTypeSize(module, module.Operand(typeId, 1u), matrixStride, depth + 1u);
+        }
+        return stride * length;
+    }
+    case OP_TYPE_STRUCT: {
+        uint32_t size = 0u;
+        uint32_t memberCount = module.WordCount(typeId) - 2u;
+        for (uint32_t member = 0u; member < memberCount; member++)
+        {
+            uint32_t offset = member < type.memberOffsets.size() ? type.memberOffsets[member] : 0u;
+            uint32_t memberStride = member < type.memberMatrixStrides.size() ? type.memberMatrixStrides[member] : 0u;
+            uint32_t memberSize = GetTypeSize(module, module.Operand(typeId, 1u + member), memberStride, depth + 1u);
+            size = std::max(size, offset + memberSize);
+        }
+        return size;
+    }
+    default:
+        return 0u;
+    }
+}
+
+/// @brief Descriptor type of a resource variable's pointee, with arrays already stripped
+static VkDescriptorType GetDescriptorType(const Module &module, uint32_t typeId, uint32_t storageClass)
+{
+    const IdInfo &type = module.ids[typeId];
+    if (storageClass == STORAGE_CLASS_STORAGE_BUFFER)
+    {
+        return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    }
+    if (storageClass == STORAGE_CLASS_UNIFORM)
+    {
+        // Pre 1.3 SPIR-V marks storage buffers as BufferBlock structs in the Uniform storage class
+        return type.bufferBlock ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    }
+    switch (type.opcode)
+    {
+    case OP_TYPE_SAMPLER:
+        return VK_DESCRIPTOR_TYPE_SAMPLER;
+    case OP_TYPE_SAMPLED_IMAGE:
+        return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    case OP_TYPE_ACCELERATION_STRUCTURE:
+        return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+    case OP_TYPE_IMAGE: {
+        uint32_t dim = module.Operand(typeId, 2u);
+        bool storage = module.Operand(typeId, 6u) == IMAGE_STORAGE;
+        if (dim == IMAGE_DIM_BUFFER)
+        {
+            return storage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+        }
+        if (dim == IMAGE_DIM_SUBPASS_DATA)
+        {
+            return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        }
+        return storage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    }
+    default:
+        return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+    }
+}
+
+bool Hush::SpirvReflection::Reflect(const uint32_t *words, size_t wordCount, SpirvReflection &outReflection)
+{
+    outReflection = SpirvReflection{};
+    if (words == nullptr || wordCount < SPIRV_HEADER_WORDS || words[0] != SPIRV_MAGIC)
+    {
+        LogError("Not a SPIR-V module");
+        return false;
+    }
+
+    Module module{words, std::vector<IdInfo>(words[3])};
+    std::vector<uint32_t> variables;
+    bool hasEntryPoint = false;
+
+    // Single pass, every id we care about is defined before the variables that use it
+    size_t offset = SPIRV_HEADER_WORDS;
+    while (offset < wordCount)
+    {
+        uint32_t opcode = words[offset] & 0xFFFFu;
+        uint32_t instructionWords = words[offset] >> 16u;
+        if (instructionWords == 0u || offset + instructionWords > wordCount)
+        {
+            LogError("Truncated SPIR-V instruction");
+            return false;
+        }
+        const uint32_t *operands = words + offset + 1u;
+
+        // Result id position of the instructions we keep, types have it first and the rest after the result type
+        uint32_t resultId = UINT32_MAX;
+        switch (opcode)
+        {
+        case OP_ENTRY_POINT:
+            if (!hasEntryPoint && instructionWords > 3u)
+            {
+                outReflection.stage = StageFromExecutionModel(operands[0]);
+                const auto *name = reinterpret_cast<const char *>(operands + 2u);
+                outReflection.entryPoint.assign(name, strnlen(name, (instructionWords - 3u) * sizeof(uint32_t)));
+                hasEntryPoint = true;
+            }
+            break;
+        case OP_DECORATE:
+            if (instructionWords >= 3u && operands[0] < module.ids.size())
+            {
+                IdInfo &target = module.ids[operands[0]];
+                uint32_t value = instructionWords > 3u ? operands[2] : 0u;
+                switch (operands[1])
+                {
+                case DECORATION_BUFFER_BLOCK:
+                    target.bufferBlock = true;
+                    break;
+                case DECORATION_ARRAY_STRIDE:
+                    target.arrayStride = value;
+                    break;
+                case DECORATION_BINDING:
+                    target.binding = value;
+                    break;
+                case DECORATION_DESCRIPTOR_SET:
+                    target.set = value;
+                    break;
+                default:
+                    break;
+                }
+            }
+            break;
+        case OP_MEMBER_DECORATE:
+            if (instructionWords > 4u && operands[0] < module.ids.size())
+            {
+                IdInfo &target = module.ids[operands[0]];
+                if (operands[2] == DECORATION_OFFSET)
+                {
+                    EnsureMember(target.memberOffsets, operands[1]);
+                    target.memberOffsets[operands[1]] = operands[3];
+                }
+                else if (operands[2] == DECORATION_MATRIX_STRIDE)
+                {
+                    EnsureMember(target.memberMatrixStrides, operands[1]);
+                    target.memberMatrixStrides[operands[1]] = operands[3];
+                }
+            }
+            break;
+        case OP_TYPE_BOOL:
+        case OP_TYPE_INT:
+        case OP_TYPE_FLOAT:
+        case OP_TYPE_VECTOR:
+        case OP_TYPE_MATRIX:
+        case OP_TYPE_IMAGE:
+        case OP_TYPE_SAMPLER:
+        case OP_TYPE_SAMPLED_IMAGE:
+        case OP_TYPE_ARRAY:
+        case OP_TYPE_RUNTIME_ARRAY:
+        case OP_TYPE_STRUCT:
+        case OP_TYPE_POINTER:
+        case OP_TYPE_ACCELERATION_STRUCTURE:
+            resultId = instructionWords > 1u ? operands[0] : UINT32_MAX;
+            break;
+        case OP_CONSTANT:
+        case OP_VARIABLE:
+            resultId = instructionWords > 3u ? operands[1] : UINT32_MAX;
+            break;
+        default:
+            break;
+        }
+
+        if (resultId < module.ids.size())
+        {
+            module.ids[resultId].opcode = opcode;
+            module.ids[resultId].instruction = offset;
+            if (opcode == OP_VARIABLE)
+            {
+                variables.push_back(resultId);
+            }
+        }
+        offset += instructionWords;
+    }
+
+    if (!hasEntryPoint)
+    {
+        LogError("SPIR-V module has no entry point");
+        return false;
+    }
+
+    for (uint32_t variable : variables)
+    {
+        uint32_t storageClass = module.Operand(variable, 2u);
+        uint32_t pointerId = module.Operand(variable, 0u);
+        if (pointerId >= module.ids.size() || module.ids[pointerId].opcode != OP_TYPE_POINTER)
+        {
+            continue;
+        }
+        uint32_t typeId = module.Operand(pointerId, 2u);
+
+        if (storageClass == STORAGE_CLASS_PUSH_CONSTANT)
+        {
+            outReflection.pushConstantSize =
+                std::max(outReflection.pushConstantSize, GetTypeSize(module, typeId, 0u, 0u));
+            continue;
+        }
+        if (storageClass != STORAGE_CLASS_UNIFORM_CONSTANT && storageClass != STORAGE_CLASS_UNIFORM &&
+            storageClass != STORAGE_CLASS_STORAGE_BUFFER)
+        {
+            continue;
+        }
+        const IdInfo &info = module.ids[variable];
+        if (info.binding == UINT32_MAX)
+        {
+            continue;
+        }
+
+        ReflectedBinding binding{};
+        binding.set = info.set == UINT32_MAX ? 0u : info.set;
+        binding.binding = info.binding;
+        // Arrays of resources are one binding with descriptorCount elements
+        uint32_t depth = 0u;
+        while (typeId < module.ids.size() && depth++ < MAX_TYPE_DEPTH)
+        {
+            uint32_t typeOpcode = module.ids[typeId].opcode;
+            if (typeOpcode == OP_TYPE_RUNTIME_ARRAY)
+            {
+                binding.descriptorCount = 0u;
+            }
+            else if (typeOpcode == OP_TYPE_ARRAY)
+            {
+                uint32_t lengthId = module.Operand(typeId, 2u);
+                uint32_t length = lengthId < module.ids.size() && module.ids[lengthId].opcode == OP_CONSTANT
+                                      ? module.Operand(lengthId, 2u)
+                                      : 1u;
+                binding.descriptorCount *= length;
+            }
+            else
+            {
+                break;
+            }
+            typeId = module.Operand(typeId, 1u);
+        }
+        if (typeId >= module.ids.size())
+        {
+            continue;
+        }
+        binding.type = GetDescriptorType(module, typeId, storageClass);
+        if (binding.type == VK_DESCRIPTOR_TYPE_MAX_ENUM)
+        {
+            LogFormat(ELogLevel::Warn, "Skipping SPIR-V resource at set {} binding {}, its type is not supported",
+                      binding.set, binding.binding);
+            continue;
+        }
+        outReflection.bindings.push_back(binding);
+    }
+
+    std::sort(outReflection.bindings.begin(), outReflection.bindings.end(),
+              [](const ReflectedBinding &lhs, const ReflectedBinding &rhs) {
+                  return lhs.set != rhs.set ? lhs.set < rhs.set : lhs.binding < rhs.binding;
+              });
+    return true;
+}
@@ -0,0 +1,42 @@
+/*! \file SpirvReflection.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Minimal SPIR-V reflection, enough to build descriptor set and pipeline layouts
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    struct ReflectedBinding
+    {
+        uint32_t set = 0u;
+        uint32_t binding = 0u;
+        VkDescriptorType type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        /// @brief Array size, 0 for runtime sized arrays
+        uint32_t descriptorCount = 1u;
+    };
+
+    /// @brief What a pipeline layout needs to know about a shader module. Only the first entry point is reflected and
+    /// every resource variable of the module is reported, used by that entry point or not
+    struct SpirvReflection
+    {
+        VkShaderStageFlagBits stage = VK_SHADER_STAGE_ALL;
+        std::string entryPoint;
+        /// @brief Sorted by set, then binding
+        std::vector<ReflectedBinding> bindings;
+        /// @brief Bytes of the push constant block, 0 if the shader has none
+        uint32_t pushConstantSize = 0u;
+
+        /// @brief Walks the module's instructions once, no SPIR-V tools involved. Dynamic buffers can't be told apart
+        /// from regular ones this way, they reflect as their non dynamic type
+        /// @return false if the words are not a valid module or have no entry point
+        static bool Reflect(const uint32_t *words, size_t wordCount, SpirvReflection &outReflection);
+    };
+} // namespace Hush
@@ -159,7 +159,9 @@ void DescriptorAllocatorGrowable::Init(VkDevice device, uint32_t initialSets,
     }
 
     VkDescriptorPool newPool = this->CreatePool(device, initialSets, poolRatios);
-    
+    this->m_setsAllocated = 0u;
+    this->m_exhaustionRetries = 0u;
+
     // NOLINTNEXTLINE
     this->m_setsPerPool = static_cast<uint32_t>(initialSets * 1.5); // grow it next allocation
 
@@ -178,6 +180,7 @@ void DescriptorAllocatorGrowable::ClearPool(VkDevice device)
         this->m_readyPools.push_back(p);
     }
     this->m_fullPools.clear();
+    this->m_setsAllocated = 0u;
 }
 
 void DescriptorAllocatorGrowable::DestroyPool(VkDevice device)
@@ -214,6 +217,7 @@ VkDescriptorSet DescriptorAllocatorGrowable::Allocate(VkDevice device, VkDescrip
     {
 
         this->m_fullPools.push_back(poolToUse);
+        this->m_exhaustionRetries++;
 
         poolToUse = this->GetPool(device);
         allocInfo.descriptorPool = poolToUse;
@@ -222,9 +226,19 @@ VkDescriptorSet DescriptorAllocatorGrowable::Allocate(VkDevice device, VkDescrip
     }
 
     this->m_readyPools.push_back(poolToUse);
+    this->m_setsAllocated++;
     return ds;
 }
 
+DescriptorAllocatorGrowable::Stats DescriptorAllocatorGrowable::GetStats() const noexcept
+{
+    Stats stats{};
+    stats.poolCount = static_cast<uint32_t>(this->m_readyPools.size() + this->m_fullPools.size());
+    stats.setsAllocated = this->m_setsAllocated;
+    stats.exhaustionRetries = this->m_exhaustionRetries;
+    return stats;
+}
+
 VkDescriptorPool DescriptorAllocatorGrowable::GetPool(VkDevice device)
 {
     VkDescriptorPool newPool = nullptr;
@@ -252,8 +266,25 @@ VkDescriptorPool DescriptorAllocatorGrowable::GetPool(VkDevice device)
 VkDescriptorPool DescriptorAllocatorGrowable::CreatePool(VkDevice device, uint32_t setCount,
                                                          const std::vector<PoolSizeRatio> &poolRatios)
 {
-    (void)device;
-    (void)setCount;
-    (void)poolRatios;
-    return VkDescriptorPool();
+    std::vector<VkDescriptorPoolSize> poolSizes;
+    poolSizes.reserve(poolRatios.size());
+    for (PoolSizeRatio ratio : poolRatios)
+    {
+        VkDescriptorPoolSize toInsert = {};
+        toInsert.type = ratio.type;
+        toInsert.descriptorCount = static_cast<uint32_t>(ratio.ratio * static_cast<float>(setCount));
+        poolSizes.push_back(toInsert);
+    }
+
+    // No VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, sets are only released in bulk by ClearPool
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = 0;
+    poolInfo.maxSets = setCount;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+
+    VkDescriptorPool newPool = nullptr;
+    HUSH_VK_ASSERT(vkCreateDescriptorPool(device, &poolInfo, nullptr, &newPool), "Creating descriptor pool failed!");
+    return newPool;
 }
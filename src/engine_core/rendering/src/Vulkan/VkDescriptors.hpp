@@ -60,6 +60,8 @@ struct DescriptorAllocator
 //< descriptor_allocator
 
 //> descriptor_allocator_grow
+/// @brief Allocates sets out of a list of pools, adding a bigger pool whenever the current ones run out. Sets are never
+/// freed one by one, ClearPool resets every pool at once so allocating stays O(1)
 struct DescriptorAllocatorGrowable
 {
   public:
@@ -69,12 +71,24 @@ struct DescriptorAllocatorGrowable
         float ratio;
     };
 
+    struct Stats
+    {
+        uint32_t poolCount = 0u;
+        /// @brief Since the last ClearPool
+        uint32_t setsAllocated = 0u;
+        /// @brief Allocations that found their pool full and had to retry on another one, since Init
+        uint32_t exhaustionRetries = 0u;
+    };
+
     void Init(VkDevice device, uint32_t initialSets, const std::vector<PoolSizeRatio> &poolRatios);
+    /// @brief Resets every pool, the sets allocated from them must not be in use by the GPU anymore
     void ClearPool(VkDevice device);
     void DestroyPool(VkDevice device);
 
     VkDescriptorSet Allocate(VkDevice device, VkDescriptorSetLayout layout, void *pNext = nullptr);
 
+    [[nodiscard]] Stats GetStats() const noexcept;
+
   private:
     VkDescriptorPool GetPool(VkDevice device);
     VkDescriptorPool CreatePool(VkDevice device, uint32_t setCount, const std::vector<PoolSizeRatio> &poolRatios);
@@ -82,6 +96,8 @@ struct DescriptorAllocatorGrowable
     std::vector<PoolSizeRatio> m_ratios;
     std::vector<VkDescriptorPool> m_fullPools;
     std::vector<VkDescriptorPool> m_readyPools;
-    uint32_t m_setsPerPool;
+    uint32_t m_setsPerPool = 0u;
+    uint32_t m_setsAllocated = 0u;
+    uint32_t m_exhaustionRetries = 0u;
 };
 //< descriptor_allocator_grow
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <vulkan/vulkan.h>
 #include <magic_enum.hpp>
 #include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
 
 
 // Stuff from vk_mem_alloc to avoid cyclical references
@@ -34,6 +35,27 @@ struct ComputePushConstants {
 //MAX bytes that we're able to pass to the GPU per shader
 static_assert(sizeof(ComputePushConstants) <= 128, "Compute shader data exceeds the size limit per shader (128 bytes)");
 
+/// @brief Per draw data of a RenderObject, vertices are fetched through the device address of the geometry pool and
+/// the material through its index in the bindless heap
+struct GPUDrawPushConstants {
+	glm::mat4 worldMatrix;
+	VkDeviceAddress vertexBuffer;
+	uint32_t materialIndex;
+	uint32_t padding;
+	/// @brief GpuDrawObject records of the indirect draws, 0 for draws recorded one by one. See VulkanGpuCuller
+	VkDeviceAddress drawObjects;
+	/// @brief The frame's GPUSceneData, the same for every draw of a frame
+	VkDeviceAddress sceneData;
+};
+
+static_assert(sizeof(GPUDrawPushConstants) <= 128, "Draw push constants exceed the size limit per shader (128 bytes)");
+
+/// @brief What every draw of a frame shares, written once per frame from the DrawContext. std430
+struct GPUSceneData {
+	/// @brief DrawContext::viewProjection, identity when it's unset so world matrices go straight to clip space
+	glm::mat4 viewProjection;
+};
+
 
 #ifndef HUSH_VULKAN_IMPL
 #define HUSH_VULKAN_IMPL
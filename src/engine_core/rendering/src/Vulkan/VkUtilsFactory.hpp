@@ -148,6 +148,26 @@ class VkUtilsFactory
         return colorAttachment;
     }
 
+    /// @param clearDepth cleared to it when set, loaded otherwise
+    static VkRenderingAttachmentInfo CreateDepthAttachmentInfo(
+        VkImageView view, const float *clearDepth, VkImageLayout layout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL)
+    {
+        VkRenderingAttachmentInfo depthAttachment{};
+        depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        depthAttachment.pNext = nullptr;
+
+        depthAttachment.imageView = view;
+        depthAttachment.imageLayout = layout;
+        depthAttachment.loadOp = clearDepth != nullptr ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        if (clearDepth != nullptr)
+        {
+            depthAttachment.clearValue.depthStencil.depth = *clearDepth;
+        }
+
+        return depthAttachment;
+    }
+
     static VkRenderingInfo CreateRenderingInfo(VkExtent2D renderExtent, VkRenderingAttachmentInfo *colorAttachment,
                                                VkRenderingAttachmentInfo *depthAttachment)
     {
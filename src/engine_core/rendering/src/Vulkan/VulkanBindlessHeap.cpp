@@ -0,0 +1,240 @@
+/*! \file VulkanBindlessHeap.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief One global descriptor set indexed by the shaders, instead of a set per object
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanBindlessHeap.hpp"
+#include "Logger.hpp"
+#include "VkTypes.hpp"
+
+#include <algorithm>
+#include <volk.h>
+
+/// @brief Binding and descriptor type of each EBindlessResource, in enum order
+static constexpr std::array<VkDescriptorType, 3> DESCRIPTOR_TYPES = {
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+static_assert(DESCRIPTOR_TYPES.size() == static_cast<size_t>(Hush::EBindlessResource::Count),
+              "Every bindless resource needs a descriptor type");
+
+void Hush::VulkanBindlessHeap::Init(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t sampledImageCapacity,
+                                    uint32_t samplerCapacity, uint32_t storageBufferCapacity)
+{
+    this->m_device = device;
+
+    VkPhysicalDeviceVulkan12Properties vulkan12Properties{};
+    vulkan12Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+    VkPhysicalDeviceProperties2 properties{};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &vulkan12Properties;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+    // Every stage may see the whole heap, so the per stage limits apply as well as the per set ones
+    std::array<uint32_t, static_cast<size_t>(EBindlessResource::Count)> capacities = {
+        std::min({sampledImageCapacity, vulkan12Properties.maxDescriptorSetUpdateAfterBindSampledImages,
+                  vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSampledImages}),
+        std::min({samplerCapacity, vulkan12Properties.maxDescriptorSetUpdateAfterBindSamplers,
+                  vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSamplers}),
+        std::min({storageBufferCapacity, vulkan12Properties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                  vulkan12Properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers}),
+    };
+
+    std::array<VkDescriptorSetLayoutBinding, static_cast<size_t>(EBindlessResource::Count)> bindings{};
+    std::array<VkDescriptorBindingFlags, static_cast<size_t>(EBindlessResource::Count)> bindingFlags{};
+    std::array<VkDescriptorPoolSize, static_cast<size_t>(EBindlessResource::Count)> poolSizes{};
+    for (size_t i = 0u; i < bindings.size(); i++)
+    {
+        this->m_tables[i] = SlotTable{};
+        this->m_tables[i].capacity = capacities[i];
+
+        bindings[i].binding = static_cast<uint32_t>(i);
+        bindings[i].descriptorType = DESCRIPTOR_TYPES[i];
+        bindings[i].descriptorCount = capacities[i];
+        bindings[i].stageFlags = VK_SHADER_STAGE_ALL;
+        // Slots that were never written are fine as long as the shaders don't read them, and slots can be written
+        // while frames that don't use them are still in flight
+        bindingFlags[i] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                          VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        poolSizes[i].type = DESCRIPTOR_TYPES[i];
+        poolSizes[i].descriptorCount = capacities[i];
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+    bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+    HUSH_VK_ASSERT(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &this->m_setLayout),
+                   "Bindless descriptor set layout creation failed!");
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.maxSets = 1u;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    HUSH_VK_ASSERT(vkCreateDescriptorPool(device, &poolInfo, nullptr, &this->m_pool),
+                   "Bindless descriptor pool creation failed!");
+
+    VkDescriptorSetAllocateInfo allocateInfo{};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool = this->m_pool;
+    allocateInfo.descriptorSetCount = 1u;
+    allocateInfo.pSetLayouts = &this->m_setLayout;
+    HUSH_VK_ASSERT(vkAllocateDescriptorSets(device, &allocateInfo, &this->m_set),
+                   "Bindless descriptor set allocation failed!");
+
+    LogFormat(ELogLevel::Debug, "Bindless heap holds {} images, {} samplers and {} storage buffers", capacities[0],
+              capacities[1], capacities[2]);
+}
+
+void Hush::VulkanBindlessHeap::Dispose() noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    if (this->m_device == nullptr)
+    {
+        return;
+    }
+    // The set goes away with its pool
+    vkDestroyDescriptorPool(this->m_device, this->m_pool, nullptr);
+    vkDestroyDescriptorSetLayout(this->m_device, this->m_setLayout, nullptr);
+    this->m_pool = nullptr;
+    this->m_setLayout = nullptr;
+    this->m_set = nullptr;
+    this->m_tables = {};
+    this->m_pendingReleases.clear();
+    this->m_device = nullptr;
+}
+
+uint32_t Hush::VulkanBindlessHeap::RegisterImage(VkImageView imageView, VkImageLayout layout)
+{
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.imageView = imageView;
+    imageInfo.imageLayout = layout;
+    return this->Register(EBindlessResource::SampledImage, &imageInfo, nullptr);
+}
+
+uint32_t Hush::VulkanBindlessHeap::RegisterSampler(VkSampler sampler)
+{
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.sampler = sampler;
+    return this->Register(EBindlessResource::Sampler, &imageInfo, nullptr);
+}
+
+uint32_t Hush::VulkanBindlessHeap::RegisterBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+{
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = buffer;
+    bufferInfo.offset = offset;
+    bufferInfo.range = range;
+    return this->Register(EBindlessResource::StorageBuffer, nullptr, &bufferInfo);
+}
+
+void Hush::VulkanBindlessHeap::Release(EBindlessResource resource, uint32_t index, uint64_t retireValue)
+{
+    if (index == INVALID_INDEX)
+    {
+        return;
+    }
+    std::lock_guard lock(this->m_mutex);
+    HUSH_ASSERT(index < this->GetTable(resource).nextSlot, "Releasing bindless slot {} that was never registered",
+                index);
+    HUSH_ASSERT(this->m_pendingReleases.empty() || this->m_pendingReleases.back().retireValue <= retireValue,
+                "Bindless heap retire values must not decrease ({} after {})", retireValue,
+                this->m_pendingReleases.back().retireValue);
+    this->m_pendingReleases.push_back({resource, index, retireValue});
+}
+
+void Hush::VulkanBindlessHeap::Retire(uint64_t completedValue)
+{
+    std::lock_guard lock(this->m_mutex);
+    size_t count = 0u;
+    while (count < this->m_pendingReleases.size() && this->m_pendingReleases[count].retireValue <= completedValue)
+    {
+        const PendingRelease &pendingRelease = this->m_pendingReleases[count];
+        this->GetTable(pendingRelease.resource).freeSlots.push_back(pendingRelease.index);
+        count++;
+    }
+    this->m_pendingReleases.erase(this->m_pendingReleases.begin(),
+                                  this->m_pendingReleases.begin() + static_cast<ptrdiff_t>(count));
+}
+
+void Hush::VulkanBindlessHeap::Bind(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout,
+                                    uint32_t firstSet) const noexcept
+{
+    vkCmdBindDescriptorSets(cmd, bindPoint, layout, firstSet, 1u, &this->m_set, 0u, nullptr);
+}
+
+VkDescriptorSetLayout Hush::VulkanBindlessHeap::GetSetLayout() const noexcept
+{
+    return this->m_setLayout;
+}
+
+VkDescriptorSet Hush::VulkanBindlessHeap::GetSet() const noexcept
+{
+    return this->m_set;
+}
+
+Hush::VulkanBindlessHeap::Stats Hush::VulkanBindlessHeap::GetStats() const noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    Stats stats{};
+    for (size_t i = 0u; i < this->m_tables.size(); i++)
+    {
+        const SlotTable &table = this->m_tables[i];
+        stats.capacity[i] = table.capacity;
+        // Released slots count as used until they retire
+        stats.used[i] = table.nextSlot - static_cast<uint32_t>(table.freeSlots.size());
+    }
+    return stats;
+}
+
+uint32_t Hush::VulkanBindlessHeap::Register(EBindlessResource resource, const VkDescriptorImageInfo *imageInfo,
+                                            const VkDescriptorBufferInfo *bufferInfo)
+{
+    std::lock_guard lock(this->m_mutex);
+    SlotTable &table = this->GetTable(resource);
+    uint32_t index = INVALID_INDEX;
+    if (!table.freeSlots.empty())
+    {
+        index = table.freeSlots.back();
+        table.freeSlots.pop_back();
+    }
+    else if (table.nextSlot < table.capacity)
+    {
+        index = table.nextSlot++;
+    }
+    else
+    {
+        LogFormat(ELogLevel::Error, "Bindless heap is out of {} slots, all {} are in use",
+                  magic_enum::enum_name(resource), table.capacity);
+        return INVALID_INDEX;
+    }
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = this->m_set;
+    write.dstBinding = static_cast<uint32_t>(resource);
+    write.dstArrayElement = index;
+    write.descriptorCount = 1u;
+    write.descriptorType = DESCRIPTOR_TYPES[static_cast<size_t>(resource)];
+    write.pImageInfo = imageInfo;
+    write.pBufferInfo = bufferInfo;
+    vkUpdateDescriptorSets(this->m_device, 1u, &write, 0u, nullptr);
+    return index;
+}
+
+Hush::VulkanBindlessHeap::SlotTable &Hush::VulkanBindlessHeap::GetTable(EBindlessResource resource) noexcept
+{
+    return this->m_tables[static_cast<size_t>(resource)];
+}
@@ -0,0 +1,115 @@
+/*! \file VulkanBindlessHeap.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief One global descriptor set indexed by the shaders, instead of a set per object
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    /// @brief Each kind of resource is an array on its own binding of the heap's set, see res/bindless.glsl
+    enum class EBindlessResource : uint8_t
+    {
+        /// @brief VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, binding 0
+        SampledImage,
+        /// @brief VK_DESCRIPTOR_TYPE_SAMPLER, binding 1
+        Sampler,
+        /// @brief VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, binding 2
+        StorageBuffer,
+        Count
+    };
+
+    /// @brief A single update after bind, partially bound descriptor set holding an array per EBindlessResource.
+    /// Registering a resource writes it to a free slot and returns the slot's index, which stays valid until the
+    /// resource is released. Materials and draws pass those indices through push constants or buffers, so the set is
+    /// bound once per frame and nothing is rebound between draws.
+    /// Released slots are only reused once the GPU is done with the frames that may read them (see Release and
+    /// Retire). Thread safe
+    class VulkanBindlessHeap
+    {
+      public:
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+        static constexpr uint32_t DEFAULT_SAMPLED_IMAGE_CAPACITY = 16384u;
+        static constexpr uint32_t DEFAULT_SAMPLER_CAPACITY = 256u;
+        static constexpr uint32_t DEFAULT_STORAGE_BUFFER_CAPACITY = 16384u;
+
+        struct Stats
+        {
+            std::array<uint32_t, static_cast<size_t>(EBindlessResource::Count)> capacity{};
+            std::array<uint32_t, static_cast<size_t>(EBindlessResource::Count)> used{};
+        };
+
+        /// @brief Capacities are clamped to the device's update after bind limits
+        void Init(VkDevice device, VkPhysicalDevice physicalDevice,
+                  uint32_t sampledImageCapacity = DEFAULT_SAMPLED_IMAGE_CAPACITY,
+                  uint32_t samplerCapacity = DEFAULT_SAMPLER_CAPACITY,
+                  uint32_t storageBufferCapacity = DEFAULT_STORAGE_BUFFER_CAPACITY);
+
+        /// @brief Destroys the set, its layout and its pool right away, the GPU must be idle
+        void Dispose() noexcept;
+
+        /// @return INVALID_INDEX if every slot is taken
+        uint32_t RegisterImage(VkImageView imageView, VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+        /// @return INVALID_INDEX if every slot is taken
+        uint32_t RegisterSampler(VkSampler sampler);
+
+        /// @return INVALID_INDEX if every slot is taken
+        uint32_t RegisterBuffer(VkBuffer buffer, VkDeviceSize offset = 0u, VkDeviceSize range = VK_WHOLE_SIZE);
+
+        /// @brief Frees the slot once Retire sees retireValue completed, the descriptor is left as is until then
+        void Release(EBindlessResource resource, uint32_t index, uint64_t retireValue);
+
+        /// @brief Frees the slots released with a retire value <= completedValue
+        void Retire(uint64_t completedValue);
+
+        /// @brief Binds the heap's set at firstSet, layout must have been created with GetSetLayout at that index
+        void Bind(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout,
+                  uint32_t firstSet = 0u) const noexcept;
+
+        [[nodiscard]] VkDescriptorSetLayout GetSetLayout() const noexcept;
+
+        [[nodiscard]] VkDescriptorSet GetSet() const noexcept;
+
+        [[nodiscard]] Stats GetStats() const noexcept;
+
+      private:
+        struct SlotTable
+        {
+            uint32_t capacity = 0u;
+            /// @brief Slots at or above it have never been handed out
+            uint32_t nextSlot = 0u;
+            std::vector<uint32_t> freeSlots;
+        };
+
+        struct PendingRelease
+        {
+            EBindlessResource resource;
+            uint32_t index;
+            uint64_t retireValue;
+        };
+
+        /// @brief Takes a slot and writes descriptor to it, the caller fills the info matching the resource
+        uint32_t Register(EBindlessResource resource, const VkDescriptorImageInfo *imageInfo,
+                          const VkDescriptorBufferInfo *bufferInfo);
+
+        SlotTable &GetTable(EBindlessResource resource) noexcept;
+
+        VkDevice m_device = nullptr;
+        VkDescriptorSetLayout m_setLayout = nullptr;
+        VkDescriptorPool m_pool = nullptr;
+        VkDescriptorSet m_set = nullptr;
+
+        std::array<SlotTable, static_cast<size_t>(EBindlessResource::Count)> m_tables{};
+        /// @brief Ordered by retire value
+        std::vector<PendingRelease> m_pendingReleases;
+        mutable std::mutex m_mutex;
+    };
+} // namespace Hush
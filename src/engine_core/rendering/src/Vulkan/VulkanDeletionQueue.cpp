@@ -0,0 +1,133 @@
+/*! \file VulkanDeletionQueue.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Deferred destruction of Vulkan handles, retired once the GPU is done with them
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanDeletionQueue.hpp"
+#include "vk_mem_alloc.hpp"
+#include <volk.h>
+
+void Hush::VulkanDeletionQueue::Push(VkImageView imageView, uint64_t retireValue)
+{
+    this->m_imageViews.Push(imageView, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkImage image, VmaAllocation allocation, uint64_t retireValue)
+{
+    this->m_images.Push({image, allocation}, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkBuffer buffer, VmaAllocation allocation, uint64_t retireValue)
+{
+    this->m_buffers.Push({buffer, allocation}, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkPipeline pipeline, uint64_t retireValue)
+{
+    this->m_pipelines.Push(pipeline, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkPipelineLayout pipelineLayout, uint64_t retireValue)
+{
+    this->m_pipelineLayouts.Push(pipelineLayout, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkDescriptorPool descriptorPool, uint64_t retireValue)
+{
+    this->m_descriptorPools.Push(descriptorPool, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkDescriptorSetLayout descriptorSetLayout, uint64_t retireValue)
+{
+    this->m_descriptorSetLayouts.Push(descriptorSetLayout, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkSampler sampler, uint64_t retireValue)
+{
+    this->m_samplers.Push(sampler, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkShaderModule shaderModule, uint64_t retireValue)
+{
+    this->m_shaderModules.Push(shaderModule, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkFence fence, uint64_t retireValue)
+{
+    this->m_fences.Push(fence, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkSemaphore semaphore, uint64_t retireValue)
+{
+    this->m_semaphores.Push(semaphore, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkCommandPool commandPool, uint64_t retireValue)
+{
+    this->m_commandPools.Push(commandPool, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Push(VkQueryPool queryPool, uint64_t retireValue)
+{
+    this->m_queryPools.Push(queryPool, retireValue);
+}
+
+void Hush::VulkanDeletionQueue::Retire(VkDevice device, VmaAllocator allocator, uint64_t completedValue) noexcept
+{
+    // Views and pipelines go before the images and layouts they were made from
+    this->m_imageViews.Retire(completedValue, [device](VkImageView imageView) {
+        vkDestroyImageView(device, imageView, nullptr);
+    });
+    this->m_images.Retire(completedValue, [allocator](const AllocatedHandle<VkImage> &image) {
+        vmaDestroyImage(allocator, image.handle, image.allocation);
+    });
+    this->m_buffers.Retire(completedValue, [allocator](const AllocatedHandle<VkBuffer> &buffer) {
+        vmaDestroyBuffer(allocator, buffer.handle, buffer.allocation);
+    });
+    this->m_pipelines.Retire(completedValue, [device](VkPipeline pipeline) {
+        vkDestroyPipeline(device, pipeline, nullptr);
+    });
+    this->m_pipelineLayouts.Retire(completedValue, [device](VkPipelineLayout pipelineLayout) {
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    });
+    this->m_descriptorPools.Retire(completedValue, [device](VkDescriptorPool descriptorPool) {
+        vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    });
+    this->m_descriptorSetLayouts.Retire(completedValue, [device](VkDescriptorSetLayout descriptorSetLayout) {
+        vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+    });
+    this->m_samplers.Retire(completedValue, [device](VkSampler sampler) {
+        vkDestroySampler(device, sampler, nullptr);
+    });
+    this->m_shaderModules.Retire(completedValue, [device](VkShaderModule shaderModule) {
+        vkDestroyShaderModule(device, shaderModule, nullptr);
+    });
+    this->m_fences.Retire(completedValue, [device](VkFence fence) {
+        vkDestroyFence(device, fence, nullptr);
+    });
+    this->m_semaphores.Retire(completedValue, [device](VkSemaphore semaphore) {
+        vkDestroySemaphore(device, semaphore, nullptr);
+    });
+    this->m_commandPools.Retire(completedValue, [device](VkCommandPool commandPool) {
+        vkDestroyCommandPool(device, commandPool, nullptr);
+    });
+    this->m_queryPools.Retire(completedValue, [device](VkQueryPool queryPool) {
+        vkDestroyQueryPool(device, queryPool, nullptr);
+    });
+}
+
+void Hush::VulkanDeletionQueue::Flush(VkDevice device, VmaAllocator allocator) noexcept
+{
+    this->Retire(device, allocator, UINT64_MAX);
+}
+
+size_t Hush::VulkanDeletionQueue::GetPendingCount() const noexcept
+{
+    return this->m_imageViews.GetSize() + this->m_images.GetSize() + this->m_buffers.GetSize() +
+           this->m_pipelines.GetSize() + this->m_pipelineLayouts.GetSize() + this->m_descriptorPools.GetSize() +
+           this->m_descriptorSetLayouts.GetSize() + this->m_samplers.GetSize() + this->m_shaderModules.GetSize() +
+           this->m_fences.GetSize() + this->m_semaphores.GetSize() + this->m_commandPools.GetSize() +
+           this->m_queryPools.GetSize();
+}
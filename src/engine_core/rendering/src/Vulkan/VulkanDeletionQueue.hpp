@@ -1,30 +1,116 @@
 /*! \file VulkanDeletionQueue.hpp
     \author Kyn21kx
     \date 2024-05-20
-    \brief Deletion queue struct
+    \brief Deferred destruction of Vulkan handles, retired once the GPU is done with them
 */
 
 #pragma once
-#include <deque>
-#include <functional>
+#include "Assertions.hpp"
 
-struct VulkanDeletionQueue
-{
-    std::deque<std::function<void()>> deletors;
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
 
-    void PushFunction(std::function<void()> &&function)
-    {
-        deletors.push_back(function);
-    }
+struct VmaAllocator_T;
+using VmaAllocator = VmaAllocator_T *;
+struct VmaAllocation_T;
+using VmaAllocation = VmaAllocation_T *;
 
-    void Flush()
+// The Push overloads tell handles apart by type, which only works where non dispatchable handles are pointers
+static_assert(sizeof(void *) == 8, "VulkanDeletionQueue needs typed Vulkan handles (64 bit builds)");
+
+namespace Hush
+{
+    /// @brief Handles waiting to be destroyed, stored in one contiguous array per handle type.
+    /// Every handle is tagged with a retire value (a frame number or a timeline semaphore value) and destroyed once
+    /// the GPU reports that value as completed. Retire values must be pushed in non decreasing order, so retiring
+    /// only ever pops a prefix of each array. Once the arrays reach their working size nothing allocates
+    class VulkanDeletionQueue
     {
-        // reverse iterate the deletion queue to execute all the functions
-        for (auto it = deletors.rbegin(); it != deletors.rend(); it++)
+      public:
+        void Push(VkImageView imageView, uint64_t retireValue = 0u);
+        void Push(VkImage image, VmaAllocation allocation, uint64_t retireValue = 0u);
+        void Push(VkBuffer buffer, VmaAllocation allocation, uint64_t retireValue = 0u);
+        void Push(VkPipeline pipeline, uint64_t retireValue = 0u);
+        void Push(VkPipelineLayout pipelineLayout, uint64_t retireValue = 0u);
+        void Push(VkDescriptorPool descriptorPool, uint64_t retireValue = 0u);
+        void Push(VkDescriptorSetLayout descriptorSetLayout, uint64_t retireValue = 0u);
+        void Push(VkSampler sampler, uint64_t retireValue = 0u);
+        void Push(VkShaderModule shaderModule, uint64_t retireValue = 0u);
+        void Push(VkFence fence, uint64_t retireValue = 0u);
+        void Push(VkSemaphore semaphore, uint64_t retireValue = 0u);
+        void Push(VkCommandPool commandPool, uint64_t retireValue = 0u);
+        void Push(VkQueryPool queryPool, uint64_t retireValue = 0u);
+
+        /// @brief Destroys every handle whose retire value is <= completedValue. Types are destroyed in dependency
+        /// order (views before images, pipelines before their layouts...)
+        void Retire(VkDevice device, VmaAllocator allocator, uint64_t completedValue) noexcept;
+
+        /// @brief Destroys everything, the device must be idle
+        void Flush(VkDevice device, VmaAllocator allocator) noexcept;
+
+        [[nodiscard]] size_t GetPendingCount() const noexcept;
+
+      private:
+        template <class T> struct Entry
         {
-            (*it)(); // call functors
-        }
+            T handle;
+            uint64_t retireValue;
+        };
+
+        /// @brief Resources created through VMA, destroyed along with their memory
+        template <class T> struct AllocatedHandle
+        {
+            T handle;
+            VmaAllocation allocation;
+        };
+
+        /// @brief FIFO of one handle type, ordered by retire value
+        template <class T> class HandleList
+        {
+          public:
+            void Push(const T &handle, uint64_t retireValue)
+            {
+                HUSH_ASSERT(this->m_entries.empty() || this->m_entries.back().retireValue <= retireValue,
+                            "Deletion queue retire values must not decrease ({} after {})", retireValue,
+                            this->m_entries.back().retireValue);
+                this->m_entries.push_back({handle, retireValue});
+            }
+
+            template <class F> void Retire(uint64_t completedValue, F &&destroy) noexcept
+            {
+                size_t count = 0u;
+                while (count < this->m_entries.size() && this->m_entries[count].retireValue <= completedValue)
+                {
+                    destroy(this->m_entries[count].handle);
+                    count++;
+                }
+                // Shifts the survivors down, the capacity is kept so pushing them again doesn't allocate
+                auto retiredEnd = this->m_entries.begin() + static_cast<ptrdiff_t>(count);
+                this->m_entries.erase(this->m_entries.begin(), retiredEnd);
+            }
+
+            [[nodiscard]] size_t GetSize() const noexcept
+            {
+                return this->m_entries.size();
+            }
+
+          private:
+            std::vector<Entry<T>> m_entries;
+        };
 
-        deletors.clear();
-    }
-};
\ No newline at end of file
+        HandleList<VkImageView> m_imageViews;
+        HandleList<AllocatedHandle<VkImage>> m_images;
+        HandleList<AllocatedHandle<VkBuffer>> m_buffers;
+        HandleList<VkPipeline> m_pipelines;
+        HandleList<VkPipelineLayout> m_pipelineLayouts;
+        HandleList<VkDescriptorPool> m_descriptorPools;
+        HandleList<VkDescriptorSetLayout> m_descriptorSetLayouts;
+        HandleList<VkSampler> m_samplers;
+        HandleList<VkShaderModule> m_shaderModules;
+        HandleList<VkFence> m_fences;
+        HandleList<VkSemaphore> m_semaphores;
+        HandleList<VkCommandPool> m_commandPools;
+        HandleList<VkQueryPool> m_queryPools;
+    };
+} // namespace Hush
@@ -0,0 +1,206 @@
+/*! \file VulkanDepthPyramid.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Hierarchical depth (Hi-Z) mip chain reduced from the depth image, what occlusion culling tests against
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanDepthPyramid.hpp"
+#include "Profiler.hpp"
+#include "VkUtilsFactory.hpp"
+#include "VulkanDeletionQueue.hpp"
+
+#include <algorithm>
+#include <volk.h>
+
+void Hush::VulkanDepthPyramid::Init(VkDevice device, VmaAllocator allocator, VkPipeline pipeline,
+                                    VkPipelineLayout layout, VkDescriptorSetLayout setLayout)
+{
+    this->m_device = device;
+    this->m_allocator = allocator;
+    this->m_pipeline = pipeline;
+    this->m_layout = layout;
+    this->m_setLayout = setLayout;
+
+    // Texels are fetched, never filtered, the edge clamp only matters to shaders that sample it
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_NEAREST;
+    samplerInfo.minFilter = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+    HUSH_VK_ASSERT(vkCreateSampler(device, &samplerInfo, nullptr, &this->m_sampler),
+                   "Depth pyramid sampler creation failed!");
+}
+
+void Hush::VulkanDepthPyramid::Dispose() noexcept
+{
+    this->DestroyImage(nullptr, 0u);
+    if (this->m_sampler != nullptr)
+    {
+        vkDestroySampler(this->m_device, this->m_sampler, nullptr);
+        this->m_sampler = nullptr;
+    }
+    this->m_pipeline = nullptr;
+    this->m_layout = nullptr;
+}
+
+bool Hush::VulkanDepthPyramid::IsAvailable() const noexcept
+{
+    return this->m_pipeline != nullptr;
+}
+
+bool Hush::VulkanDepthPyramid::Resize(VkExtent2D depthExtent, VulkanDeletionQueue &deletionQueue,
+                                      uint64_t retireValue)
+{
+    if (this->m_image.image != nullptr && this->m_depthExtent.width == depthExtent.width &&
+        this->m_depthExtent.height == depthExtent.height)
+    {
+        return false;
+    }
+    this->DestroyImage(&deletionQueue, retireValue);
+    this->m_depthExtent = depthExtent;
+
+    VkExtent3D extent = {std::max(depthExtent.width / 2u, 1u), std::max(depthExtent.height / 2u, 1u), 1u};
+    uint32_t largestSide = std::max(extent.width, extent.height);
+    this->m_levelCount = 1u;
+    while ((largestSide >> this->m_levelCount) > 0u && this->m_levelCount < MAX_LEVELS)
+    {
+        this->m_levelCount++;
+    }
+
+    this->m_image.imageFormat = FORMAT;
+    this->m_image.imageExtent = extent;
+    VkImageCreateInfo imageInfo = VkUtilsFactory::CreateImageCreateInfo(
+        FORMAT, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT, extent);
+    imageInfo.mipLevels = this->m_levelCount;
+    VmaAllocationCreateInfo allocationInfo = {};
+    allocationInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    allocationInfo.requiredFlags = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    HUSH_VK_ASSERT(vmaCreateImage(this->m_allocator, &imageInfo, &allocationInfo, &this->m_image.image,
+                                  &this->m_image.allocation, nullptr),
+                   "Depth pyramid creation failed!");
+
+    VkImageViewCreateInfo viewInfo =
+        VkUtilsFactory::CreateImageViewCreateInfo(FORMAT, this->m_image.image, VK_IMAGE_ASPECT_COLOR_BIT);
+    viewInfo.subresourceRange.levelCount = this->m_levelCount;
+    HUSH_VK_ASSERT(vkCreateImageView(this->m_device, &viewInfo, nullptr, &this->m_image.imageView),
+                   "Depth pyramid view creation failed!");
+    viewInfo.subresourceRange.levelCount = 1u;
+    for (uint32_t level = 0; level < this->m_levelCount; level++)
+    {
+        viewInfo.subresourceRange.baseMipLevel = level;
+        HUSH_VK_ASSERT(vkCreateImageView(this->m_device, &viewInfo, nullptr, &this->m_levelViews[level]),
+                       "Depth pyramid level view creation failed!");
+    }
+    return true;
+}
+
+void Hush::VulkanDepthPyramid::RecordBuild(VkCommandBuffer cmd, VkImageView depthView,
+                                           DescriptorAllocatorGrowable &frameDescriptors)
+{
+    HUSH_PROFILE_SCOPE("VulkanDepthPyramid::RecordBuild");
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, this->m_pipeline);
+
+    // Every level waits for the one below, the whole chain stays in GENERAL so a memory barrier is enough
+    VkMemoryBarrier2 levelBarrier{};
+    levelBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    levelBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    levelBarrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    levelBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    levelBarrier.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1u;
+    dependencyInfo.pMemoryBarriers = &levelBarrier;
+
+    for (uint32_t level = 0; level < this->m_levelCount; level++)
+    {
+        if (level > 0u)
+        {
+            vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+        }
+        VkDescriptorSet set = frameDescriptors.Allocate(this->m_device, this->m_setLayout);
+        this->m_writer.Clear();
+        if (level == 0u)
+        {
+            this->m_writer.WriteImage(0, depthView, this->m_sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+        }
+        else
+        {
+            this->m_writer.WriteImage(0, this->m_levelViews[level - 1u], this->m_sampler, VK_IMAGE_LAYOUT_GENERAL,
+                                      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+        }
+        this->m_writer.WriteImage(1, this->m_levelViews[level], nullptr, VK_IMAGE_LAYOUT_GENERAL,
+                                  VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+        this->m_writer.UpdateSet(this->m_device, set);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, this->m_layout, 0, 1, &set, 0, nullptr);
+
+        uint32_t width = std::max(this->m_image.imageExtent.width >> level, 1u);
+        uint32_t height = std::max(this->m_image.imageExtent.height >> level, 1u);
+        uint32_t groupsX = (width + WORKGROUP_SIZE - 1u) / WORKGROUP_SIZE;
+        uint32_t groupsY = (height + WORKGROUP_SIZE - 1u) / WORKGROUP_SIZE;
+        vkCmdDispatch(cmd, groupsX, groupsY, 1u);
+    }
+}
+
+VkImage Hush::VulkanDepthPyramid::GetImage() const noexcept
+{
+    return this->m_image.image;
+}
+
+VkImageView Hush::VulkanDepthPyramid::GetImageView() const noexcept
+{
+    return this->m_image.imageView;
+}
+
+VkSampler Hush::VulkanDepthPyramid::GetSampler() const noexcept
+{
+    return this->m_sampler;
+}
+
+uint32_t Hush::VulkanDepthPyramid::GetLevelCount() const noexcept
+{
+    return this->m_levelCount;
+}
+
+VkExtent2D Hush::VulkanDepthPyramid::GetDepthExtent() const noexcept
+{
+    return this->m_depthExtent;
+}
+
+void Hush::VulkanDepthPyramid::DestroyImage(VulkanDeletionQueue *deletionQueue, uint64_t retireValue) noexcept
+{
+    if (this->m_image.image == nullptr)
+    {
+        return;
+    }
+    for (uint32_t level = 0; level < this->m_levelCount; level++)
+    {
+        if (deletionQueue != nullptr)
+        {
+            deletionQueue->Push(this->m_levelViews[level], retireValue);
+        }
+        else
+        {
+            vkDestroyImageView(this->m_device, this->m_levelViews[level], nullptr);
+        }
+        this->m_levelViews[level] = nullptr;
+    }
+    if (deletionQueue != nullptr)
+    {
+        deletionQueue->Push(this->m_image.imageView, retireValue);
+        deletionQueue->Push(this->m_image.image, this->m_image.allocation, retireValue);
+    }
+    else
+    {
+        vkDestroyImageView(this->m_device, this->m_image.imageView, nullptr);
+        vmaDestroyImage(this->m_allocator, this->m_image.image, this->m_image.allocation);
+    }
+    this->m_image = {};
+    this->m_levelCount = 0u;
+}
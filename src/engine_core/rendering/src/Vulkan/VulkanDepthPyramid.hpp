@@ -0,0 +1,88 @@
+/*! \file VulkanDepthPyramid.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Hierarchical depth (Hi-Z) mip chain reduced from the depth image, what occlusion culling tests against
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include "VkDescriptors.hpp"
+#include "VkTypes.hpp"
+#include "vk_mem_alloc.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    class VulkanDeletionQueue;
+
+    /// @brief R32 mip chain where each texel holds the farthest depth of the texels below it, reversed depth so the
+    /// smallest value. Level 0 is half the depth image, and every level halves the one before (rounded down) until
+    /// 1x1. The last texel of a row or column also covers the odd one left by the rounding, so a depth pixel p is
+    /// always inside texel min(p >> (level + 1), size - 1) of a level. That's what gpu_cull.comp relies on to find the
+    /// at most 2x2 texels of a level that cover an object's screen rectangle.
+    /// RecordBuild runs depth_pyramid.comp once per level, each level reads the previous one
+    class VulkanDepthPyramid
+    {
+      public:
+        static constexpr VkFormat FORMAT = VK_FORMAT_R32_SFLOAT;
+        /// @brief Enough for a 65536 pixel wide depth image
+        static constexpr uint32_t MAX_LEVELS = 16u;
+        static constexpr uint32_t WORKGROUP_SIZE = 8u;
+
+        /// @param pipeline depth_pyramid.comp, built and owned by the renderer along with its layout
+        /// @param setLayout set 0 of layout: the source at binding 0 (combined image sampler) and the level written at
+        /// binding 1 (storage image)
+        void Init(VkDevice device, VmaAllocator allocator, VkPipeline pipeline, VkPipelineLayout layout,
+                  VkDescriptorSetLayout setLayout);
+
+        /// @brief Destroys the image, its views and the sampler right away, the GPU must be idle
+        void Dispose() noexcept;
+
+        /// @brief False when the reduction shader couldn't be built, occlusion culling is off then
+        [[nodiscard]] bool IsAvailable() const noexcept;
+
+        /// @brief Recreates the pyramid for a depth image of that size, the old image and views are destroyed once
+        /// retireValue completes
+        /// @return Whether it changed, views taken from it before (e.g. in the bindless heap) have to be replaced then
+        bool Resize(VkExtent2D depthExtent, VulkanDeletionQueue &deletionQueue, uint64_t retireValue);
+
+        /// @brief Reduces every level. The depth image has to be in SHADER_READ_ONLY_OPTIMAL and the pyramid in
+        /// GENERAL, the levels are left there too
+        /// @param frameDescriptors the sets of each level are allocated from it, they're only used by this frame
+        void RecordBuild(VkCommandBuffer cmd, VkImageView depthView, DescriptorAllocatorGrowable &frameDescriptors);
+
+        [[nodiscard]] VkImage GetImage() const noexcept;
+
+        /// @brief Every level, for sampling with texelFetch
+        [[nodiscard]] VkImageView GetImageView() const noexcept;
+
+        /// @brief Nearest, clamped to the edge
+        [[nodiscard]] VkSampler GetSampler() const noexcept;
+
+        [[nodiscard]] uint32_t GetLevelCount() const noexcept;
+
+        /// @brief Of the depth image the pyramid was built for, not of level 0
+        [[nodiscard]] VkExtent2D GetDepthExtent() const noexcept;
+
+      private:
+        void DestroyImage(VulkanDeletionQueue *deletionQueue, uint64_t retireValue) noexcept;
+
+        VkDevice m_device = nullptr;
+        VmaAllocator m_allocator = nullptr;
+        VkPipeline m_pipeline = nullptr;
+        VkPipelineLayout m_layout = nullptr;
+        VkDescriptorSetLayout m_setLayout = nullptr;
+        VkSampler m_sampler = nullptr;
+
+        AllocatedImage m_image{};
+        /// @brief One per level, written as storage images and read by the next level
+        std::array<VkImageView, MAX_LEVELS> m_levelViews{};
+        uint32_t m_levelCount = 0u;
+        VkExtent2D m_depthExtent{};
+        /// @brief Reused by every RecordBuild
+        DescriptorWriter m_writer;
+    };
+} // namespace Hush
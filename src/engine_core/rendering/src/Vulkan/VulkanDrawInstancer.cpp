@@ -0,0 +1,180 @@
+/*! \file VulkanDrawInstancer.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Merges the CPU recorded draws of the same mesh and material into instanced draws
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanDrawInstancer.hpp"
+#include "Assertions.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <volk.h>
+
+namespace
+{
+    constexpr VkBufferUsageFlags RECORD_USAGE =
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+    bool SharesState(const RenderObject &object, const RenderObject &other) noexcept
+    {
+        return object.material->pipeline == other.material->pipeline &&
+               object.material->materialSet == other.material->materialSet;
+    }
+} // namespace
+
+size_t Hush::VulkanDrawInstancer::MeshKeyHash::operator()(const MeshKey &key) const noexcept
+{
+    size_t hash = std::hash<uint32_t>{}(key.firstIndex);
+    hash ^= std::hash<uint32_t>{}(key.indexCount) + 0x9e3779b97f4a7c15ull + (hash << 6u) + (hash >> 2u);
+    return hash ^ (std::hash<int32_t>{}(key.vertexOffset) + 0x9e3779b97f4a7c15ull + (hash << 6u) + (hash >> 2u));
+}
+
+void Hush::VulkanDrawInstancer::Init(VmaAllocator allocator, uint32_t frameCount)
+{
+    this->m_allocator = allocator;
+    this->m_frames.clear();
+    this->m_frames.resize(frameCount);
+}
+
+void Hush::VulkanDrawInstancer::Dispose() noexcept
+{
+    for (FrameResources &resources : this->m_frames)
+    {
+        resources.records.Destroy();
+    }
+    this->m_frames.clear();
+}
+
+bool Hush::VulkanDrawInstancer::Accepts(const RenderObject &object) noexcept
+{
+    return object.material != nullptr && object.material->pipeline != nullptr &&
+           object.material->materialSet == nullptr;
+}
+
+void Hush::VulkanDrawInstancer::BeginFrame(uint32_t frame, uint32_t maxInstances)
+{
+    FrameResources &resources = this->m_frames.at(frame);
+    resources.recordCount = 0u;
+    if (maxInstances <= resources.capacity)
+    {
+        return;
+    }
+    // The frame's last submission is done, nothing reads the old buffer anymore
+    resources.capacity = std::max(maxInstances, 2u * resources.capacity);
+    resources.records.Destroy();
+    resources.records = VulkanVertexBuffer(resources.capacity * sizeof(GpuDrawObject), RECORD_USAGE,
+                                           VMA_MEMORY_USAGE_AUTO, this->m_allocator,
+                                           VulkanVertexBuffer::MAPPED_ALLOCATION_FLAGS);
+}
+
+void Hush::VulkanDrawInstancer::Build(uint32_t frame, const std::vector<RenderObject> &objects,
+                                      const std::vector<uint32_t> &indices, EDrawOrder order,
+                                      std::vector<InstancedDraw> &draws)
+{
+    HUSH_PROFILE_SCOPE("VulkanDrawInstancer::Build");
+    FrameResources &resources = this->m_frames.at(frame);
+    uint32_t firstRecord = resources.recordCount;
+    draws.clear();
+
+    auto count = static_cast<uint32_t>(indices.size());
+    uint32_t begin = 0u;
+    while (begin < count)
+    {
+        // Sorted by state, the objects of a pipeline and set come in a row. Transparent ones only take the same mesh
+        const RenderObject &first = objects[indices[begin]];
+        uint32_t end = begin + 1u;
+        if (Accepts(first))
+        {
+            MeshKey mesh{first.firstIndex, first.indexCount, first.vertexOffset};
+            for (; end < count; end++)
+            {
+                const RenderObject &object = objects[indices[end]];
+                if (!Accepts(object) || !SharesState(object, first) ||
+                    (order == EDrawOrder::BackToFront &&
+                     !(MeshKey{object.firstIndex, object.indexCount, object.vertexOffset} == mesh)))
+                {
+                    break;
+                }
+            }
+        }
+        this->BuildRun(resources, objects, indices, begin, end, draws);
+        begin = end;
+    }
+
+    if (resources.recordCount > firstRecord)
+    {
+        HUSH_VK_ASSERT(vmaFlushAllocation(this->m_allocator, resources.records.GetAllocation(),
+                                          firstRecord * sizeof(GpuDrawObject),
+                                          (resources.recordCount - firstRecord) * sizeof(GpuDrawObject)),
+                       "Instance record flush failed!");
+    }
+}
+
+VkDeviceAddress Hush::VulkanDrawInstancer::GetRecordsAddress(uint32_t frame) const noexcept
+{
+    return this->m_frames[frame].records.GetDeviceAddress();
+}
+
+void Hush::VulkanDrawInstancer::BuildRun(FrameResources &resources, const std::vector<RenderObject> &objects,
+                                         const std::vector<uint32_t> &indices, uint32_t begin, uint32_t end,
+                                         std::vector<InstancedDraw> &draws)
+{
+    uint32_t length = end - begin;
+    // BeginFrame's room should cover every run, past it the objects are drawn one by one
+    if (length == 1u || resources.recordCount + length > resources.capacity)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            draws.push_back({indices[i], 1u, NO_RECORDS});
+        }
+        return;
+    }
+
+    this->m_meshLookup.clear();
+    this->m_runDraws.clear();
+    this->m_runObjectDraws.resize(length);
+    for (uint32_t i = begin; i < end; i++)
+    {
+        const RenderObject &object = objects[indices[i]];
+        MeshKey mesh{object.firstIndex, object.indexCount, object.vertexOffset};
+        auto [found, inserted] = this->m_meshLookup.emplace(mesh, static_cast<uint32_t>(this->m_runDraws.size()));
+        if (inserted)
+        {
+            this->m_runDraws.push_back({indices[i], 0u, NO_RECORDS});
+        }
+        this->m_runDraws[found->second].instanceCount++;
+        this->m_runObjectDraws[i - begin] = found->second;
+    }
+
+    // Meshes seen more than once take the next records, counted again as they are written
+    for (InstancedDraw &draw : this->m_runDraws)
+    {
+        if (draw.instanceCount > 1u)
+        {
+            draw.firstInstance = resources.recordCount;
+            resources.recordCount += draw.instanceCount;
+            draw.instanceCount = 0u;
+        }
+    }
+    auto *records = static_cast<GpuDrawObject *>(resources.records.GetMappedData());
+    for (uint32_t i = begin; i < end; i++)
+    {
+        InstancedDraw &draw = this->m_runDraws[this->m_runObjectDraws[i - begin]];
+        if (draw.firstInstance == NO_RECORDS)
+        {
+            continue;
+        }
+        const RenderObject &object = objects[indices[i]];
+        GpuDrawObject &record = records[draw.firstInstance + draw.instanceCount++];
+        record = {};
+        record.worldMatrix = object.transform;
+        record.indexCount = object.indexCount;
+        record.firstIndex = object.firstIndex;
+        record.vertexOffset = object.vertexOffset;
+        record.materialIndex = object.material->materialIndex;
+    }
+    draws.insert(draws.end(), this->m_runDraws.begin(), this->m_runDraws.end());
+}
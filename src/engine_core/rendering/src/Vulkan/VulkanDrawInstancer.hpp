@@ -0,0 +1,108 @@
+/*! \file VulkanDrawInstancer.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Merges the CPU recorded draws of the same mesh and material into instanced draws
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include "Shared/DrawSorting.hpp"
+#include "Shared/RenderObject.hpp"
+#include "VulkanGpuCuller.hpp"
+#include "VulkanVertexBuffer.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    /// @brief Turns objects that repeat a mesh and material into a single vkCmdDrawIndexed each.
+    /// Every mesh shares the geometry pool's index buffer, so a mesh is its firstIndex, indexCount and vertexOffset.
+    /// Objects of the same mesh, pipeline and material set get their world matrix and material index written to the
+    /// frame's GpuDrawObject records, one after the other, and are drawn with firstInstance pointing at the first.
+    /// Every bindless material is instanced, its vertex shader reads the records through the bindless.glsl helpers.
+    /// Materials with their own set (MaterialInstance::materialSet) keep one draw per object with the push constants.
+    /// The opaque objects of gpu driven materials are normally culled and drawn by VulkanGpuCuller, those only get
+    /// here when they are transparent, past VulkanGpuCuller::MAX_BATCHES or on devices without GPU culling.
+    /// Keeps one record buffer per frame in flight, it grows by doubling in BeginFrame
+    class VulkanDrawInstancer
+    {
+      public:
+        /// @brief firstInstance of the draws of a single object, drawn from the push constants without a record
+        static constexpr uint32_t NO_RECORDS = UINT32_MAX;
+
+        /// @brief instanceCount objects sharing the mesh and material of the first one
+        struct InstancedDraw
+        {
+            /// @brief Index of the first object, the one whose mesh and material the draw binds
+            uint32_t object;
+            uint32_t instanceCount;
+            /// @brief First record of the draw in the frame's buffer, NO_RECORDS for single objects
+            uint32_t firstInstance;
+        };
+
+        void Init(VmaAllocator allocator, uint32_t frameCount);
+
+        /// @brief Destroys every buffer right away, the GPU must be idle
+        void Dispose() noexcept;
+
+        /// @brief Whether the object's shaders can read a record instead of the push constants, the bindless ones
+        [[nodiscard]] static bool Accepts(const RenderObject &object) noexcept;
+
+        /// @brief Makes room for maxInstances records and drops the frame's previous ones. Call once per frame before
+        /// recording, after waiting for the frame's previous submission
+        void BeginFrame(uint32_t frame, uint32_t maxInstances);
+
+        /// @brief Groups the objects of indices into draws, keeping the order DrawSorter gave them.
+        /// FrontToBack merges every object of a mesh within a run of the same pipeline and set, the draws follow the
+        /// first object of each mesh. BackToFront only merges consecutive objects, blending keeps their order
+        /// @param draws receives the draws to record, in order
+        void Build(uint32_t frame, const std::vector<RenderObject> &objects, const std::vector<uint32_t> &indices,
+                   EDrawOrder order, std::vector<InstancedDraw> &draws);
+
+        /// @brief Address to push as GPUDrawPushConstants::drawObjects for the frame's instanced draws
+        [[nodiscard]] VkDeviceAddress GetRecordsAddress(uint32_t frame) const noexcept;
+
+      private:
+        struct MeshKey
+        {
+            uint32_t firstIndex;
+            uint32_t indexCount;
+            int32_t vertexOffset;
+
+            bool operator==(const MeshKey &other) const noexcept
+            {
+                return this->firstIndex == other.firstIndex && this->indexCount == other.indexCount &&
+                       this->vertexOffset == other.vertexOffset;
+            }
+        };
+
+        struct MeshKeyHash
+        {
+            size_t operator()(const MeshKey &key) const noexcept;
+        };
+
+        struct FrameResources
+        {
+            /// @brief GpuDrawObject records written by Build, mapped
+            VulkanVertexBuffer records;
+            uint32_t capacity = 0u;
+            uint32_t recordCount = 0u;
+        };
+
+        /// @brief Appends the draws of the objects in [begin, end) of indices, which share a pipeline and set
+        void BuildRun(FrameResources &resources, const std::vector<RenderObject> &objects,
+                      const std::vector<uint32_t> &indices, uint32_t begin, uint32_t end,
+                      std::vector<InstancedDraw> &draws);
+
+        VmaAllocator m_allocator = nullptr;
+        std::vector<FrameResources> m_frames;
+        /// @brief Draw of each mesh in the run BuildRun is grouping, cleared every run
+        std::unordered_map<MeshKey, uint32_t, MeshKeyHash> m_meshLookup;
+        /// @brief The run's draws, then the draw of each of its objects
+        std::vector<InstancedDraw> m_runDraws;
+        std::vector<uint32_t> m_runObjectDraws;
+    };
+} // namespace Hush
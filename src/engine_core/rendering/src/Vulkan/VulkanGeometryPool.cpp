@@ -0,0 +1,145 @@
+/*! \file VulkanGeometryPool.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Every static mesh packed into one vertex and one index buffer
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanGeometryPool.hpp"
+#include "Assertions.hpp"
+#include "Logger.hpp"
+
+#include <volk.h>
+
+void Hush::VulkanGeometryPool::Init(VmaAllocator allocator, const VulkanUploadManager &uploadManager,
+                                    uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+    // AddMesh copies into ranges no frame reads yet while the frames in flight read the others, an exclusive buffer
+    // would have to change owner as a whole for that
+    std::vector<uint32_t> queueFamilies = uploadManager.GetConcurrentQueueFamilies();
+    this->m_vertexBuffer = VulkanVertexBuffer(static_cast<VkDeviceSize>(vertexCapacity) * sizeof(Vertex),
+                                              VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                  VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                              VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, allocator, 0u, queueFamilies);
+    this->m_indexBuffer = VulkanVertexBuffer(static_cast<VkDeviceSize>(indexCapacity) * sizeof(uint32_t),
+                                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+                                             allocator, 0u, queueFamilies);
+    this->m_vertexRanges.Reset(vertexCapacity);
+    this->m_indexRanges.Reset(indexCapacity);
+    this->m_meshCount = 0u;
+}
+
+void Hush::VulkanGeometryPool::Dispose() noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    this->m_vertexBuffer.Destroy();
+    this->m_indexBuffer.Destroy();
+    this->m_vertexRanges.Reset(0u);
+    this->m_indexRanges.Reset(0u);
+    this->m_pendingRemovals.clear();
+    this->m_meshCount = 0u;
+}
+
+MeshGeometry Hush::VulkanGeometryPool::AddMesh(VulkanUploadManager &uploadManager, const Vertex *vertices,
+                                               uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount,
+                                               UploadTicket *ticket)
+{
+    MeshGeometry mesh{};
+    {
+        std::lock_guard lock(this->m_mutex);
+        uint64_t vertexOffset = 0u;
+        if (vertexCount > 0u)
+        {
+            vertexOffset = this->m_vertexRanges.Allocate(vertexCount);
+            if (vertexOffset == FreeListAllocator::INVALID_OFFSET)
+            {
+                LogFormat(ELogLevel::Error, "Geometry pool is out of vertex space ({} requested, largest range is {})",
+                          vertexCount, this->m_vertexRanges.GetLargestFreeRange());
+                return MeshGeometry{};
+            }
+        }
+        uint64_t firstIndex = this->m_indexRanges.Allocate(indexCount);
+        if (firstIndex == FreeListAllocator::INVALID_OFFSET)
+        {
+            LogFormat(ELogLevel::Error, "Geometry pool is out of index space ({} requested, largest range is {})",
+                      indexCount, this->m_indexRanges.GetLargestFreeRange());
+            this->m_vertexRanges.Free(vertexOffset, vertexCount);
+            return MeshGeometry{};
+        }
+        mesh.firstIndex = static_cast<uint32_t>(firstIndex);
+        mesh.indexCount = indexCount;
+        mesh.vertexOffset = static_cast<int32_t>(vertexOffset);
+        mesh.vertexCount = vertexCount;
+        this->m_meshCount++;
+    }
+
+    // Both copies land in the same batch or the index one in a later batch, so its ticket covers the mesh
+    UploadTicket uploadTicket{};
+    if (vertexCount > 0u)
+    {
+        uploadTicket = uploadManager.UploadBuffer(this->m_vertexBuffer.GetBuffer(),
+                                                  static_cast<VkDeviceSize>(mesh.vertexOffset) * sizeof(Vertex),
+                                                  vertices, static_cast<VkDeviceSize>(vertexCount) * sizeof(Vertex),
+                                                  true);
+    }
+    uploadTicket = uploadManager.UploadBuffer(this->m_indexBuffer.GetBuffer(),
+                                              static_cast<VkDeviceSize>(mesh.firstIndex) * sizeof(uint32_t), indices,
+                                              static_cast<VkDeviceSize>(indexCount) * sizeof(uint32_t), true);
+    if (ticket != nullptr)
+    {
+        *ticket = uploadTicket;
+    }
+    return mesh;
+}
+
+void Hush::VulkanGeometryPool::RemoveMesh(const MeshGeometry &mesh, uint64_t retireValue)
+{
+    if (mesh.indexCount == 0u)
+    {
+        return;
+    }
+    std::lock_guard lock(this->m_mutex);
+    HUSH_ASSERT(this->m_pendingRemovals.empty() || this->m_pendingRemovals.back().retireValue <= retireValue,
+                "Geometry pool retire values must not decrease ({} after {})", retireValue,
+                this->m_pendingRemovals.back().retireValue);
+    this->m_pendingRemovals.push_back({mesh, retireValue});
+}
+
+void Hush::VulkanGeometryPool::Retire(uint64_t completedValue)
+{
+    std::lock_guard lock(this->m_mutex);
+    size_t count = 0u;
+    while (count < this->m_pendingRemovals.size() && this->m_pendingRemovals[count].retireValue <= completedValue)
+    {
+        const MeshGeometry &mesh = this->m_pendingRemovals[count].mesh;
+        this->m_vertexRanges.Free(static_cast<uint64_t>(mesh.vertexOffset), mesh.vertexCount);
+        this->m_indexRanges.Free(mesh.firstIndex, mesh.indexCount);
+        this->m_meshCount--;
+        count++;
+    }
+    this->m_pendingRemovals.erase(this->m_pendingRemovals.begin(),
+                                  this->m_pendingRemovals.begin() + static_cast<ptrdiff_t>(count));
+}
+
+VkBuffer Hush::VulkanGeometryPool::GetIndexBuffer() const noexcept
+{
+    return this->m_indexBuffer.GetBuffer();
+}
+
+VkDeviceAddress Hush::VulkanGeometryPool::GetVertexBufferAddress() const noexcept
+{
+    return this->m_vertexBuffer.GetDeviceAddress();
+}
+
+Hush::VulkanGeometryPool::Stats Hush::VulkanGeometryPool::GetStats() const noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    Stats stats{};
+    stats.meshCount = this->m_meshCount;
+    stats.vertexCapacity = this->m_vertexRanges.GetCapacity();
+    stats.indexCapacity = this->m_indexRanges.GetCapacity();
+    stats.usedVertices = stats.vertexCapacity - this->m_vertexRanges.GetFreeUnits();
+    stats.usedIndices = stats.indexCapacity - this->m_indexRanges.GetFreeUnits();
+    stats.largestFreeVertexRange = this->m_vertexRanges.GetLargestFreeRange();
+    return stats;
+}
@@ -0,0 +1,88 @@
+/*! \file VulkanGeometryPool.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Every static mesh packed into one vertex and one index buffer
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include "Shared/MaterialDefinitions.hpp"
+#include "Shared/RenderObject.hpp"
+#include "VulkanUploadManager.hpp"
+#include "VulkanVertexBuffer.hpp"
+#include "memory/FreeListAllocator.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    /// @brief Holds the vertices and indices of every static mesh in two device local buffers, so the index buffer is
+    /// bound once per frame and draws only differ in MeshGeometry::firstIndex and vertexOffset. Both buffers are
+    /// sub allocated with a FreeListAllocator, meshes can be streamed in and out at any time. The frames keep reading
+    /// both buffers while new meshes are copied into them, so they are shared concurrently with the transfer queue.
+    /// Vertices are fetched in the shaders through GetVertexBufferAddress, gl_VertexIndex already includes
+    /// vertexOffset. Thread safe
+    class VulkanGeometryPool
+    {
+      public:
+        static constexpr uint32_t DEFAULT_VERTEX_CAPACITY = 2u * 1024u * 1024u;
+        static constexpr uint32_t DEFAULT_INDEX_CAPACITY = 8u * 1024u * 1024u;
+
+        struct Stats
+        {
+            uint32_t meshCount = 0u;
+            uint64_t usedVertices = 0u;
+            uint64_t usedIndices = 0u;
+            uint64_t vertexCapacity = 0u;
+            uint64_t indexCapacity = 0u;
+            /// @brief Biggest mesh that still fits, low values with a lot of free space mean fragmentation
+            uint64_t largestFreeVertexRange = 0u;
+        };
+
+        /// @param uploadManager the one AddMesh will be given, the buffers are shared with its queue
+        void Init(VmaAllocator allocator, const VulkanUploadManager &uploadManager,
+                  uint32_t vertexCapacity = DEFAULT_VERTEX_CAPACITY, uint32_t indexCapacity = DEFAULT_INDEX_CAPACITY);
+
+        /// @brief Destroys both buffers right away, the GPU must be idle
+        void Dispose() noexcept;
+
+        /// @brief Reserves room for a mesh and queues its upload, the first frame drawing it waits for the copy
+        /// @return a MeshGeometry with indexCount 0 if the pool is full
+        MeshGeometry AddMesh(VulkanUploadManager &uploadManager, const Vertex *vertices, uint32_t vertexCount,
+                             const uint32_t *indices, uint32_t indexCount, UploadTicket *ticket = nullptr);
+
+        /// @brief Gives the mesh's ranges back once Retire sees retireValue completed
+        void RemoveMesh(const MeshGeometry &mesh, uint64_t retireValue);
+
+        /// @brief Releases the ranges removed with a retire value <= completedValue
+        void Retire(uint64_t completedValue);
+
+        [[nodiscard]] VkBuffer GetIndexBuffer() const noexcept;
+
+        [[nodiscard]] VkDeviceAddress GetVertexBufferAddress() const noexcept;
+
+        [[nodiscard]] Stats GetStats() const noexcept;
+
+      private:
+        struct PendingRemoval
+        {
+            MeshGeometry mesh;
+            uint64_t retireValue;
+        };
+
+        VulkanVertexBuffer m_vertexBuffer;
+        VulkanVertexBuffer m_indexBuffer;
+        /// @brief In vertices
+        FreeListAllocator m_vertexRanges;
+        /// @brief In indices
+        FreeListAllocator m_indexRanges;
+        uint32_t m_meshCount = 0u;
+
+        /// @brief Ordered by retire value
+        std::vector<PendingRemoval> m_pendingRemovals;
+        mutable std::mutex m_mutex;
+    };
+} // namespace Hush
@@ -0,0 +1,339 @@
+/*! \file VulkanGpuCuller.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Culls the gpu driven objects in a compute pass that writes their indirect draws
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanGpuCuller.hpp"
+#include "Assertions.hpp"
+#include "VulkanBindlessHeap.hpp"
+#include "Logger.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <volk.h>
+
+namespace
+{
+    constexpr VkBufferUsageFlags OBJECT_USAGE =
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    constexpr VkBufferUsageFlags COMMAND_USAGE = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                                 VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    constexpr VkBufferUsageFlags BATCH_USAGE = COMMAND_USAGE | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    /// @brief Cached for the CPU to read the shader's counters back
+    constexpr VmaAllocationCreateFlags READBACK_ALLOCATION_FLAGS =
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    /// @brief Count and first command of a batch
+    constexpr VkDeviceSize BATCH_STRIDE = 2u * sizeof(uint32_t);
+    /// @brief Early and late draws, frustum and occlusion culled, in that order
+    constexpr uint32_t COUNTER_COUNT = 4u;
+
+    void RecordMemoryBarrier(VkCommandBuffer cmd, VkPipelineStageFlags2 srcStages, VkAccessFlags2 srcAccess,
+                             VkPipelineStageFlags2 dstStages, VkAccessFlags2 dstAccess)
+    {
+        VkMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        barrier.srcStageMask = srcStages;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstStageMask = dstStages;
+        barrier.dstAccessMask = dstAccess;
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.memoryBarrierCount = 1u;
+        dependencyInfo.pMemoryBarriers = &barrier;
+        vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+    }
+} // namespace
+
+size_t Hush::VulkanGpuCuller::BatchKeyHash::operator()(const BatchKey &key) const noexcept
+{
+    size_t hash = std::hash<const void *>{}(key.pipeline);
+    return hash ^ (std::hash<const void *>{}(key.materialSet) + 0x9e3779b97f4a7c15ull + (hash << 6u) + (hash >> 2u));
+}
+
+void Hush::VulkanGpuCuller::Init(VmaAllocator allocator, VkPipeline pipeline, VkPipelineLayout layout,
+                                 const VulkanBindlessHeap &bindlessHeap, uint32_t frameCount)
+{
+    this->m_allocator = allocator;
+    this->m_pipeline = pipeline;
+    this->m_layout = layout;
+    this->m_bindlessHeap = &bindlessHeap;
+    this->m_frames.clear();
+    this->m_frames.resize(frameCount);
+    for (FrameResources &resources : this->m_frames)
+    {
+        resources.cullData = VulkanVertexBuffer(sizeof(GpuCullData), OBJECT_USAGE, VMA_MEMORY_USAGE_AUTO, allocator,
+                                                VulkanVertexBuffer::MAPPED_ALLOCATION_FLAGS);
+        resources.counts = VulkanVertexBuffer(COUNTER_COUNT * sizeof(uint32_t),
+                                              OBJECT_USAGE | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_AUTO,
+                                              allocator, READBACK_ALLOCATION_FLAGS);
+    }
+}
+
+void Hush::VulkanGpuCuller::Dispose() noexcept
+{
+    for (FrameResources &resources : this->m_frames)
+    {
+        resources.objects.Destroy();
+        resources.commands.Destroy();
+        resources.batchCounts.Destroy();
+        resources.visibility.Destroy();
+        resources.cullData.Destroy();
+        resources.counts.Destroy();
+    }
+    this->m_frames.clear();
+    this->m_pipeline = nullptr;
+    this->m_layout = nullptr;
+}
+
+bool Hush::VulkanGpuCuller::IsAvailable() const noexcept
+{
+    return this->m_pipeline != nullptr;
+}
+
+bool Hush::VulkanGpuCuller::Accepts(const RenderObject &object) noexcept
+{
+    return object.material != nullptr && object.material->pipeline != nullptr &&
+           object.material->pipeline->gpuDriven;
+}
+
+uint32_t Hush::VulkanGpuCuller::Prepare(uint32_t frame, const std::vector<RenderObject> &objects,
+                                        const std::optional<Frustum> &frustum,
+                                        const std::optional<GpuOcclusionInputs> &occlusion,
+                                        std::vector<uint32_t> &cpuObjects, VulkanDeletionQueue &deletionQueue,
+                                        uint64_t retireValue)
+{
+    HUSH_PROFILE_SCOPE("VulkanGpuCuller::Prepare");
+    FrameResources &resources = this->m_frames.at(frame);
+    this->m_stats = {};
+    if (resources.countsPending)
+    {
+        // The frame's last submission is done, so are its counters
+        HUSH_VK_ASSERT(vmaInvalidateAllocation(this->m_allocator, resources.counts.GetAllocation(), 0u,
+                                               COUNTER_COUNT * sizeof(uint32_t)),
+                       "Cull counters invalidation failed!");
+        const auto *counts = static_cast<const uint32_t *>(resources.counts.GetMappedData());
+        this->m_stats.earlyDraws = counts[0];
+        this->m_stats.lateDraws = counts[1];
+        this->m_stats.frustumCulled = counts[2];
+        this->m_stats.occlusionCulled = counts[3];
+        resources.countsPending = false;
+    }
+    resources.batches.clear();
+    resources.objectCount = 0u;
+    resources.visibilityCount = 0u;
+    cpuObjects.clear();
+    this->m_batchLookup.clear();
+
+    if (!objects.empty())
+    {
+        this->Reserve(resources.objects, objects.size() * sizeof(GpuDrawObject), OBJECT_USAGE, VMA_MEMORY_USAGE_AUTO,
+                      VulkanVertexBuffer::MAPPED_ALLOCATION_FLAGS);
+    }
+    auto *records = static_cast<GpuDrawObject *>(resources.objects.GetMappedData());
+    BatchKey lastKey{nullptr, nullptr};
+    uint32_t lastBatch = UINT32_MAX;
+    for (uint32_t index = 0; index < static_cast<uint32_t>(objects.size()); index++)
+    {
+        const RenderObject &object = objects[index];
+        if (!Accepts(object))
+        {
+            cpuObjects.push_back(index);
+            continue;
+        }
+
+        // Objects sharing a material usually come in a row, they skip the lookup
+        BatchKey key{object.material->pipeline, object.material->materialSet};
+        if (lastBatch == UINT32_MAX || !(key == lastKey))
+        {
+            auto found = this->m_batchLookup.find(key);
+            if (found == this->m_batchLookup.end())
+            {
+                if (resources.batches.size() == MAX_BATCHES)
+                {
+                    this->m_stats.overflowObjects++;
+                    cpuObjects.push_back(index);
+                    continue;
+                }
+                found = this->m_batchLookup.emplace(key, static_cast<uint32_t>(resources.batches.size())).first;
+                resources.batches.push_back({key.pipeline, key.materialSet, 0u, 0u});
+            }
+            lastKey = key;
+            lastBatch = found->second;
+        }
+
+        GpuDrawObject &record = records[resources.objectCount++];
+        record.worldMatrix = object.transform;
+        record.sphere = glm::vec4(object.bounds.origin, object.bounds.sphereRadius);
+        record.extents = glm::vec4(object.bounds.extents, 0.0f);
+        record.indexCount = object.indexCount;
+        record.firstIndex = object.firstIndex;
+        record.vertexOffset = object.vertexOffset;
+        record.materialIndex = object.material->materialIndex;
+        record.batch = lastBatch;
+        resources.batches[lastBatch].objectCount++;
+    }
+
+    this->m_stats.objectCount = resources.objectCount;
+    this->m_stats.batchCount = static_cast<uint32_t>(resources.batches.size());
+    if (resources.objectCount == 0u)
+    {
+        return 0u;
+    }
+    if (this->m_stats.overflowObjects > 0u)
+    {
+        LogFormat(ELogLevel::Warn, "{} gpu driven objects went past {} batches, the CPU draws them",
+                  this->m_stats.overflowObjects, MAX_BATCHES);
+    }
+    HUSH_VK_ASSERT(vmaFlushAllocation(this->m_allocator, resources.objects.GetAllocation(), 0u,
+                                      resources.objectCount * sizeof(GpuDrawObject)),
+                   "Draw object flush failed!");
+
+    // Every batch reserves a command per object and phase, the shader fills them from the front
+    uint32_t firstCommand = 0u;
+    for (Batch &batch : resources.batches)
+    {
+        batch.firstCommand = firstCommand;
+        firstCommand += batch.objectCount;
+    }
+    VkDeviceSize phaseCount = occlusion.has_value() ? static_cast<VkDeviceSize>(EGpuCullPhase::Count) : 1u;
+    this->Reserve(resources.commands, phaseCount * resources.objectCount * sizeof(VkDrawIndexedIndirectCommand),
+                  COMMAND_USAGE, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, 0u);
+    this->Reserve(resources.batchCounts, phaseCount * resources.batches.size() * BATCH_STRIDE, BATCH_USAGE,
+                  VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, 0u);
+
+    // The previous frame was submitted before this one, so its late phase wrote the visibility before ours reads it
+    const FrameResources &previous = this->m_frames[(frame + this->m_frames.size() - 1u) % this->m_frames.size()];
+    auto *cullData = static_cast<GpuCullData *>(resources.cullData.GetMappedData());
+    *cullData = {};
+    if (occlusion.has_value())
+    {
+        // The next frame's cull reads it as its previous visibility, that frame may not be done yet
+        this->Reserve(resources.visibility, resources.objectCount * sizeof(uint32_t), OBJECT_USAGE,
+                      VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, 0u, &deletionQueue, retireValue);
+        resources.visibilityCount = resources.objectCount;
+        cullData->viewProjection = occlusion->viewProjection;
+        cullData->visibility = resources.visibility.GetDeviceAddress();
+        cullData->previousVisibility = previous.visibility.GetDeviceAddress();
+        cullData->previousObjectCount = previous.visibilityCount;
+        cullData->occlusion = 1u;
+        cullData->depthWidth = occlusion->depthExtent.width;
+        cullData->depthHeight = occlusion->depthExtent.height;
+        cullData->pyramidImage = occlusion->pyramidImage;
+        cullData->pyramidSampler = occlusion->pyramidSampler;
+        cullData->pyramidLevels = occlusion->pyramidLevels;
+    }
+    // Degenerate planes keep everything, same as Frustum::FromViewProjection's
+    for (size_t plane = 0; plane < Frustum::PLANE_COUNT; plane++)
+    {
+        cullData->planes[plane] = frustum.has_value() ? frustum->planes[plane] : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+    cullData->objects = resources.objects.GetDeviceAddress();
+    cullData->commands = resources.commands.GetDeviceAddress();
+    cullData->batches = resources.batchCounts.GetDeviceAddress();
+    cullData->counts = resources.counts.GetDeviceAddress();
+    cullData->objectCount = resources.objectCount;
+    cullData->batchCount = static_cast<uint32_t>(resources.batches.size());
+    HUSH_VK_ASSERT(vmaFlushAllocation(this->m_allocator, resources.cullData.GetAllocation(), 0u, sizeof(GpuCullData)),
+                   "Cull data flush failed!");
+    return resources.objectCount;
+}
+
+void Hush::VulkanGpuCuller::RecordCull(VkCommandBuffer cmd, uint32_t frame, EGpuCullPhase phase)
+{
+    FrameResources &resources = this->m_frames.at(frame);
+    if (resources.objectCount == 0u)
+    {
+        return;
+    }
+
+    if (phase == EGpuCullPhase::Early)
+    {
+        uint32_t phaseCount = resources.visibilityCount > 0u ? static_cast<uint32_t>(EGpuCullPhase::Count) : 1u;
+        this->m_batchResets.clear();
+        for (uint32_t phaseIndex = 0; phaseIndex < phaseCount; phaseIndex++)
+        {
+            for (const Batch &batch : resources.batches)
+            {
+                this->m_batchResets.push_back(0u);
+                this->m_batchResets.push_back(phaseIndex * resources.objectCount + batch.firstCommand);
+            }
+        }
+        vkCmdUpdateBuffer(cmd, resources.batchCounts.GetBuffer(), 0u, this->m_batchResets.size() * sizeof(uint32_t),
+                          this->m_batchResets.data());
+        vkCmdFillBuffer(cmd, resources.counts.GetBuffer(), 0u, VK_WHOLE_SIZE, 0u);
+        RecordMemoryBarrier(cmd, VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                            VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+        resources.countsPending = true;
+    }
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, this->m_pipeline);
+    this->m_bindlessHeap->Bind(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, this->m_layout);
+    GpuCullPushConstants pushConstants{resources.cullData.GetDeviceAddress(), static_cast<uint32_t>(phase), 0u};
+    vkCmdPushConstants(cmd, this->m_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0u, sizeof(GpuCullPushConstants),
+                       &pushConstants);
+    vkCmdDispatch(cmd, (resources.objectCount + WORKGROUP_SIZE - 1u) / WORKGROUP_SIZE, 1u, 1u);
+
+    // The counts and commands are read by the indirect draws of this frame, the visibility by the next frame's cull
+    // and the counters by the CPU
+    RecordMemoryBarrier(cmd, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                        VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT |
+                            VK_PIPELINE_STAGE_2_HOST_BIT,
+                        VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                            VK_ACCESS_2_HOST_READ_BIT);
+}
+
+const std::vector<Hush::VulkanGpuCuller::Batch> &Hush::VulkanGpuCuller::GetBatches(uint32_t frame) const noexcept
+{
+    return this->m_frames[frame].batches;
+}
+
+VkDeviceAddress Hush::VulkanGpuCuller::GetDrawObjectsAddress(uint32_t frame) const noexcept
+{
+    return this->m_frames[frame].objects.GetDeviceAddress();
+}
+
+void Hush::VulkanGpuCuller::RecordBatchDraws(VkCommandBuffer cmd, uint32_t frame, uint32_t batch,
+                                             EGpuCullPhase phase) const
+{
+    const FrameResources &resources = this->m_frames.at(frame);
+    const Batch &drawBatch = resources.batches.at(batch);
+    auto phaseIndex = static_cast<VkDeviceSize>(phase);
+    VkDeviceSize firstCommand = phaseIndex * resources.objectCount + drawBatch.firstCommand;
+    VkDeviceSize countOffset = (phaseIndex * resources.batches.size() + batch) * BATCH_STRIDE;
+    vkCmdDrawIndexedIndirectCount(cmd, resources.commands.GetBuffer(),
+                                  firstCommand * sizeof(VkDrawIndexedIndirectCommand),
+                                  resources.batchCounts.GetBuffer(), countOffset, drawBatch.objectCount,
+                                  sizeof(VkDrawIndexedIndirectCommand));
+}
+
+Hush::VulkanGpuCuller::Stats Hush::VulkanGpuCuller::GetStats() const noexcept
+{
+    return this->m_stats;
+}
+
+void Hush::VulkanGpuCuller::Reserve(VulkanVertexBuffer &buffer, VkDeviceSize size, VkBufferUsageFlags usage,
+                                    VmaMemoryUsage memoryUsage, VmaAllocationCreateFlags allocationFlags,
+                                    VulkanDeletionQueue *deletionQueue, uint64_t retireValue)
+{
+    if (size <= buffer.GetCapacity())
+    {
+        return;
+    }
+    VkDeviceSize capacity = std::max(size, 2u * buffer.GetCapacity());
+    if (deletionQueue != nullptr)
+    {
+        buffer.Retire(*deletionQueue, retireValue);
+    }
+    else
+    {
+        // The frame's last submission is done, nothing reads the old buffer anymore
+        buffer.Destroy();
+    }
+    buffer = VulkanVertexBuffer(capacity, usage, memoryUsage, this->m_allocator, allocationFlags);
+}
@@ -0,0 +1,251 @@
+/*! \file VulkanGpuCuller.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Culls the gpu driven objects in a compute pass that writes their indirect draws
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include "Shared/Frustum.hpp"
+#include "Shared/RenderObject.hpp"
+#include "VulkanVertexBuffer.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    class VulkanBindlessHeap;
+
+    /// @brief The two dispatches of a frame with occlusion culling, without it only the early one runs
+    enum class EGpuCullPhase : uint8_t
+    {
+        /// @brief Draws the objects visible last frame, their depth is what the late phase tests against
+        Early,
+        /// @brief Tests the rest against the depth pyramid and draws the ones that became visible
+        Late,
+        Count
+    };
+
+    /// @brief One object as gpu_cull.comp and the bindless.glsl helpers read it, std430
+    struct GpuDrawObject
+    {
+        glm::mat4 worldMatrix;
+        /// @brief Local Bounds::origin in xyz, sphereRadius in w
+        glm::vec4 sphere;
+        /// @brief Local Bounds::extents in xyz
+        glm::vec4 extents;
+        uint32_t indexCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        uint32_t materialIndex;
+        /// @brief Index of the batch whose draws it is compacted into
+        uint32_t batch;
+        uint32_t padding[3];
+    };
+
+    static_assert(sizeof(GpuDrawObject) == 128u, "GpuDrawObject must match DrawObject in gpu_cull.comp");
+
+    /// @brief What the late phase tests the objects against, see VulkanDepthPyramid
+    struct GpuOcclusionInputs
+    {
+        /// @brief The one the objects are drawn with, depth reversed (Camera::GetProjectionMatrix)
+        glm::mat4 viewProjection;
+        VkExtent2D depthExtent;
+        /// @brief Bindless heap slots of the pyramid's view with every level, in SHADER_READ_ONLY_OPTIMAL, and of a
+        /// nearest sampler
+        uint32_t pyramidImage;
+        uint32_t pyramidSampler;
+        uint32_t pyramidLevels;
+    };
+
+    /// @brief Everything gpu_cull.comp reads besides the objects, written once per frame. std430
+    struct GpuCullData
+    {
+        glm::vec4 planes[Frustum::PLANE_COUNT];
+        glm::mat4 viewProjection;
+        VkDeviceAddress objects;
+        VkDeviceAddress commands;
+        VkDeviceAddress batches;
+        /// @brief One uint per object, written by the late phase
+        VkDeviceAddress visibility;
+        /// @brief What the previous frame's late phase wrote
+        VkDeviceAddress previousVisibility;
+        VkDeviceAddress counts;
+        uint32_t objectCount;
+        /// @brief 0 when the previous frame didn't cull occlusion, every object is then left to the late phase
+        uint32_t previousObjectCount;
+        /// @brief The late phase's batches follow the early ones
+        uint32_t batchCount;
+        uint32_t occlusion;
+        uint32_t depthWidth;
+        uint32_t depthHeight;
+        uint32_t pyramidImage;
+        uint32_t pyramidSampler;
+        uint32_t pyramidLevels;
+        uint32_t padding[3];
+    };
+
+    static_assert(sizeof(GpuCullData) == 256u, "GpuCullData must match CullData in gpu_cull.comp");
+
+    /// @brief Matches the push constants of gpu_cull.comp
+    struct GpuCullPushConstants
+    {
+        VkDeviceAddress cullData;
+        uint32_t phase;
+        uint32_t padding;
+    };
+
+    static_assert(sizeof(GpuCullPushConstants) <= 128, "Cull push constants exceed the size limit per shader");
+
+    /// @brief Moves opaque objects of gpu driven materials (MaterialPipeline::gpuDriven) off the CPU draw loop.
+    /// Prepare writes one GpuDrawObject per object to the frame's buffers and groups them in batches of the same
+    /// pipeline and material set. RecordCull dispatches gpu_cull.comp, which tests every object against the frustum
+    /// and appends a VkDrawIndexedIndirectCommand for each visible one to its batch. Each batch is then drawn by a
+    /// single vkCmdDrawIndexedIndirectCount, so the commands recorded per frame only grow with the batches.
+    /// firstInstance holds the object's index, the vertex shader reads its record through gl_InstanceIndex.
+    /// With occlusion inputs the cull runs in two phases (EGpuCullPhase): the early one draws what the previous frame
+    /// found visible, the renderer builds a depth pyramid from those draws, and the late one tests every object against
+    /// it, draws the newly visible ones and keeps the visibility for the next frame. Visibility is tracked by object
+    /// index, a list that changes order between frames only costs more late draws for a frame.
+    /// Keeps one set of buffers per frame in flight, they grow by doubling and are only touched once the frame that
+    /// last used them is done. The visibility is also read by the next frame, which may still be in flight, so a
+    /// visibility buffer that grows is destroyed through the renderer's deletion queue
+    class VulkanGpuCuller
+    {
+      public:
+        static constexpr uint32_t WORKGROUP_SIZE = 64u;
+        /// @brief The batches of both phases are reset with one vkCmdUpdateBuffer, which takes up to 65536 bytes.
+        /// Objects that would start a batch past the limit are left to the CPU
+        static constexpr uint32_t MAX_BATCHES =
+            65536u / (static_cast<uint32_t>(EGpuCullPhase::Count) * 2u * sizeof(uint32_t));
+
+        /// @brief Pipeline and set shared by the draws of a batch
+        struct Batch
+        {
+            const MaterialPipeline *pipeline;
+            VkDescriptorSet materialSet;
+            uint32_t objectCount;
+            /// @brief Where its early commands start, the first objectCount commands after it are reserved for the
+            /// batch. The late ones start Prepare's object count further
+            uint32_t firstCommand;
+        };
+
+        /// @brief Counts of the last Prepare
+        struct Stats
+        {
+            uint32_t objectCount = 0u;
+            uint32_t batchCount = 0u;
+            /// @brief Gpu driven objects left to the CPU because MAX_BATCHES was reached
+            uint32_t overflowObjects = 0u;
+            /// @brief Counted by the cull shader for the last frame read back, frameCount frames behind the counts
+            /// above. Without occlusion every draw is early and nothing is occlusion culled
+            uint32_t earlyDraws = 0u;
+            uint32_t lateDraws = 0u;
+            uint32_t frustumCulled = 0u;
+            uint32_t occlusionCulled = 0u;
+        };
+
+        /// @param pipeline gpu_cull.comp, built and owned by the renderer along with its layout
+        /// @param bindlessHeap bound at set 0 of layout for the late phase to sample the depth pyramid
+        void Init(VmaAllocator allocator, VkPipeline pipeline, VkPipelineLayout layout,
+                  const VulkanBindlessHeap &bindlessHeap, uint32_t frameCount);
+
+        /// @brief Destroys every buffer right away, the GPU must be idle
+        void Dispose() noexcept;
+
+        /// @brief False when the cull shader couldn't be built, every object is drawn by the CPU then
+        [[nodiscard]] bool IsAvailable() const noexcept;
+
+        /// @brief Whether Prepare takes the object, the rest go through VulkanRenderer::DrawRenderObject
+        [[nodiscard]] static bool Accepts(const RenderObject &object) noexcept;
+
+        /// @brief Writes the objects Accepts takes to the frame's buffers. Call once per frame before recording, after
+        /// waiting for the frame's previous submission
+        /// @param frustum unset keeps every object
+        /// @param occlusion unset skips the late phase, the early one then draws everything inside the frustum
+        /// @param cpuObjects receives the indices of the objects left for the caller to draw, in order
+        /// @param deletionQueue takes a replaced visibility buffer, destroyed once retireValue completes (the value
+        /// the frame being recorded signals)
+        /// @return How many objects were taken
+        uint32_t Prepare(uint32_t frame, const std::vector<RenderObject> &objects,
+                         const std::optional<Frustum> &frustum, const std::optional<GpuOcclusionInputs> &occlusion,
+                         std::vector<uint32_t> &cpuObjects, VulkanDeletionQueue &deletionQueue, uint64_t retireValue);
+
+        /// @brief Culls and waits for the writes before the draws read them. The early phase also resets the batches
+        /// and counters of both. Outside rendering, the late phase after the pyramid was built
+        void RecordCull(VkCommandBuffer cmd, uint32_t frame, EGpuCullPhase phase);
+
+        [[nodiscard]] const std::vector<Batch> &GetBatches(uint32_t frame) const noexcept;
+
+        /// @brief Address to push as GPUDrawPushConstants::drawObjects for the frame's indirect draws
+        [[nodiscard]] VkDeviceAddress GetDrawObjectsAddress(uint32_t frame) const noexcept;
+
+        /// @brief Records the indirect draws of a batch in a phase, its pipeline and push constants have to be bound
+        /// already
+        void RecordBatchDraws(VkCommandBuffer cmd, uint32_t frame, uint32_t batch, EGpuCullPhase phase) const;
+
+        [[nodiscard]] Stats GetStats() const noexcept;
+
+      private:
+        struct BatchKey
+        {
+            const MaterialPipeline *pipeline;
+            VkDescriptorSet materialSet;
+
+            bool operator==(const BatchKey &other) const noexcept
+            {
+                return this->pipeline == other.pipeline && this->materialSet == other.materialSet;
+            }
+        };
+
+        struct BatchKeyHash
+        {
+            size_t operator()(const BatchKey &key) const noexcept;
+        };
+
+        struct FrameResources
+        {
+            /// @brief GpuDrawObject records written by Prepare, mapped
+            VulkanVertexBuffer objects;
+            /// @brief VkDrawIndexedIndirectCommands written by the cull shader, the early phase's then the late's
+            VulkanVertexBuffer commands;
+            /// @brief Draw count then first command of each batch and phase, the count is what
+            /// vkCmdDrawIndexedIndirectCount reads
+            VulkanVertexBuffer batchCounts;
+            /// @brief Which objects the late phase found visible, read by the next frame's
+            VulkanVertexBuffer visibility;
+            /// @brief GpuCullData, mapped
+            VulkanVertexBuffer cullData;
+            /// @brief The shader's counters, mapped for reading
+            VulkanVertexBuffer counts;
+            std::vector<Batch> batches;
+            uint32_t objectCount = 0u;
+            /// @brief Objects whose visibility the frame writes, 0 without occlusion
+            uint32_t visibilityCount = 0u;
+            /// @brief Whether counts holds a submitted frame's results
+            bool countsPending = false;
+        };
+
+        /// @brief Recreates buffer with room for at least size bytes, its previous contents are dropped
+        /// @param deletionQueue set for buffers another frame in flight may still read, the old one is retired through
+        /// it instead of being destroyed right away
+        void Reserve(VulkanVertexBuffer &buffer, VkDeviceSize size, VkBufferUsageFlags usage,
+                     VmaMemoryUsage memoryUsage, VmaAllocationCreateFlags allocationFlags,
+                     VulkanDeletionQueue *deletionQueue = nullptr, uint64_t retireValue = 0u);
+
+        VmaAllocator m_allocator = nullptr;
+        VkPipeline m_pipeline = nullptr;
+        VkPipelineLayout m_layout = nullptr;
+        const VulkanBindlessHeap *m_bindlessHeap = nullptr;
+        std::vector<FrameResources> m_frames;
+        /// @brief Batch of each key for the Prepare running, cleared every call
+        std::unordered_map<BatchKey, uint32_t, BatchKeyHash> m_batchLookup;
+        /// @brief Zeroed counts and first commands of both phases, uploaded by RecordCull
+        std::vector<uint32_t> m_batchResets;
+        Stats m_stats{};
+    };
+} // namespace Hush
@@ -0,0 +1,114 @@
+/*! \file VulkanGpuTimestamps.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Per frame timestamp queries to measure how long each pass takes on the GPU
+*/
+
+#include "VulkanGpuTimestamps.hpp"
+#include "VkTypes.hpp"
+#include <algorithm>
+#include <volk.h>
+
+void Hush::GpuTimestampQueries::Init(VkDevice device, float timestampPeriod, uint32_t timestampValidBits)
+{
+    if (timestampValidBits == 0u)
+    {
+        return;
+    }
+    this->m_validMask = timestampValidBits >= 64u ? UINT64_MAX : (uint64_t{1} << timestampValidBits) - 1u;
+    this->m_nanosecondsPerTick = static_cast<double>(timestampPeriod);
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = MAX_SCOPES * 2u;
+    HUSH_VK_ASSERT(vkCreateQueryPool(device, &poolInfo, nullptr, &this->m_queryPool),
+                   "Creating timestamp query pool failed!");
+}
+
+void Hush::GpuTimestampQueries::Dispose(VkDevice device) noexcept
+{
+    if (this->m_queryPool != nullptr)
+    {
+        vkDestroyQueryPool(device, this->m_queryPool, nullptr);
+        this->m_queryPool = nullptr;
+    }
+}
+
+bool Hush::GpuTimestampQueries::ReadResults(VkDevice device, std::vector<GpuPassTiming> &timings)
+{
+    if (!this->m_hasPendingResults || this->m_scopeCount == 0u)
+    {
+        return false;
+    }
+    this->m_hasPendingResults = false;
+
+    // No VK_QUERY_RESULT_WAIT_BIT, the frame timeline wait already guarantees the queries are done
+    uint32_t queryCount = this->m_scopeCount * 2u;
+    VkResult rc = vkGetQueryPoolResults(device, this->m_queryPool, 0u, queryCount, sizeof(uint64_t) * queryCount,
+                                        this->m_results.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (rc != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    uint64_t frameStart = this->m_results[0] & this->m_validMask;
+    for (uint32_t i = 1u; i < this->m_scopeCount; i++)
+    {
+        frameStart = std::min(frameStart, this->m_results[i * 2u] & this->m_validMask);
+    }
+
+    timings.clear();
+    for (uint32_t i = 0u; i < this->m_scopeCount; i++)
+    {
+        uint64_t begin = this->m_results[i * 2u] & this->m_validMask;
+        uint64_t end = this->m_results[(i * 2u) + 1u] & this->m_validMask;
+        // Masking the difference handles counters that wrapped around
+        uint64_t elapsedTicks = (end - begin) & this->m_validMask;
+        uint64_t offsetTicks = (begin - frameStart) & this->m_validMask;
+
+        GpuPassTiming timing{};
+        timing.name = this->m_scopeNames[i];
+        timing.milliseconds = static_cast<double>(elapsedTicks) * this->m_nanosecondsPerTick / 1'000'000.0;
+        timing.startMilliseconds = static_cast<double>(offsetTicks) * this->m_nanosecondsPerTick / 1'000'000.0;
+        timings.push_back(timing);
+    }
+    return true;
+}
+
+void Hush::GpuTimestampQueries::Reset(VkCommandBuffer cmd) noexcept
+{
+    if (!this->IsEnabled())
+    {
+        return;
+    }
+    vkCmdResetQueryPool(cmd, this->m_queryPool, 0u, MAX_SCOPES * 2u);
+    this->m_scopeCount = 0u;
+    this->m_hasPendingResults = true;
+}
+
+uint32_t Hush::GpuTimestampQueries::BeginScope(VkCommandBuffer cmd, const char *name) noexcept
+{
+    if (!this->IsEnabled() || this->m_scopeCount == MAX_SCOPES)
+    {
+        return MAX_SCOPES;
+    }
+    uint32_t scope = this->m_scopeCount++;
+    this->m_scopeNames[scope] = name;
+    vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, this->m_queryPool, scope * 2u);
+    return scope;
+}
+
+void Hush::GpuTimestampQueries::EndScope(VkCommandBuffer cmd, uint32_t scope) noexcept
+{
+    if (scope >= MAX_SCOPES)
+    {
+        return;
+    }
+    vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, this->m_queryPool, (scope * 2u) + 1u);
+}
+
+bool Hush::GpuTimestampQueries::IsEnabled() const noexcept
+{
+    return this->m_queryPool != nullptr;
+}
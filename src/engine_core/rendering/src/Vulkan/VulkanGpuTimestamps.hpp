@@ -0,0 +1,90 @@
+/*! \file VulkanGpuTimestamps.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Per frame timestamp queries to measure how long each pass takes on the GPU
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    /// @brief GPU time of a named pass, in milliseconds
+    struct GpuPassTiming
+    {
+        const char *name;
+        double milliseconds;
+        /// @brief Offset of the start of the pass from the start of the first pass of its frame
+        double startMilliseconds;
+    };
+
+    /// @brief Timestamp query pool of one FrameData. Scopes are written while recording the frame and read back the
+    /// next time the same FrameData is used, after its timeline wait, so reading never stalls
+    class GpuTimestampQueries
+    {
+      public:
+        static constexpr uint32_t MAX_SCOPES = 16u;
+
+        /// @brief Does nothing if the queue can't write timestamps, every other call becomes a no-op
+        /// @param timestampPeriod nanoseconds per timestamp tick, from VkPhysicalDeviceLimits
+        /// @param timestampValidBits from the VkQueueFamilyProperties of the queue the frame is submitted to
+        void Init(VkDevice device, float timestampPeriod, uint32_t timestampValidBits);
+
+        void Dispose(VkDevice device) noexcept;
+
+        /// @brief Call after waiting on the frame timeline value, gets the timings recorded the last time this frame
+        /// was drawn
+        /// @return false if there was nothing to read
+        bool ReadResults(VkDevice device, std::vector<GpuPassTiming> &timings);
+
+        /// @brief Call at the start of the command buffer, before any scope
+        void Reset(VkCommandBuffer cmd) noexcept;
+
+        /// @param name must have static storage duration
+        /// @return the scope to pass to EndScope, or MAX_SCOPES if it couldn't be recorded
+        uint32_t BeginScope(VkCommandBuffer cmd, const char *name) noexcept;
+
+        void EndScope(VkCommandBuffer cmd, uint32_t scope) noexcept;
+
+        [[nodiscard]] bool IsEnabled() const noexcept;
+
+      private:
+        VkQueryPool m_queryPool = nullptr;
+        std::array<const char *, MAX_SCOPES> m_scopeNames{};
+        std::array<uint64_t, MAX_SCOPES * 2u> m_results{};
+        uint64_t m_validMask = 0u;
+        double m_nanosecondsPerTick = 0.0;
+        uint32_t m_scopeCount = 0u;
+        /// @brief Set when a recording starts, cleared once its results are read
+        bool m_hasPendingResults = false;
+    };
+
+    /// @brief Times the GPU work recorded between its construction and the end of the scope
+    class GpuTimestampScope
+    {
+      public:
+        GpuTimestampScope(GpuTimestampQueries &queries, VkCommandBuffer cmd, const char *name) noexcept
+            : m_queries(queries), m_cmd(cmd), m_scope(queries.BeginScope(cmd, name))
+        {
+        }
+
+        GpuTimestampScope(const GpuTimestampScope &) = delete;
+        GpuTimestampScope &operator=(const GpuTimestampScope &) = delete;
+        GpuTimestampScope(GpuTimestampScope &&) = delete;
+        GpuTimestampScope &operator=(GpuTimestampScope &&) = delete;
+
+        ~GpuTimestampScope()
+        {
+            this->m_queries.EndScope(this->m_cmd, this->m_scope);
+        }
+
+      private:
+        GpuTimestampQueries &m_queries;
+        VkCommandBuffer m_cmd;
+        uint32_t m_scope;
+    };
+} // namespace Hush
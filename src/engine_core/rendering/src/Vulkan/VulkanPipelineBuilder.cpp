@@ -3,6 +3,8 @@
 #include "VulkanPipelineBuilder.hpp"
 #include "Logger.hpp"
 #include "VkUtilsFactory.hpp"
+#include "filesystem/MappedFile.hpp"
+#include <string>
 #include <volk.h>
 
 // NOLINTNEXTLINE (Initialization is handled on the clear method)
@@ -33,12 +35,13 @@ void Hush::VulkanPipelineBuilder::Clear()
 
     this->m_renderInfo = {};
     this->m_renderInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+    this->m_colorAttachmentformat = VK_FORMAT_UNDEFINED;
 
     this->m_shaderStages.clear();
 }
 
-VkPipeline Hush::VulkanPipelineBuilder::Build(
-    VkDevice device) // Code from https://vkguide.dev/docs/new_chapter_3/building_pipeline/
+// Code from https://vkguide.dev/docs/new_chapter_3/building_pipeline/
+VkPipeline Hush::VulkanPipelineBuilder::Build(VkDevice device, VkPipelineCache pipelineCache) const
 {
     // make viewport state from our stored viewport and scissor.
     // at the moment we wont support multiple viewports or scissors
@@ -67,10 +70,17 @@ VkPipeline Hush::VulkanPipelineBuilder::Build(
     // build the actual pipeline
     // we now use all of the info structs we have been writing into into this one
     // to create the pipeline
+    // Builders get copied (the registry keeps one per async build), so the format pointer is refreshed here
+    VkPipelineRenderingCreateInfo renderInfo = this->m_renderInfo;
+    if (renderInfo.colorAttachmentCount > 0u)
+    {
+        renderInfo.pColorAttachmentFormats = &this->m_colorAttachmentformat;
+    }
+
     VkGraphicsPipelineCreateInfo pipelineInfo = {};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     // connect the renderInfo to the pNext extension mechanism
-    pipelineInfo.pNext = &this->m_renderInfo;
+    pipelineInfo.pNext = &renderInfo;
 
     pipelineInfo.stageCount = static_cast<uint32_t>(this->m_shaderStages.size());
     pipelineInfo.pStages = this->m_shaderStages.data();
@@ -95,7 +105,7 @@ VkPipeline Hush::VulkanPipelineBuilder::Build(
     // its easy to error out on create graphics pipeline, so we handle it a bit
     // better than the common VK_CHECK case
     VkPipeline newPipeline = nullptr;
-    if (vkCreateGraphicsPipelines(device, nullptr, 1, &pipelineInfo, nullptr, &newPipeline) != VK_SUCCESS)
+    if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &newPipeline) != VK_SUCCESS)
     {
         LogError("Failed to create the Vulkan Graphics Pipeline!");
         return nullptr;
@@ -103,6 +113,110 @@ VkPipeline Hush::VulkanPipelineBuilder::Build(
     return newPipeline;
 }
 
+template <typename Visitor> void Hush::VulkanPipelineBuilder::VisitState(Visitor &&visit) const
+{
+    // Counts first, so the fields of two different states can't line up into the same sequence
+    visit(this->m_shaderStages.size());
+    for (const VkPipelineShaderStageCreateInfo &stage : this->m_shaderStages)
+    {
+        visit(stage.stage);
+        visit(stage.module);
+        std::string_view name = stage.pName != nullptr ? stage.pName : "";
+        visit(name.size());
+        for (char character : name)
+        {
+            visit(character);
+        }
+    }
+    visit(this->m_inputAssembly.topology);
+    visit(this->m_inputAssembly.primitiveRestartEnable);
+
+    visit(this->m_rasterizer.depthClampEnable);
+    visit(this->m_rasterizer.rasterizerDiscardEnable);
+    visit(this->m_rasterizer.polygonMode);
+    visit(this->m_rasterizer.cullMode);
+    visit(this->m_rasterizer.frontFace);
+    visit(this->m_rasterizer.depthBiasEnable);
+    visit(this->m_rasterizer.depthBiasConstantFactor);
+    visit(this->m_rasterizer.depthBiasClamp);
+    visit(this->m_rasterizer.depthBiasSlopeFactor);
+    visit(this->m_rasterizer.lineWidth);
+
+    visit(this->m_colorBlendAttachment.blendEnable);
+    visit(this->m_colorBlendAttachment.srcColorBlendFactor);
+    visit(this->m_colorBlendAttachment.dstColorBlendFactor);
+    visit(this->m_colorBlendAttachment.colorBlendOp);
+    visit(this->m_colorBlendAttachment.srcAlphaBlendFactor);
+    visit(this->m_colorBlendAttachment.dstAlphaBlendFactor);
+    visit(this->m_colorBlendAttachment.alphaBlendOp);
+    visit(this->m_colorBlendAttachment.colorWriteMask);
+
+    visit(this->m_multisampling.rasterizationSamples);
+    visit(this->m_multisampling.sampleShadingEnable);
+    visit(this->m_multisampling.minSampleShading);
+    visit(this->m_multisampling.alphaToCoverageEnable);
+    visit(this->m_multisampling.alphaToOneEnable);
+
+    visit(this->m_depthStencil.depthTestEnable);
+    visit(this->m_depthStencil.depthWriteEnable);
+    visit(this->m_depthStencil.depthCompareOp);
+    visit(this->m_depthStencil.depthBoundsTestEnable);
+    visit(this->m_depthStencil.stencilTestEnable);
+    visit(this->m_depthStencil.front);
+    visit(this->m_depthStencil.back);
+    visit(this->m_depthStencil.minDepthBounds);
+    visit(this->m_depthStencil.maxDepthBounds);
+
+    visit(this->m_renderInfo.colorAttachmentCount);
+    visit(this->m_colorAttachmentformat);
+    visit(this->m_renderInfo.depthAttachmentFormat);
+    visit(this->m_renderInfo.stencilAttachmentFormat);
+    visit(this->m_pipelineLayout);
+}
+
+uint64_t Hush::VulkanPipelineBuilder::GetStateHash() const noexcept
+{
+    // FNV-1a, field by field so padding and pNext pointers never reach the hash
+    uint64_t hash = 14695981039346656037ull;
+    this->VisitState([&hash](const auto &value) {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+        for (size_t i = 0u; i < sizeof(value); i++)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    });
+    return hash;
+}
+
+bool Hush::VulkanPipelineBuilder::HasSameState(const VulkanPipelineBuilder &other) const
+{
+    // Same fields as the hash, laid out as bytes and compared whole
+    auto appendState = [](const VulkanPipelineBuilder &builder, std::string &state) {
+        builder.VisitState([&state](const auto &value) {
+            state.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        });
+    };
+    std::string state;
+    std::string otherState;
+    appendState(*this, state);
+    appendState(other, otherState);
+    return state == otherState;
+}
+
+bool Hush::VulkanPipelineBuilder::ReplaceShaderModule(VkShaderModule previous, VkShaderModule current) noexcept
+{
+    bool replaced = false;
+    for (VkPipelineShaderStageCreateInfo &stage : this->m_shaderStages)
+    {
+        if (stage.module == previous)
+        {
+            stage.module = current;
+            replaced = true;
+        }
+    }
+    return replaced;
+}
+
 Hush::VulkanPipelineBuilder &Hush::VulkanPipelineBuilder::SetShaders(VkShaderModule vertexShader,
                                                                VkShaderModule fragmentShader)
 {
@@ -206,6 +320,20 @@ Hush::VulkanPipelineBuilder& Hush::VulkanPipelineBuilder::DisableDepthTest()
     return *this;
 }
 
+Hush::VulkanPipelineBuilder &Hush::VulkanPipelineBuilder::EnableDepthTest(bool depthWriteEnable, VkCompareOp op)
+{
+    this->m_depthStencil.depthTestEnable = VK_TRUE;
+    this->m_depthStencil.depthWriteEnable = depthWriteEnable ? VK_TRUE : VK_FALSE;
+    this->m_depthStencil.depthCompareOp = op;
+    this->m_depthStencil.depthBoundsTestEnable = VK_FALSE;
+    this->m_depthStencil.stencilTestEnable = VK_FALSE;
+    this->m_depthStencil.front = {};
+    this->m_depthStencil.back = {};
+    this->m_depthStencil.minDepthBounds = 0.f;
+    this->m_depthStencil.maxDepthBounds = 1.f;
+    return *this;
+}
+
 Hush::VulkanPipelineBuilder& Hush::VulkanPipelineBuilder::SetColorAttachmentFormat(VkFormat format)
 {
     this->m_colorAttachmentformat = format;
@@ -222,41 +350,19 @@ Hush::VulkanPipelineBuilder &Hush::VulkanPipelineBuilder::SetDepthFormat(VkForma
 bool Hush::VulkanHelper::LoadShaderModule(const std::string_view &filePath, VkDevice device,
                                           VkShaderModule *outShaderModule)
 {
-    // open the file. With cursor at the end
-    std::ifstream file(filePath.data(), std::ios::ate | std::ios::binary);
-    if (file.fail() || !file.is_open())
+    // Mapped instead of read, the driver gets the words straight from the page cache
+    auto file = MappedFile::Open(std::filesystem::path(filePath));
+    if (!file.has_value() || file.value().GetSize() % sizeof(uint32_t) != 0u)
     {
         return false;
     }
 
-    // find what the size of the file is by looking up the location of the cursor
-    // because the cursor is at the end, it gives the size directly in bytes
-    uint32_t fileSize = static_cast<uint32_t>(file.tellg());
-
-    // spirv expects the buffer to be on uint32, so make sure to reserve a int
-    // vector big enough for the entire file
-    std::vector<uint32_t> buffer(fileSize / sizeof(uint32_t));
-
-    // put file cursor at beginning
-    file.seekg(0);
-
-    // load the entire file into the buffer
-    auto *fileData =
-        reinterpret_cast<char *>(buffer.data()); // We downsize this, but idk, this is how it expects us to use this
-    file.read(fileData, fileSize);
-
-    // now that the file is loaded into the buffer, we can close it
-    file.close();
-
-    // create a new shader module, using the buffer we loaded
+    // create a new shader module, mappings are page aligned so the words are suitably aligned for pCode
     VkShaderModuleCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
     createInfo.pNext = nullptr;
-
-    // codeSize has to be in bytes, so multply the ints in the buffer by size of
-    // int to know the real size of the buffer
-    createInfo.codeSize = buffer.size() * sizeof(uint32_t);
-    createInfo.pCode = buffer.data();
+    createInfo.codeSize = file.value().GetSize();
+    createInfo.pCode = reinterpret_cast<const uint32_t *>(file.value().GetData());
 
     // check that the creation goes well.
     VkShaderModule shaderModule = nullptr;
@@ -5,11 +5,10 @@
 */
 
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include <string_view>
-#include <iosfwd>
-#include <fstream>
 
 namespace Hush
 {
@@ -21,7 +20,19 @@ namespace Hush
 
         void Clear();
 
-        VkPipeline Build(VkDevice device);
+        /// @param pipelineCache usually VulkanRenderer::GetPipelineCache, so warm starts skip shader compilation
+        VkPipeline Build(VkDevice device, VkPipelineCache pipelineCache = nullptr) const;
+
+        /// @brief Hash of every piece of state Build reads (shaders, topology, raster, blend, depth, attachment formats
+        /// and layout). Different states can collide, HasSameState tells them apart. See VulkanPipelineRegistry
+        [[nodiscard]] uint64_t GetStateHash() const noexcept;
+
+        /// @brief Whether both builders build the same pipeline, compares the state GetStateHash hashes
+        [[nodiscard]] bool HasSameState(const VulkanPipelineBuilder &other) const;
+
+        /// @brief Swaps previous for current in every stage that uses it, for shader hot reload
+        /// @return false if no stage used previous
+        bool ReplaceShaderModule(VkShaderModule previous, VkShaderModule current) noexcept;
 
         VulkanPipelineBuilder& SetShaders(VkShaderModule vertexShader, VkShaderModule fragmentShader);
         VulkanPipelineBuilder& SetInputTopology(VkPrimitiveTopology topology);
@@ -32,11 +43,16 @@ namespace Hush
         VulkanPipelineBuilder& EnableBlendingAdditive();
         VulkanPipelineBuilder& EnableBlendingAlphaBlend();
         VulkanPipelineBuilder& DisableDepthTest();
+        /// @brief The renderer's depth is reversed, VK_COMPARE_OP_GREATER_OR_EQUAL keeps the nearest surface
+        VulkanPipelineBuilder& EnableDepthTest(bool depthWriteEnable, VkCompareOp op);
 
         VulkanPipelineBuilder& SetColorAttachmentFormat(VkFormat format);
         VulkanPipelineBuilder& SetDepthFormat(VkFormat format);
 
       private:
+        /// @brief Calls visit with every piece of state Build reads, field by field
+        template <typename Visitor> void VisitState(Visitor &&visit) const;
+
         std::vector<VkPipelineShaderStageCreateInfo> m_shaderStages;
 
         VkPipelineInputAssemblyStateCreateInfo m_inputAssembly;
@@ -46,12 +62,13 @@ namespace Hush
         VkPipelineLayout m_pipelineLayout = nullptr;
         VkPipelineDepthStencilStateCreateInfo m_depthStencil;
         VkPipelineRenderingCreateInfo m_renderInfo;
-        VkFormat m_colorAttachmentformat;
+        VkFormat m_colorAttachmentformat = VK_FORMAT_UNDEFINED;
     };
 
     class VulkanHelper final
     {
       public:
+        /// @brief Creates a module the caller owns, VulkanShaderLibrary::Load caches and reflects it instead
         static bool LoadShaderModule(const std::string_view &filePath, VkDevice device,
                                      VkShaderModule *outShaderModule);
     };
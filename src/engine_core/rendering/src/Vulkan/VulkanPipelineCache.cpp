@@ -0,0 +1,133 @@
+/*! \file VulkanPipelineCache.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief VkPipelineCache persisted between runs
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanPipelineCache.hpp"
+#include "Logger.hpp"
+#include "VkTypes.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <volk.h>
+
+/// @brief Anything bigger is a corrupt header, real caches stay in the tens of megabytes
+constexpr uint64_t MAX_CACHE_FILE_SIZE = 1024ull * 1024ull * 1024ull;
+
+void Hush::VulkanPipelineCache::Init(VkDevice device, VkPhysicalDevice physicalDevice, std::filesystem::path path)
+{
+    this->m_device = device;
+    this->m_path = std::move(path);
+    vkGetPhysicalDeviceProperties(physicalDevice, &this->m_deviceProperties);
+
+    std::vector<char> data;
+    std::ifstream file(this->m_path, std::ios::binary);
+    FileHeader fileHeader{};
+    if (file.read(reinterpret_cast<char *>(&fileHeader), sizeof(FileHeader)) && fileHeader.magic == FILE_MAGIC &&
+        fileHeader.dataSize <= MAX_CACHE_FILE_SIZE)
+    {
+        data.resize(fileHeader.dataSize);
+        if (!file.read(data.data(), static_cast<std::streamsize>(data.size())))
+        {
+            LogFormat(ELogLevel::Warn, "Pipeline cache {} is truncated, starting cold", this->m_path.string());
+            data.clear();
+        }
+    }
+    if (!data.empty() && !this->IsCompatible(fileHeader, data))
+    {
+        LogFormat(ELogLevel::Info, "Pipeline cache {} was written by another device or driver, starting cold",
+                  this->m_path.string());
+        data.clear();
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = data.size();
+    cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+    HUSH_VK_ASSERT(vkCreatePipelineCache(device, &cacheInfo, nullptr, &this->m_cache),
+                   "Pipeline cache creation failed!");
+    this->m_loadedSize = data.size();
+    LogFormat(ELogLevel::Debug, "Pipeline cache {} loaded {} bytes", this->m_path.string(), this->m_loadedSize);
+}
+
+void Hush::VulkanPipelineCache::Dispose() noexcept
+{
+    if (this->m_cache == nullptr)
+    {
+        return;
+    }
+    this->Save();
+    vkDestroyPipelineCache(this->m_device, this->m_cache, nullptr);
+    this->m_cache = nullptr;
+    this->m_device = nullptr;
+}
+
+bool Hush::VulkanPipelineCache::Save() const
+{
+    if (this->m_cache == nullptr)
+    {
+        return false;
+    }
+    size_t size = 0u;
+    HUSH_VK_ASSERT(vkGetPipelineCacheData(this->m_device, this->m_cache, &size, nullptr),
+                   "Pipeline cache size query failed!");
+    std::vector<char> data(size);
+    HUSH_VK_ASSERT(vkGetPipelineCacheData(this->m_device, this->m_cache, &size, data.data()),
+                   "Pipeline cache read failed!");
+
+    std::filesystem::path temporaryPath = this->m_path;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        FileHeader fileHeader{FILE_MAGIC, this->m_deviceProperties.driverVersion, size};
+        file.write(reinterpret_cast<const char *>(&fileHeader), sizeof(FileHeader));
+        file.write(data.data(), static_cast<std::streamsize>(size));
+        if (!file)
+        {
+            LogFormat(ELogLevel::Warn, "Could not write the pipeline cache to {}", temporaryPath.string());
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, this->m_path, error);
+    if (error)
+    {
+        LogFormat(ELogLevel::Warn, "Could not replace the pipeline cache {}: {}", this->m_path.string(),
+                  error.message());
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+
+VkPipelineCache Hush::VulkanPipelineCache::GetCache() const noexcept
+{
+    return this->m_cache;
+}
+
+bool Hush::VulkanPipelineCache::IsWarm() const noexcept
+{
+    return this->m_loadedSize > 0u;
+}
+
+size_t Hush::VulkanPipelineCache::GetLoadedSize() const noexcept
+{
+    return this->m_loadedSize;
+}
+
+bool Hush::VulkanPipelineCache::IsCompatible(const FileHeader &fileHeader, const std::vector<char> &data) const noexcept
+{
+    VkPipelineCacheHeaderVersionOne cacheHeader{};
+    if (data.size() < sizeof(cacheHeader))
+    {
+        return false;
+    }
+    std::memcpy(&cacheHeader, data.data(), sizeof(cacheHeader));
+    return fileHeader.driverVersion == this->m_deviceProperties.driverVersion &&
+           cacheHeader.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           cacheHeader.vendorID == this->m_deviceProperties.vendorID &&
+           cacheHeader.deviceID == this->m_deviceProperties.deviceID &&
+           std::memcmp(cacheHeader.pipelineCacheUUID, this->m_deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
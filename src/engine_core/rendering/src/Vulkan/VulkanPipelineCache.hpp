@@ -0,0 +1,66 @@
+/*! \file VulkanPipelineCache.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief VkPipelineCache persisted between runs
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    /// @brief Owns the VkPipelineCache every pipeline of the renderer is created with. Init seeds it with the blob
+    /// saved by the last run, as long as it was written by the same device and driver, so warm starts skip most of
+    /// the shader compilation. Dispose writes it back
+    class VulkanPipelineCache
+    {
+      public:
+        static constexpr const char *DEFAULT_PATH = "hush_pipeline_cache.bin";
+
+        /// @brief Creates the cache, empty if the file is missing, truncated or from another device or driver
+        void Init(VkDevice device, VkPhysicalDevice physicalDevice, std::filesystem::path path = DEFAULT_PATH);
+
+        /// @brief Saves the cache and destroys it
+        void Dispose() noexcept;
+
+        /// @brief Writes the cache to a temporary file and renames it over the old one, so a crash mid write never
+        /// leaves a corrupt cache behind
+        /// @return false if the file could not be written
+        bool Save() const;
+
+        [[nodiscard]] VkPipelineCache GetCache() const noexcept;
+
+        /// @brief Whether Init found a usable blob on disk
+        [[nodiscard]] bool IsWarm() const noexcept;
+
+        /// @brief Bytes of pipeline data Init loaded, 0 on a cold start
+        [[nodiscard]] size_t GetLoadedSize() const noexcept;
+
+      private:
+        /// @brief Prefixed to the driver's blob, its own header has no driver version and no length to check
+        /// truncation against
+        struct FileHeader
+        {
+            uint32_t magic;
+            uint32_t driverVersion;
+            uint64_t dataSize;
+        };
+
+        static constexpr uint32_t FILE_MAGIC = 0x48504331u; // HPC1
+
+        /// @brief Checks both headers against the device, the driver would reject a mismatch too but some drivers
+        /// crash on foreign blobs instead
+        [[nodiscard]] bool IsCompatible(const FileHeader &fileHeader, const std::vector<char> &data) const noexcept;
+
+        VkDevice m_device = nullptr;
+        VkPipelineCache m_cache = nullptr;
+        VkPhysicalDeviceProperties m_deviceProperties{};
+        std::filesystem::path m_path;
+        size_t m_loadedSize = 0u;
+    };
+} // namespace Hush
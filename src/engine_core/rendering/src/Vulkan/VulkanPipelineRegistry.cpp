@@ -0,0 +1,307 @@
+/*! \file VulkanPipelineRegistry.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Deduplicated, reference counted graphics pipelines with optional asynchronous builds
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanPipelineRegistry.hpp"
+#include "Assertions.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <volk.h>
+
+void Hush::VulkanPipelineRegistry::Init(VkDevice device, VkPipelineCache pipelineCache)
+{
+    this->m_device = device;
+    this->m_pipelineCache = pipelineCache;
+    this->m_jobSystem = JobSystem::GetMain();
+    this->m_requests = 0u;
+    this->m_sharedRequests = 0u;
+    this->m_rebuilds = 0u;
+}
+
+void Hush::VulkanPipelineRegistry::Dispose() noexcept
+{
+    if (this->m_jobSystem != nullptr)
+    {
+        this->m_jobSystem->WaitFor(this->m_buildCounter);
+    }
+    std::lock_guard lock(this->m_mutex);
+    for (auto &[key, pipeline] : this->m_pipelines)
+    {
+        (void)key;
+        vkDestroyPipeline(this->m_device, pipeline->m_pipeline.load(std::memory_order_acquire), nullptr);
+    }
+    for (PendingDestroy &pendingDestroy : this->m_pendingDestroys)
+    {
+        vkDestroyPipeline(this->m_device, pendingDestroy.pipeline->m_pipeline.load(std::memory_order_acquire),
+                          nullptr);
+    }
+    for (PendingRebuild &pendingRebuild : this->m_pendingRebuilds)
+    {
+        vkDestroyPipeline(this->m_device, pendingRebuild.pipeline, nullptr);
+    }
+    for (ReplacedPipeline &replacedPipeline : this->m_replacedPipelines)
+    {
+        vkDestroyPipeline(this->m_device, replacedPipeline.pipeline, nullptr);
+    }
+    this->m_pipelines.clear();
+    this->m_pendingDestroys.clear();
+    this->m_pendingRebuilds.clear();
+    this->m_replacedPipelines.clear();
+}
+
+const Hush::RegisteredPipeline *Hush::VulkanPipelineRegistry::Acquire(const VulkanPipelineBuilder &builder)
+{
+    bool isNew = false;
+    RegisteredPipeline *pipeline = this->FindOrAdd(builder, nullptr, isNew);
+    if (isNew)
+    {
+        this->BuildPipeline(*pipeline, builder);
+    }
+    else
+    {
+        // Another thread may still be building it, a synchronous caller expects it ready
+        while (!pipeline->m_buildDone.load(std::memory_order_acquire))
+        {
+            if (this->m_jobSystem != nullptr)
+            {
+                this->m_jobSystem->WaitFor(this->m_buildCounter);
+            }
+            std::this_thread::yield();
+        }
+    }
+    if (!pipeline->IsReady())
+    {
+        this->Release(pipeline, 0u);
+        return nullptr;
+    }
+    return pipeline;
+}
+
+const Hush::RegisteredPipeline *Hush::VulkanPipelineRegistry::AcquireAsync(const VulkanPipelineBuilder &builder,
+                                                                          VkPipeline fallback)
+{
+    bool isNew = false;
+    RegisteredPipeline *pipeline = this->FindOrAdd(builder, fallback, isNew);
+    if (!isNew)
+    {
+        return pipeline;
+    }
+    // The job builds from the pipeline's copy, the caller's builder can go away right now
+    if (this->m_jobSystem == nullptr)
+    {
+        this->BuildPipeline(*pipeline, builder);
+        return pipeline;
+    }
+    Job job{};
+    job.function = &VulkanPipelineRegistry::BuildJob;
+    job.data = pipeline;
+    this->m_jobSystem->Run(job, &this->m_buildCounter);
+    return pipeline;
+}
+
+void Hush::VulkanPipelineRegistry::Release(const RegisteredPipeline *pipeline, uint64_t retireValue)
+{
+    if (pipeline == nullptr)
+    {
+        return;
+    }
+    std::lock_guard lock(this->m_mutex);
+    auto it = this->m_pipelines.find(pipeline->m_key);
+    HUSH_ASSERT(it != this->m_pipelines.end() && it->second.get() == pipeline,
+                "Releasing a pipeline that is not registered");
+    if (--it->second->m_refCount > 0u)
+    {
+        return;
+    }
+    this->m_pendingDestroys.push_back({std::move(it->second), retireValue});
+    this->m_pipelines.erase(it);
+}
+
+void Hush::VulkanPipelineRegistry::Retire(uint64_t completedValue)
+{
+    std::lock_guard lock(this->m_mutex);
+    // Not ordered by retire value alone, a pipeline can't go while its async build still runs
+    auto retired = std::remove_if(this->m_pendingDestroys.begin(), this->m_pendingDestroys.end(),
+                                  [this, completedValue](const PendingDestroy &pendingDestroy) {
+                                      const RegisteredPipeline &pipeline = *pendingDestroy.pipeline;
+                                      if (pendingDestroy.retireValue > completedValue ||
+                                          !pipeline.m_buildDone.load(std::memory_order_acquire))
+                                      {
+                                          return false;
+                                      }
+                                      vkDestroyPipeline(this->m_device,
+                                                        pipeline.m_pipeline.load(std::memory_order_acquire), nullptr);
+                                      return true;
+                                  });
+    this->m_pendingDestroys.erase(retired, this->m_pendingDestroys.end());
+
+    size_t count = 0u;
+    while (count < this->m_replacedPipelines.size() && this->m_replacedPipelines[count].retireValue <= completedValue)
+    {
+        vkDestroyPipeline(this->m_device, this->m_replacedPipelines[count].pipeline, nullptr);
+        count++;
+    }
+    this->m_replacedPipelines.erase(this->m_replacedPipelines.begin(),
+                                    this->m_replacedPipelines.begin() + static_cast<ptrdiff_t>(count));
+}
+
+uint32_t Hush::VulkanPipelineRegistry::RebuildWithShader(VkShaderModule previous, VkShaderModule current)
+{
+    std::vector<PendingRebuild> rebuilds;
+    {
+        std::lock_guard lock(this->m_mutex);
+        for (auto &[key, pipeline] : this->m_pipelines)
+        {
+            // Pipelines still building would be rebuilt from the old state when they finish, so they wait for the
+            // next reload
+            if (!pipeline->m_buildDone.load(std::memory_order_acquire) || !pipeline->m_builder.has_value())
+            {
+                continue;
+            }
+            VulkanPipelineBuilder builder = *pipeline->m_builder;
+            if (builder.ReplaceShaderModule(previous, current))
+            {
+                rebuilds.push_back({key, pipeline.get(), nullptr, std::move(builder)});
+            }
+        }
+    }
+
+    uint32_t rebuiltCount = 0u;
+    for (PendingRebuild &rebuild : rebuilds)
+    {
+        rebuild.pipeline = rebuild.builder.Build(this->m_device, this->m_pipelineCache);
+        if (rebuild.pipeline == nullptr)
+        {
+            LogFormat(ELogLevel::Error, "Pipeline {:016x} failed to rebuild, it keeps its current shaders",
+                      rebuild.key);
+            continue;
+        }
+        rebuiltCount++;
+        std::lock_guard lock(this->m_mutex);
+        this->m_pendingRebuilds.push_back(std::move(rebuild));
+    }
+    return rebuiltCount;
+}
+
+uint32_t Hush::VulkanPipelineRegistry::ApplyRebuilds(uint64_t retireValue)
+{
+    std::lock_guard lock(this->m_mutex);
+    uint32_t swappedCount = 0u;
+    for (PendingRebuild &rebuild : this->m_pendingRebuilds)
+    {
+        auto it = this->m_pipelines.find(rebuild.key);
+        if (it == this->m_pipelines.end() || it->second.get() != rebuild.target ||
+            !it->second->m_buildDone.load(std::memory_order_acquire))
+        {
+            // Released in the meantime (and maybe registered again), nothing ever recorded the new one
+            vkDestroyPipeline(this->m_device, rebuild.pipeline, nullptr);
+            continue;
+        }
+        RegisteredPipeline &pipeline = *it->second;
+        VkPipeline replaced = pipeline.m_pipeline.exchange(rebuild.pipeline, std::memory_order_acq_rel);
+        pipeline.m_builder = std::move(rebuild.builder);
+        if (replaced != nullptr)
+        {
+            HUSH_ASSERT(this->m_replacedPipelines.empty() ||
+                            this->m_replacedPipelines.back().retireValue <= retireValue,
+                        "Pipeline registry retire values must not decrease ({} after {})", retireValue,
+                        this->m_replacedPipelines.back().retireValue);
+            this->m_replacedPipelines.push_back({replaced, retireValue});
+        }
+        this->RekeyLocked(rebuild.key);
+        swappedCount++;
+    }
+    this->m_pendingRebuilds.clear();
+    this->m_rebuilds += swappedCount;
+    return swappedCount;
+}
+
+Hush::VulkanPipelineRegistry::Stats Hush::VulkanPipelineRegistry::GetStats() const noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    Stats stats{};
+    stats.pipelineCount = static_cast<uint32_t>(this->m_pipelines.size());
+    stats.requests = this->m_requests;
+    stats.sharedRequests = this->m_sharedRequests;
+    stats.pendingBuilds = this->m_buildCounter.GetPending();
+    stats.rebuilds = this->m_rebuilds;
+    return stats;
+}
+
+Hush::RegisteredPipeline *Hush::VulkanPipelineRegistry::FindOrAdd(const VulkanPipelineBuilder &builder,
+                                                                  VkPipeline fallback, bool &isNew)
+{
+    uint64_t key = builder.GetStateHash();
+    std::lock_guard lock(this->m_mutex);
+    this->m_requests++;
+    // Probe past the keys taken by other states with the same hash, almost always the first one matches or is free
+    auto it = this->m_pipelines.find(key);
+    while (it != this->m_pipelines.end() && !it->second->m_builder->HasSameState(builder))
+    {
+        LogFormat(ELogLevel::Warning, "Pipeline state hash {:016x} collides with another state, trying the next key",
+                  key);
+        it = this->m_pipelines.find(++key);
+    }
+    isNew = it == this->m_pipelines.end();
+    if (isNew)
+    {
+        it = this->m_pipelines.emplace(key, std::make_unique<RegisteredPipeline>()).first;
+    }
+    std::unique_ptr<RegisteredPipeline> &pipeline = it->second;
+    if (isNew)
+    {
+        pipeline->m_key = key;
+        pipeline->m_fallback = fallback;
+        pipeline->m_registry = this;
+        pipeline->m_builder.emplace(builder);
+    }
+    else
+    {
+        this->m_sharedRequests++;
+    }
+    pipeline->m_refCount++;
+    return pipeline.get();
+}
+
+void Hush::VulkanPipelineRegistry::BuildPipeline(RegisteredPipeline &pipeline, const VulkanPipelineBuilder &builder)
+{
+    // Build copies what it needs, and the pipeline cache is internally synchronized, so workers don't lock here
+    VkPipeline built = builder.Build(this->m_device, this->m_pipelineCache);
+    if (built == nullptr)
+    {
+        LogFormat(ELogLevel::Error, "Pipeline {:016x} failed to build, its users keep the fallback", pipeline.m_key);
+    }
+    pipeline.m_pipeline.store(built, std::memory_order_release);
+    pipeline.m_buildDone.store(true, std::memory_order_release);
+}
+
+void Hush::VulkanPipelineRegistry::RekeyLocked(uint64_t key)
+{
+    auto it = this->m_pipelines.find(key);
+    uint64_t newKey = it->second->m_builder->GetStateHash();
+    if (newKey == key)
+    {
+        return;
+    }
+    // Probed like FindOrAdd, another entry may already hold the new state (acquired with the reloaded shader before
+    // this swap), both stay valid and FindOrAdd keeps returning the first one
+    while (this->m_pipelines.find(newKey) != this->m_pipelines.end())
+    {
+        newKey++;
+    }
+    std::unique_ptr<RegisteredPipeline> pipeline = std::move(it->second);
+    this->m_pipelines.erase(it);
+    pipeline->m_key = newKey;
+    this->m_pipelines.emplace(newKey, std::move(pipeline));
+}
+
+void Hush::VulkanPipelineRegistry::BuildJob(void *data)
+{
+    auto *pipeline = static_cast<RegisteredPipeline *>(data);
+    pipeline->m_registry->BuildPipeline(*pipeline, *pipeline->m_builder);
+}
@@ -0,0 +1,171 @@
+/*! \file VulkanPipelineRegistry.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Deduplicated, reference counted graphics pipelines with optional asynchronous builds
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include "JobSystem.hpp"
+#include "VulkanPipelineBuilder.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    class VulkanPipelineRegistry;
+
+    /// @brief Pipeline shared by every Acquire with the same builder state, stays valid until its last Release
+    class RegisteredPipeline
+    {
+      public:
+        /// @brief The built pipeline, or the fallback while an async build is still running (or if it failed)
+        [[nodiscard]] VkPipeline Get() const noexcept
+        {
+            VkPipeline pipeline = this->m_pipeline.load(std::memory_order_acquire);
+            return pipeline != nullptr ? pipeline : this->m_fallback;
+        }
+
+        [[nodiscard]] bool IsReady() const noexcept
+        {
+            return this->m_pipeline.load(std::memory_order_acquire) != nullptr;
+        }
+
+        /// @brief The state hash it's registered under, changes when ApplyRebuilds swaps in a rebuilt pipeline
+        [[nodiscard]] uint64_t GetKey() const noexcept
+        {
+            return this->m_key;
+        }
+
+      private:
+        friend class VulkanPipelineRegistry;
+
+        std::atomic<VkPipeline> m_pipeline{nullptr};
+        VkPipeline m_fallback = nullptr;
+        uint64_t m_key = 0u;
+        /// @brief Guarded by the registry's mutex
+        uint32_t m_refCount = 0u;
+        /// @brief Set once the build finished, successfully or not
+        std::atomic<bool> m_buildDone{false};
+        /// @brief Copy of the builder, hash hits are checked against it and rebuilds start from it when a shader is
+        /// reloaded. Set when the pipeline is registered, then only touched under the registry's mutex
+        std::optional<VulkanPipelineBuilder> m_builder;
+        VulkanPipelineRegistry *m_registry = nullptr;
+    };
+
+    /// @brief Hashes the whole builder state (VulkanPipelineBuilder::GetStateHash) so identical requests share one
+    /// VkPipeline, every unique state is built exactly once no matter how many materials ask for it. A hit is checked
+    /// against the registered builder's full state, a colliding state takes the next free key. Pipelines can be
+    /// built on the main JobSystem, the caller gets a fallback pipeline until the real one is ready.
+    /// Shader modules are hashed by handle, keep them alive while pipelines built from them are registered (and until
+    /// async builds are ready) or a recycled handle could match the wrong pipeline. VulkanShaderLibrary modules live
+    /// until its Dispose, so they always qualify.
+    /// Released pipelines are destroyed once the GPU is done with the frames that may use them (see Release and
+    /// Retire). Pipelines can be rebuilt with a reloaded shader and swapped in place, their users never see the
+    /// handle change. Thread safe
+    class VulkanPipelineRegistry
+    {
+      public:
+        struct Stats
+        {
+            uint32_t pipelineCount = 0u;
+            /// @brief Acquire calls since Init
+            uint32_t requests = 0u;
+            /// @brief Acquire calls that found their pipeline already registered
+            uint32_t sharedRequests = 0u;
+            uint32_t pendingBuilds = 0u;
+            /// @brief Pipelines swapped by ApplyRebuilds since Init
+            uint32_t rebuilds = 0u;
+        };
+
+        void Init(VkDevice device, VkPipelineCache pipelineCache);
+
+        /// @brief Waits for the async builds and destroys every pipeline right away, the GPU must be idle
+        void Dispose() noexcept;
+
+        /// @brief Returns the pipeline built from the builder's state, building it now if it's the first request
+        /// @return nullptr if the pipeline could not be built
+        const RegisteredPipeline *Acquire(const VulkanPipelineBuilder &builder);
+
+        /// @brief Like Acquire, but a new pipeline is built on the main JobSystem (right away if there was none at
+        /// Init) and RegisteredPipeline::Get returns fallback until it's done
+        const RegisteredPipeline *AcquireAsync(const VulkanPipelineBuilder &builder, VkPipeline fallback);
+
+        /// @brief Drops a reference, the last one destroys the pipeline once Retire sees retireValue completed
+        void Release(const RegisteredPipeline *pipeline, uint64_t retireValue);
+
+        /// @brief Destroys the pipelines released or replaced with a retire value <= completedValue
+        void Retire(uint64_t completedValue);
+
+        /// @brief Rebuilds every pipeline that uses previous with current in its place. Blocks while building, meant
+        /// for a background thread, ApplyRebuilds swaps the results in
+        /// @return The number of pipelines rebuilt
+        uint32_t RebuildWithShader(VkShaderModule previous, VkShaderModule current);
+
+        /// @brief Swaps in what RebuildWithShader built, call it at a frame boundary before recording. The replaced
+        /// pipelines are destroyed once Retire sees retireValue completed. A swapped pipeline moves to the key of its
+        /// new state, so Acquire with the reloaded shader shares it and the old state builds a new one
+        /// @return The number of pipelines swapped
+        uint32_t ApplyRebuilds(uint64_t retireValue);
+
+        [[nodiscard]] Stats GetStats() const noexcept;
+
+      private:
+        struct PendingDestroy
+        {
+            std::unique_ptr<RegisteredPipeline> pipeline;
+            uint64_t retireValue;
+        };
+
+        struct PendingRebuild
+        {
+            uint64_t key;
+            /// @brief Only compared, the registered pipeline may have been released since
+            const RegisteredPipeline *target;
+            VkPipeline pipeline;
+            VulkanPipelineBuilder builder;
+        };
+
+        struct ReplacedPipeline
+        {
+            VkPipeline pipeline;
+            uint64_t retireValue;
+        };
+
+        /// @brief Finds the pipeline with the builder's state or registers a new one holding a copy of the builder,
+        /// adding a reference either way
+        /// @param isNew set when the caller has to build it
+        RegisteredPipeline *FindOrAdd(const VulkanPipelineBuilder &builder, VkPipeline fallback, bool &isNew);
+
+        void BuildPipeline(RegisteredPipeline &pipeline, const VulkanPipelineBuilder &builder);
+
+        /// @brief Moves a registered pipeline to the key of its builder's current state, after a rebuild
+        void RekeyLocked(uint64_t key);
+
+        static void BuildJob(void *data);
+
+        VkDevice m_device = nullptr;
+        VkPipelineCache m_pipelineCache = nullptr;
+        /// @brief JobSystem::GetMain at Init, async builds run inline without one
+        JobSystem *m_jobSystem = nullptr;
+
+        std::unordered_map<uint64_t, std::unique_ptr<RegisteredPipeline>> m_pipelines;
+        std::vector<PendingDestroy> m_pendingDestroys;
+        std::vector<PendingRebuild> m_pendingRebuilds;
+        /// @brief Ordered by retire value
+        std::vector<ReplacedPipeline> m_replacedPipelines;
+        uint32_t m_requests = 0u;
+        uint32_t m_sharedRequests = 0u;
+        uint32_t m_rebuilds = 0u;
+        /// @brief Async builds in flight, Dispose waits on it
+        JobCounter m_buildCounter;
+        mutable std::mutex m_mutex;
+    };
+} // namespace Hush
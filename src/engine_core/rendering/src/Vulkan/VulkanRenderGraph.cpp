@@ -0,0 +1,618 @@
+/*! \file VulkanRenderGraph.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Frame graph of passes that declare the images they use, the graph records the barriers between them
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanRenderGraph.hpp"
+#include "Assertions.hpp"
+#include "Logger.hpp"
+#include "Profiler.hpp"
+#include "VkTypes.hpp"
+#include "VkUtilsFactory.hpp"
+#include "VulkanGpuTimestamps.hpp"
+
+#include <algorithm>
+#include <array>
+#include <volk.h>
+
+namespace
+{
+    struct AccessInfo
+    {
+        VkPipelineStageFlags2 stages;
+        VkAccessFlags2 access;
+        VkImageLayout layout;
+        VkImageUsageFlags usage;
+    };
+
+    constexpr VkPipelineStageFlags2 TRANSFER_STAGES = VK_PIPELINE_STAGE_2_BLIT_BIT | VK_PIPELINE_STAGE_2_COPY_BIT;
+    constexpr VkPipelineStageFlags2 DEPTH_STAGES =
+        VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+    constexpr VkAccessFlags2 WRITE_ACCESS = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+                                            VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+                                            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                            VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+    /// @brief Indexed by ERenderGraphAccess
+    constexpr std::array<AccessInfo, static_cast<size_t>(Hush::ERenderGraphAccess::Count)> ACCESS_INFOS = {{
+        {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL,
+         VK_IMAGE_USAGE_STORAGE_BIT},
+        {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT, VK_IMAGE_LAYOUT_GENERAL,
+         VK_IMAGE_USAGE_STORAGE_BIT},
+        {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT},
+        {VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT},
+        {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+         VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT},
+        {DEPTH_STAGES, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+         VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT},
+        {DEPTH_STAGES, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT, VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL,
+         VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT},
+        {TRANSFER_STAGES, VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+         VK_IMAGE_USAGE_TRANSFER_SRC_BIT},
+        {TRANSFER_STAGES, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+         VK_IMAGE_USAGE_TRANSFER_DST_BIT},
+        // Presentation is ordered by the semaphore the submission signals, nothing to wait on here
+        {VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, 0u},
+    }};
+
+    const AccessInfo &GetAccessInfo(Hush::ERenderGraphAccess access)
+    {
+        return ACCESS_INFOS[static_cast<size_t>(access)];
+    }
+
+    /// @brief FNV-1a, keys the transient images a graph declares
+    class Fnv1a
+    {
+      public:
+        void Add(uint64_t value) noexcept
+        {
+            for (uint32_t i = 0; i < 8u; i++)
+            {
+                this->m_hash = (this->m_hash ^ ((value >> (i * 8u)) & 0xFFu)) * 1099511628211ull;
+            }
+        }
+
+        [[nodiscard]] uint64_t Get() const noexcept
+        {
+            return this->m_hash;
+        }
+
+      private:
+        uint64_t m_hash = 14695981039346656037ull;
+    };
+} // namespace
+
+Hush::RenderGraphPassBuilder &Hush::RenderGraphPassBuilder::Read(RenderGraphImage image, ERenderGraphAccess access)
+{
+    HUSH_ASSERT((GetAccessInfo(access).access & WRITE_ACCESS) == 0u, "Pass writes with a read, use Write instead");
+    this->m_graph.AddUse(this->m_pass, image, access, false);
+    return *this;
+}
+
+Hush::RenderGraphPassBuilder &Hush::RenderGraphPassBuilder::Write(RenderGraphImage image, ERenderGraphAccess access)
+{
+    HUSH_ASSERT((GetAccessInfo(access).access & WRITE_ACCESS) != 0u, "Pass writes with an access that only reads");
+    this->m_graph.AddUse(this->m_pass, image, access, true);
+    return *this;
+}
+
+Hush::RenderGraphPassBuilder &Hush::RenderGraphPassBuilder::SetSideEffects()
+{
+    this->m_graph.m_passes[this->m_pass].sideEffects = true;
+    return *this;
+}
+
+void Hush::VulkanRenderGraph::Init(VkDevice device, VmaAllocator allocator)
+{
+    this->m_device = device;
+    this->m_allocator = allocator;
+}
+
+void Hush::VulkanRenderGraph::Dispose() noexcept
+{
+    for (PendingDestroy &pendingDestroy : this->m_pendingDestroys)
+    {
+        this->DestroyRealized(pendingDestroy.images, pendingDestroy.slots);
+    }
+    this->m_pendingDestroys.clear();
+    this->DestroyRealized(this->m_realized, this->m_slots);
+    this->m_realizedKey = 0u;
+    this->Reset();
+}
+
+void Hush::VulkanRenderGraph::Reset() noexcept
+{
+    // Only clears, the vectors keep their capacity so building a graph every frame doesn't allocate
+    this->m_arena.Reset();
+    this->m_images.clear();
+    this->m_passes.clear();
+    this->m_uses.clear();
+    this->m_transients.clear();
+    this->m_barriers.clear();
+}
+
+Hush::RenderGraphImage Hush::VulkanRenderGraph::ImportImage(const char *name, VkImage image, VkImageView view,
+                                                            VkImageAspectFlags aspect, RenderGraphImageState *state)
+{
+    HUSH_ASSERT(state != nullptr, "Imported image {} needs a state to read and write back", name);
+    auto handle = static_cast<RenderGraphImage>(this->m_images.size());
+    this->m_images.push_back({name, image, view, aspect, state, INVALID_IMAGE, ERenderGraphAccess::Count, false, {}});
+    return handle;
+}
+
+Hush::RenderGraphImage Hush::VulkanRenderGraph::CreateImage(const char *name, const RenderGraphImageDesc &desc)
+{
+    auto handle = static_cast<RenderGraphImage>(this->m_images.size());
+    auto transient = static_cast<uint32_t>(this->m_transients.size());
+    this->m_transients.push_back({desc, 0u, INVALID_IMAGE, INVALID_IMAGE});
+    this->m_images.push_back(
+        {name, nullptr, nullptr, desc.aspect, nullptr, transient, ERenderGraphAccess::Count, false, {}});
+    return handle;
+}
+
+void Hush::VulkanRenderGraph::SetFinalAccess(RenderGraphImage image, ERenderGraphAccess access)
+{
+    HUSH_ASSERT(image < this->m_images.size(), "Invalid render graph image {}", image);
+    Image &graphImage = this->m_images[image];
+    HUSH_ASSERT(graphImage.importedState != nullptr, "Only imported images outlive the graph, {} is transient",
+                graphImage.name);
+    graphImage.finalAccess = access;
+    graphImage.hasFinalAccess = true;
+}
+
+VkImage Hush::VulkanRenderGraph::GetImage(RenderGraphImage image) const
+{
+    HUSH_ASSERT(image < this->m_images.size(), "Invalid render graph image {}", image);
+    return this->m_images[image].image;
+}
+
+VkImageView Hush::VulkanRenderGraph::GetImageView(RenderGraphImage image) const
+{
+    HUSH_ASSERT(image < this->m_images.size(), "Invalid render graph image {}", image);
+    return this->m_images[image].view;
+}
+
+void Hush::VulkanRenderGraph::Execute(VkCommandBuffer cmd, uint64_t retireValue, GpuTimestampQueries *timestamps)
+{
+    HUSH_PROFILE_SCOPE("VulkanRenderGraph::Execute");
+    this->m_stats = {};
+    this->CompileUses();
+    this->CullPasses();
+    this->RealizeTransients(retireValue);
+
+    for (Image &image : this->m_images)
+    {
+        image.tracked = {};
+        if (image.importedState != nullptr)
+        {
+            image.tracked.layout = image.importedState->layout;
+            image.tracked.writeStages = image.importedState->stages;
+            image.tracked.writeAccess = image.importedState->writeAccess;
+        }
+    }
+
+    size_t useEnd = 0u;
+    for (uint32_t pass = 0; pass < this->m_passes.size(); pass++)
+    {
+        size_t useBegin = useEnd;
+        while (useEnd < this->m_uses.size() && this->m_uses[useEnd].pass == pass)
+        {
+            useEnd++;
+        }
+        const Pass &graphPass = this->m_passes[pass];
+        if (graphPass.culled)
+        {
+            continue;
+        }
+
+        for (size_t i = useBegin; i < useEnd; i++)
+        {
+            const ImageUse &use = this->m_uses[i];
+            Image &image = this->m_images[use.image];
+            if (image.transient != INVALID_IMAGE && this->m_transients[image.transient].firstPass == pass)
+            {
+                // Whatever used the memory last, this frame or the one before, has to be done with it
+                const RenderGraphImageState &slotState =
+                    this->m_slots[this->m_realized[image.transient].slot].endState;
+                image.tracked.writeStages = slotState.stages;
+                image.tracked.writeAccess = slotState.writeAccess;
+            }
+            this->TrackUse(image, use.stages, use.access, use.layout, use.write);
+        }
+        this->FlushBarriers(cmd);
+
+        if (timestamps != nullptr)
+        {
+            GpuTimestampScope gpuScope(*timestamps, cmd, graphPass.name);
+            graphPass.execute(graphPass.closure, cmd);
+        }
+        else
+        {
+            graphPass.execute(graphPass.closure, cmd);
+        }
+
+        for (size_t i = useBegin; i < useEnd; i++)
+        {
+            const Image &image = this->m_images[this->m_uses[i].image];
+            if (image.transient != INVALID_IMAGE && this->m_transients[image.transient].lastPass == pass)
+            {
+                RenderGraphImageState &slotState = this->m_slots[this->m_realized[image.transient].slot].endState;
+                slotState.stages = image.tracked.writeStages | image.tracked.readStages;
+                slotState.writeAccess = image.tracked.writeAccess;
+            }
+        }
+    }
+
+    for (Image &image : this->m_images)
+    {
+        if (image.hasFinalAccess)
+        {
+            const AccessInfo &info = GetAccessInfo(image.finalAccess);
+            this->TrackUse(image, info.stages, info.access, info.layout, false);
+        }
+    }
+    this->FlushBarriers(cmd);
+
+    for (const Image &image : this->m_images)
+    {
+        if (image.importedState != nullptr)
+        {
+            image.importedState->layout = image.tracked.layout;
+            image.importedState->stages = image.tracked.writeStages | image.tracked.readStages;
+            image.importedState->writeAccess = image.tracked.writeAccess;
+        }
+    }
+}
+
+void Hush::VulkanRenderGraph::Retire(uint64_t completedValue)
+{
+    size_t count = 0u;
+    while (count < this->m_pendingDestroys.size() && this->m_pendingDestroys[count].retireValue <= completedValue)
+    {
+        PendingDestroy &pendingDestroy = this->m_pendingDestroys[count];
+        this->DestroyRealized(pendingDestroy.images, pendingDestroy.slots);
+        count++;
+    }
+    this->m_pendingDestroys.erase(this->m_pendingDestroys.begin(),
+                                  this->m_pendingDestroys.begin() + static_cast<ptrdiff_t>(count));
+}
+
+Hush::VulkanRenderGraph::Stats Hush::VulkanRenderGraph::GetStats() const noexcept
+{
+    return this->m_stats;
+}
+
+Hush::RenderGraphPassBuilder Hush::VulkanRenderGraph::AddPassInternal(const char *name, PassFunction execute,
+                                                                      void *closure)
+{
+    HUSH_ASSERT(closure != nullptr, "Out of memory for render graph pass {}", name);
+    auto pass = static_cast<uint32_t>(this->m_passes.size());
+    this->m_passes.push_back({name, execute, closure, false, false});
+    return RenderGraphPassBuilder(*this, pass);
+}
+
+void Hush::VulkanRenderGraph::AddUse(uint32_t pass, RenderGraphImage image, ERenderGraphAccess access, bool write)
+{
+    HUSH_ASSERT(image < this->m_images.size(), "Invalid render graph image {}", image);
+    HUSH_ASSERT(access != ERenderGraphAccess::Present, "Present is only valid as a final access");
+    const AccessInfo &info = GetAccessInfo(access);
+    this->m_uses.push_back({pass, image, info.stages, info.access, info.layout, write});
+    uint32_t transient = this->m_images[image].transient;
+    if (transient != INVALID_IMAGE)
+    {
+        this->m_transients[transient].usage |= info.usage;
+    }
+}
+
+void Hush::VulkanRenderGraph::CompileUses()
+{
+    std::sort(this->m_uses.begin(), this->m_uses.end(), [](const ImageUse &lhs, const ImageUse &rhs) {
+        return lhs.pass != rhs.pass ? lhs.pass < rhs.pass : lhs.image < rhs.image;
+    });
+
+    size_t merged = 0u;
+    for (size_t i = 0; i < this->m_uses.size(); i++)
+    {
+        const ImageUse &use = this->m_uses[i];
+        if (merged != 0u && this->m_uses[merged - 1u].pass == use.pass && this->m_uses[merged - 1u].image == use.image)
+        {
+            ImageUse &previous = this->m_uses[merged - 1u];
+            HUSH_ASSERT(previous.layout == use.layout, "Pass {} uses {} in two layouts",
+                        this->m_passes[use.pass].name, this->m_images[use.image].name);
+            previous.stages |= use.stages;
+            previous.access |= use.access;
+            previous.write = previous.write || use.write;
+            continue;
+        }
+        this->m_uses[merged++] = use;
+    }
+    this->m_uses.resize(merged);
+}
+
+void Hush::VulkanRenderGraph::CullPasses()
+{
+    // Everything an imported image ends up with is visible outside the graph, the rest only matters if a kept pass
+    // uses it. Walking backwards, a pass is kept if a later kept pass uses what it writes
+    this->m_imageNeeded.assign(this->m_images.size(), 0u);
+    for (size_t i = 0; i < this->m_images.size(); i++)
+    {
+        this->m_imageNeeded[i] = this->m_images[i].importedState != nullptr ? 1u : 0u;
+    }
+
+    size_t useEnd = this->m_uses.size();
+    for (size_t passIndex = this->m_passes.size(); passIndex-- > 0u;)
+    {
+        size_t useBegin = useEnd;
+        while (useBegin > 0u && this->m_uses[useBegin - 1u].pass == passIndex)
+        {
+            useBegin--;
+        }
+
+        Pass &pass = this->m_passes[passIndex];
+        bool writes = false;
+        bool keep = pass.sideEffects;
+        for (size_t i = useBegin; i < useEnd; i++)
+        {
+            const ImageUse &use = this->m_uses[i];
+            writes = writes || use.write;
+            keep = keep || (use.write && this->m_imageNeeded[use.image] != 0u);
+        }
+        // A pass that writes nothing the graph knows about must be doing something else
+        pass.culled = writes && !keep;
+        if (!pass.culled)
+        {
+            for (size_t i = useBegin; i < useEnd; i++)
+            {
+                this->m_imageNeeded[this->m_uses[i].image] = 1u;
+            }
+        }
+        else
+        {
+            this->m_stats.culledPasses++;
+        }
+        useEnd = useBegin;
+    }
+    this->m_stats.passCount = static_cast<uint32_t>(this->m_passes.size()) - this->m_stats.culledPasses;
+
+    for (const ImageUse &use : this->m_uses)
+    {
+        uint32_t transient = this->m_images[use.image].transient;
+        if (transient == INVALID_IMAGE || this->m_passes[use.pass].culled)
+        {
+            continue;
+        }
+        TransientImage &transientImage = this->m_transients[transient];
+        transientImage.firstPass = std::min(transientImage.firstPass, use.pass);
+        // Uses are sorted by pass, the last one seen is the last pass
+        transientImage.lastPass = use.pass;
+    }
+}
+
+void Hush::VulkanRenderGraph::RealizeTransients(uint64_t retireValue)
+{
+    Fnv1a key;
+    key.Add(this->m_transients.size());
+    for (const TransientImage &transient : this->m_transients)
+    {
+        key.Add(static_cast<uint64_t>(transient.desc.format) | (static_cast<uint64_t>(transient.desc.aspect) << 32u));
+        key.Add(static_cast<uint64_t>(transient.desc.extent.width) |
+                (static_cast<uint64_t>(transient.desc.extent.height) << 32u));
+        key.Add(static_cast<uint64_t>(transient.desc.extent.depth) | (static_cast<uint64_t>(transient.usage) << 32u));
+        key.Add(static_cast<uint64_t>(transient.firstPass) | (static_cast<uint64_t>(transient.lastPass) << 32u));
+    }
+
+    if (key.Get() != this->m_realizedKey)
+    {
+        if (!this->m_realized.empty() || !this->m_slots.empty())
+        {
+            // The frames in flight may still use them
+            this->m_pendingDestroys.push_back({std::move(this->m_realized), std::move(this->m_slots), retireValue});
+            this->m_realized.clear();
+            this->m_slots.clear();
+        }
+        this->m_realizedKey = key.Get();
+        this->m_realized.assign(this->m_transients.size(), {nullptr, nullptr, 0u, INVALID_IMAGE});
+
+        std::vector<VkMemoryRequirements> requirements(this->m_transients.size());
+        std::vector<uint32_t> order;
+        for (uint32_t i = 0; i < this->m_transients.size(); i++)
+        {
+            const TransientImage &transient = this->m_transients[i];
+            if (transient.firstPass == INVALID_IMAGE)
+            {
+                continue;
+            }
+            VkImageCreateInfo imageInfo =
+                VkUtilsFactory::CreateImageCreateInfo(transient.desc.format, transient.usage, transient.desc.extent);
+            HUSH_VK_ASSERT(vkCreateImage(this->m_device, &imageInfo, nullptr, &this->m_realized[i].image),
+                           "Creating a transient render graph image failed!");
+            vkGetImageMemoryRequirements(this->m_device, this->m_realized[i].image, &requirements[i]);
+            this->m_realized[i].size = requirements[i].size;
+            order.push_back(i);
+        }
+
+        // Biggest first, the smaller images then fit in the slots they create
+        std::sort(order.begin(), order.end(), [&requirements](uint32_t lhs, uint32_t rhs) {
+            return requirements[lhs].size > requirements[rhs].size;
+        });
+        for (uint32_t index : order)
+        {
+            const TransientImage &transient = this->m_transients[index];
+            uint32_t slot = INVALID_IMAGE;
+            for (uint32_t candidate = 0; candidate < this->m_slots.size() && slot == INVALID_IMAGE; candidate++)
+            {
+                if ((this->m_slots[candidate].requirements.memoryTypeBits & requirements[index].memoryTypeBits) == 0u)
+                {
+                    continue;
+                }
+                bool overlaps = false;
+                for (uint32_t other : order)
+                {
+                    const TransientImage &otherTransient = this->m_transients[other];
+                    overlaps = overlaps || (this->m_realized[other].slot == candidate &&
+                                            transient.firstPass <= otherTransient.lastPass &&
+                                            otherTransient.firstPass <= transient.lastPass);
+                }
+                slot = overlaps ? INVALID_IMAGE : candidate;
+            }
+
+            if (slot == INVALID_IMAGE)
+            {
+                slot = static_cast<uint32_t>(this->m_slots.size());
+                this->m_slots.push_back({nullptr, requirements[index], {}});
+            }
+            else
+            {
+                VkMemoryRequirements &slotRequirements = this->m_slots[slot].requirements;
+                slotRequirements.size = std::max(slotRequirements.size, requirements[index].size);
+                slotRequirements.alignment = std::max(slotRequirements.alignment, requirements[index].alignment);
+                slotRequirements.memoryTypeBits &= requirements[index].memoryTypeBits;
+            }
+            this->m_realized[index].slot = slot;
+        }
+
+        VmaAllocationCreateInfo allocationInfo{};
+        allocationInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        for (MemorySlot &slot : this->m_slots)
+        {
+            HUSH_VK_ASSERT(vmaAllocateMemory(this->m_allocator, &slot.requirements, &allocationInfo, &slot.allocation,
+                                             nullptr),
+                           "Allocating render graph transient memory failed!");
+        }
+        for (uint32_t index : order)
+        {
+            RealizedImage &realized = this->m_realized[index];
+            const RenderGraphImageDesc &desc = this->m_transients[index].desc;
+            VmaAllocation allocation = this->m_slots[realized.slot].allocation;
+            HUSH_VK_ASSERT(vmaBindImageMemory(this->m_allocator, allocation, realized.image),
+                           "Binding a transient render graph image failed!");
+            VkImageViewCreateInfo viewInfo =
+                VkUtilsFactory::CreateImageViewCreateInfo(desc.format, realized.image, desc.aspect);
+            HUSH_VK_ASSERT(vkCreateImageView(this->m_device, &viewInfo, nullptr, &realized.view),
+                           "Creating a transient render graph image view failed!");
+        }
+        LogFormat(ELogLevel::Debug, "Render graph realized {} transient images in {} allocations", order.size(),
+                  this->m_slots.size());
+    }
+
+    for (Image &image : this->m_images)
+    {
+        if (image.transient != INVALID_IMAGE)
+        {
+            image.image = this->m_realized[image.transient].image;
+            image.view = this->m_realized[image.transient].view;
+        }
+    }
+    for (const RealizedImage &realized : this->m_realized)
+    {
+        if (realized.image != nullptr)
+        {
+            this->m_stats.transientImages++;
+            this->m_stats.unaliasedBytes += realized.size;
+        }
+    }
+    this->m_stats.transientAllocations = static_cast<uint32_t>(this->m_slots.size());
+    for (const MemorySlot &slot : this->m_slots)
+    {
+        this->m_stats.transientBytes += slot.requirements.size;
+    }
+}
+
+void Hush::VulkanRenderGraph::TrackUse(Image &image, VkPipelineStageFlags2 stages, VkAccessFlags2 access,
+                                       VkImageLayout layout, bool write)
+{
+    TrackedState &tracked = image.tracked;
+    bool layoutChange = layout != tracked.layout;
+
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.dstStageMask = stages;
+    barrier.dstAccessMask = access;
+    barrier.oldLayout = tracked.layout;
+    barrier.newLayout = layout;
+    barrier.image = image.image;
+    barrier.subresourceRange = VkUtilsFactory::ImageSubResourceRange(image.aspect);
+
+    if (write || layoutChange)
+    {
+        // Write after read only needs the reads to finish, write after write also needs the last write available
+        barrier.srcStageMask = tracked.writeStages | tracked.readStages;
+        barrier.srcAccessMask = tracked.writeAccess;
+        if (layoutChange || barrier.srcStageMask != VK_PIPELINE_STAGE_2_NONE)
+        {
+            this->m_barriers.push_back(barrier);
+        }
+        tracked.layout = layout;
+        if (write)
+        {
+            tracked.writeStages = stages;
+            tracked.writeAccess = access & WRITE_ACCESS;
+            tracked.readStages = VK_PIPELINE_STAGE_2_NONE;
+            tracked.visibleStages = VK_PIPELINE_STAGE_2_NONE;
+            tracked.visibleAccess = VK_ACCESS_2_NONE;
+        }
+        else
+        {
+            // The layout transition counts as a write, already visible to the read that asked for it
+            tracked.writeStages = stages;
+            tracked.writeAccess = VK_ACCESS_2_NONE;
+            tracked.readStages = stages;
+            tracked.visibleStages = stages;
+            tracked.visibleAccess = access;
+        }
+        return;
+    }
+
+    // Read after read in the same layout is free, a read only waits on a write it can't see yet
+    bool visible = (stages & ~tracked.visibleStages) == 0u && (access & ~tracked.visibleAccess) == 0u;
+    if (tracked.writeStages != VK_PIPELINE_STAGE_2_NONE && !visible)
+    {
+        barrier.srcStageMask = tracked.writeStages;
+        barrier.srcAccessMask = tracked.writeAccess;
+        this->m_barriers.push_back(barrier);
+        tracked.visibleStages |= stages;
+        tracked.visibleAccess |= access;
+    }
+    tracked.readStages |= stages;
+}
+
+void Hush::VulkanRenderGraph::FlushBarriers(VkCommandBuffer cmd)
+{
+    if (this->m_barriers.empty())
+    {
+        return;
+    }
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(this->m_barriers.size());
+    dependencyInfo.pImageMemoryBarriers = this->m_barriers.data();
+    vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+
+    this->m_stats.barrierBatches++;
+    this->m_stats.imageBarriers += static_cast<uint32_t>(this->m_barriers.size());
+    this->m_barriers.clear();
+}
+
+void Hush::VulkanRenderGraph::DestroyRealized(std::vector<RealizedImage> &images,
+                                              std::vector<MemorySlot> &slots) noexcept
+{
+    for (const RealizedImage &realized : images)
+    {
+        if (realized.image != nullptr)
+        {
+            vkDestroyImageView(this->m_device, realized.view, nullptr);
+            vkDestroyImage(this->m_device, realized.image, nullptr);
+        }
+    }
+    for (const MemorySlot &slot : slots)
+    {
+        vmaFreeMemory(this->m_allocator, slot.allocation);
+    }
+    images.clear();
+    slots.clear();
+}
@@ -0,0 +1,299 @@
+/*! \file VulkanRenderGraph.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Frame graph of passes that declare the images they use, the graph records the barriers between them
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include "vk_mem_alloc.hpp"
+#include <memory/LinearAllocator.hpp>
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    class GpuTimestampQueries;
+    class VulkanRenderGraph;
+
+    /// @brief How a pass uses an image, picks the layout and the exact stages and accesses its barriers wait on
+    enum class ERenderGraphAccess : uint8_t
+    {
+        /// @brief Storage image written by a compute shader, GENERAL layout
+        ComputeStorageWrite,
+        /// @brief Storage image read by a compute shader, GENERAL layout
+        ComputeStorageRead,
+        ComputeSampledRead,
+        FragmentSampledRead,
+        /// @brief Loaded and stored by a rendering pass, counts as a write
+        ColorAttachment,
+        DepthAttachment,
+        /// @brief Depth tested without writes
+        DepthRead,
+        TransferSource,
+        TransferDestination,
+        /// @brief Only valid as a final access, see VulkanRenderGraph::SetFinalAccess
+        Present,
+        Count
+    };
+
+    /// @brief Index of an image in the graph it was added to, only valid until the graph's next Reset
+    using RenderGraphImage = uint32_t;
+
+    /// @brief Where an imported image was left by its last use, so the next graph that imports it knows what to
+    /// wait on. Setting the layout to UNDEFINED before importing discards the contents
+    struct RenderGraphImageState
+    {
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        /// @brief Stages the next use has to wait for
+        VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE;
+        /// @brief Writes the next use has to make available
+        VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+    };
+
+    /// @brief Transient image owned by the graph, its usage flags come from the accesses the passes declare
+    struct RenderGraphImageDesc
+    {
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkExtent3D extent{};
+        VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+    };
+
+    /// @brief Returned by VulkanRenderGraph::AddPass to declare what the pass reads and writes
+    class RenderGraphPassBuilder
+    {
+      public:
+        RenderGraphPassBuilder &Read(RenderGraphImage image, ERenderGraphAccess access);
+
+        RenderGraphPassBuilder &Write(RenderGraphImage image, ERenderGraphAccess access);
+
+        /// @brief Keeps the pass even when nothing uses what it writes, for work the graph doesn't track (e.g.
+        /// buffer writes or queries)
+        RenderGraphPassBuilder &SetSideEffects();
+
+      private:
+        friend class VulkanRenderGraph;
+
+        RenderGraphPassBuilder(VulkanRenderGraph &graph, uint32_t pass) noexcept : m_graph(graph), m_pass(pass)
+        {
+        }
+
+        VulkanRenderGraph &m_graph;
+        uint32_t m_pass;
+    };
+
+    /// @brief Rebuilt every frame: images are imported or created, passes are added in submission order along with
+    /// the images they use, then Execute records them into one command buffer.
+    /// Execute culls the passes whose results nothing needs, then records each kept pass after a single batched
+    /// vkCmdPipelineBarrier2 holding only the image barriers its uses require, with the stages and accesses of those
+    /// uses instead of ALL_COMMANDS. Reads that follow reads in the same layout get no barrier at all.
+    /// Transient images live from their first to their last kept pass, images whose lifetimes don't overlap share
+    /// memory. Their VkImages are cached while the frames keep declaring the same ones, and retired by frame timeline
+    /// value once they change (see Retire). Buffers are not tracked, passes still sync those themselves
+    class VulkanRenderGraph
+    {
+      public:
+        static constexpr RenderGraphImage INVALID_IMAGE = UINT32_MAX;
+
+        /// @brief Counts of the last Execute
+        struct Stats
+        {
+            uint32_t passCount = 0u;
+            uint32_t culledPasses = 0u;
+            uint32_t barrierBatches = 0u;
+            uint32_t imageBarriers = 0u;
+            uint32_t transientImages = 0u;
+            /// @brief Memory allocations backing the transient images, lower than transientImages when they alias
+            uint32_t transientAllocations = 0u;
+            VkDeviceSize transientBytes = 0u;
+            /// @brief What the transient images would take without aliasing
+            VkDeviceSize unaliasedBytes = 0u;
+        };
+
+        void Init(VkDevice device, VmaAllocator allocator);
+
+        /// @brief Destroys every transient image right away, the GPU must be idle
+        void Dispose() noexcept;
+
+        /// @brief Drops the passes and images of the last frame, call before building the next one
+        void Reset() noexcept;
+
+        /// @brief Adds an image the graph doesn't own. state is read now and written back by Execute, it has to
+        /// outlive it
+        /// @param name must have static storage duration
+        RenderGraphImage ImportImage(const char *name, VkImage image, VkImageView view, VkImageAspectFlags aspect,
+                                     RenderGraphImageState *state);
+
+        /// @brief Adds an image owned by the graph, its contents are undefined at its first use
+        /// @param name must have static storage duration
+        RenderGraphImage CreateImage(const char *name, const RenderGraphImageDesc &desc);
+
+        /// @brief Access the image is left in once the graph is done, e.g. Present for the swapchain image. Imported
+        /// images with a final access are never culled
+        void SetFinalAccess(RenderGraphImage image, ERenderGraphAccess access);
+
+        /// @brief Adds a pass recorded by execute(VkCommandBuffer). The callback is copied into the graph's arena and
+        /// never destroyed, so it has to be trivially destructible (a lambda capturing references or pointers)
+        /// @param name must have static storage duration, it also names the pass's GPU timestamp scope
+        template <class F> RenderGraphPassBuilder AddPass(const char *name, F &&execute)
+        {
+            using Function = std::remove_cv_t<std::remove_reference_t<F>>;
+            static_assert(std::is_trivially_destructible_v<Function>,
+                          "Render graph passes are never destroyed, capture references or pointers only");
+            void *closure = this->m_arena.Allocate(sizeof(Function), alignof(Function));
+            new (closure) Function(std::forward<F>(execute));
+            return this->AddPassInternal(
+                name, [](void *data, VkCommandBuffer cmd) { (*static_cast<Function *>(data))(cmd); }, closure);
+        }
+
+        /// @brief Valid while the passes are recorded, transient images only get one inside Execute
+        [[nodiscard]] VkImage GetImage(RenderGraphImage image) const;
+
+        [[nodiscard]] VkImageView GetImageView(RenderGraphImage image) const;
+
+        /// @brief Culls, allocates the transient images and records every kept pass with its barriers
+        /// @param retireValue frame timeline value of the submission cmd belongs to, transient images replaced this
+        /// frame are destroyed once Retire sees it completed
+        /// @param timestamps every pass is timed in its own scope when set
+        void Execute(VkCommandBuffer cmd, uint64_t retireValue, GpuTimestampQueries *timestamps = nullptr);
+
+        /// @brief Destroys the transient images replaced with a retire value <= completedValue
+        void Retire(uint64_t completedValue);
+
+        [[nodiscard]] Stats GetStats() const noexcept;
+
+      private:
+        friend class RenderGraphPassBuilder;
+
+        using PassFunction = void (*)(void *closure, VkCommandBuffer cmd);
+
+        /// @brief What the passes recorded so far did to an image
+        struct TrackedState
+        {
+            VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            VkPipelineStageFlags2 writeStages = VK_PIPELINE_STAGE_2_NONE;
+            VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+            /// @brief Reads since the last write, the next write waits for them too
+            VkPipelineStageFlags2 readStages = VK_PIPELINE_STAGE_2_NONE;
+            /// @brief Where the last write is already visible, reads there need no barrier
+            VkPipelineStageFlags2 visibleStages = VK_PIPELINE_STAGE_2_NONE;
+            VkAccessFlags2 visibleAccess = VK_ACCESS_2_NONE;
+        };
+
+        struct Image
+        {
+            const char *name;
+            VkImage image;
+            VkImageView view;
+            VkImageAspectFlags aspect;
+            /// @brief nullptr for transient images
+            RenderGraphImageState *importedState;
+            /// @brief Index in m_transients, INVALID_IMAGE for imported images
+            uint32_t transient;
+            ERenderGraphAccess finalAccess;
+            bool hasFinalAccess;
+            TrackedState tracked;
+        };
+
+        struct Pass
+        {
+            const char *name;
+            PassFunction execute;
+            void *closure;
+            bool sideEffects;
+            bool culled;
+        };
+
+        /// @brief Uses of the same image in one pass are merged into one, so they must agree on the layout
+        struct ImageUse
+        {
+            uint32_t pass;
+            RenderGraphImage image;
+            VkPipelineStageFlags2 stages;
+            VkAccessFlags2 access;
+            VkImageLayout layout;
+            bool write;
+        };
+
+        struct TransientImage
+        {
+            RenderGraphImageDesc desc;
+            VkImageUsageFlags usage;
+            /// @brief Kept passes, INVALID_IMAGE (no pass) until Execute computes them
+            uint32_t firstPass;
+            uint32_t lastPass;
+        };
+
+        /// @brief VkImage created for a TransientImage, and the memory slot it is bound to
+        struct RealizedImage
+        {
+            VkImage image;
+            VkImageView view;
+            VkDeviceSize size;
+            uint32_t slot;
+        };
+
+        /// @brief Memory shared by transient images whose lifetimes don't overlap
+        struct MemorySlot
+        {
+            VmaAllocation allocation;
+            VkMemoryRequirements requirements;
+            /// @brief Left by the last image that used the slot, the next one waits on it before its first use
+            RenderGraphImageState endState;
+        };
+
+        struct PendingDestroy
+        {
+            std::vector<RealizedImage> images;
+            std::vector<MemorySlot> slots;
+            uint64_t retireValue;
+        };
+
+        RenderGraphPassBuilder AddPassInternal(const char *name, PassFunction execute, void *closure);
+
+        void AddUse(uint32_t pass, RenderGraphImage image, ERenderGraphAccess access, bool write);
+
+        /// @brief Appends the barrier a use needs to m_barriers, if any, and tracks the use
+        void TrackUse(Image &image, VkPipelineStageFlags2 stages, VkAccessFlags2 access, VkImageLayout layout,
+                      bool write);
+
+        /// @brief Sorts the uses by pass and merges the ones of the same image in a pass
+        void CompileUses();
+
+        void CullPasses();
+
+        /// @brief Creates the transient images, or reuses last frame's if the graph declared the same ones
+        void RealizeTransients(uint64_t retireValue);
+
+        void FlushBarriers(VkCommandBuffer cmd);
+
+        void DestroyRealized(std::vector<RealizedImage> &images, std::vector<MemorySlot> &slots) noexcept;
+
+        VkDevice m_device = nullptr;
+        VmaAllocator m_allocator = nullptr;
+
+        /// @brief Pass callbacks, reset with the graph
+        LinearAllocator m_arena{16u * 1024u};
+        std::vector<Image> m_images;
+        std::vector<Pass> m_passes;
+        std::vector<ImageUse> m_uses;
+        std::vector<TransientImage> m_transients;
+        /// @brief Per image, set while culling once a kept pass uses it
+        std::vector<uint8_t> m_imageNeeded;
+        std::vector<VkImageMemoryBarrier2> m_barriers;
+
+        /// @brief Hash of the transients m_realized was created for
+        uint64_t m_realizedKey = 0u;
+        std::vector<RealizedImage> m_realized;
+        std::vector<MemorySlot> m_slots;
+        /// @brief Ordered by retire value
+        std::vector<PendingDestroy> m_pendingDestroys;
+
+        Stats m_stats{};
+    };
+} // namespace Hush
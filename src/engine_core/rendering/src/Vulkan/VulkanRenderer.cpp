@@ -7,8 +7,10 @@
 #define VMA_IMPLEMENTATION
 #define VK_NO_PROTOTYPES
 #include "VulkanRenderer.hpp"
+#include "JobSystem.hpp"
 #include "Logger.hpp"
 #include "Platform.hpp"
+#include "Profiler.hpp"
 #include "WindowManager.hpp"
 
 #include "Vulkan/VkTypes.hpp"
@@ -26,6 +28,9 @@
 #include "VulkanPipelineBuilder.hpp"
 #include "vk_mem_alloc.hpp"
 #include <typeutils/TypeUtils.hpp>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
 #include <volk.h>
 #include <vulkan/vulkan_core.h>
 
@@ -37,7 +42,8 @@ PFN_vkVoidFunction Hush::VulkanRenderer::CustomVulkanFunctionLoader(const char *
 }
 
 Hush::VulkanRenderer::VulkanRenderer(void *windowContext)
-    : Hush::IRenderer(windowContext), m_windowContext(windowContext), m_globalDescriptorAllocator()
+    : Hush::IRenderer(windowContext), m_windowContext(windowContext), m_globalDescriptorAllocator(),
+      m_isHeadless(windowContext == nullptr)
 {
     LogTrace("Initializing Vulkan");
 
@@ -54,6 +60,8 @@ Hush::VulkanRenderer::VulkanRenderer(void *windowContext)
             //.enable_extension(VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME)
             // TODO: We might use a lower version for some platforms such as Android
             .require_api_version(1, 3, 0)
+            // Headless skips the surface extensions, so it runs where there's no display at all
+            .set_headless(this->m_isHeadless)
             .build();
 
     HUSH_ASSERT(instanceResult, "Cannot load instance: {}", instanceResult.error().message());
@@ -65,11 +73,15 @@ Hush::VulkanRenderer::VulkanRenderer(void *windowContext)
     this->m_vulkanInstance = vkbInstance.instance;
     this->m_debugMessenger = vkbInstance.debug_messenger;
     volkLoadInstance(this->m_vulkanInstance);
-    auto *sdlWindowContext = static_cast<SDL_Window *>(windowContext);
-    // Creates the Vulkan Surface from the SDL window context
-    SDL_bool createSurfaceResult = SDL_Vulkan_CreateSurface(sdlWindowContext, this->m_vulkanInstance, &this->m_surface);
-    HUSH_ASSERT(createSurfaceResult == SDL_TRUE, "Cannot create vulkan surface, error: {}!", SDL_GetError());
-    LogTrace("Initialized vulkan surface");
+    if (!this->m_isHeadless)
+    {
+        auto *sdlWindowContext = static_cast<SDL_Window *>(windowContext);
+        // Creates the Vulkan Surface from the SDL window context
+        SDL_bool createSurfaceResult =
+            SDL_Vulkan_CreateSurface(sdlWindowContext, this->m_vulkanInstance, &this->m_surface);
+        HUSH_ASSERT(createSurfaceResult == SDL_TRUE, "Cannot create vulkan surface, error: {}!", SDL_GetError());
+        LogTrace("Initialized vulkan surface");
+    }
     // Configure our renderer with the proper extensions / device properties, etc.
     this->Configure(vkbInstance);
     this->LoadDebugMessenger();
@@ -80,7 +92,8 @@ Hush::VulkanRenderer::VulkanRenderer(VulkanRenderer &&rhs) noexcept
       m_vulkanPhysicalDevice(rhs.m_vulkanPhysicalDevice), m_debugMessenger(rhs.m_debugMessenger),
       m_device(rhs.m_device), m_surface(rhs.m_surface), m_swapChain(rhs.m_swapChain),
       m_swapchainImageFormat(rhs.m_swapchainImageFormat), m_swapchainImages(std::move(rhs.m_swapchainImages)),
-      m_swapchainImageViews(std::move(rhs.m_swapchainImageViews)), m_swapChainExtent(rhs.m_swapChainExtent)
+      m_swapchainImageViews(std::move(rhs.m_swapchainImageViews)), m_swapChainExtent(rhs.m_swapChainExtent),
+      m_isHeadless(rhs.m_isHeadless)
 {
     rhs.m_vulkanInstance = nullptr;
     rhs.m_vulkanPhysicalDevice = nullptr;
@@ -109,6 +122,7 @@ Hush::VulkanRenderer &Hush::VulkanRenderer::operator=(VulkanRenderer &&rhs) noex
         this->m_swapchainImages = std::move(rhs.m_swapchainImages);
         this->m_swapchainImageViews = std::move(rhs.m_swapchainImageViews);
         this->m_swapChainExtent = rhs.m_swapChainExtent;
+        this->m_isHeadless = rhs.m_isHeadless;
 
         rhs.m_vulkanInstance = nullptr;
         rhs.m_vulkanPhysicalDevice = nullptr;
@@ -133,28 +147,43 @@ Hush::VulkanRenderer::~VulkanRenderer()
 // Called on resize and window init
 void Hush::VulkanRenderer::CreateSwapChain(uint32_t width, uint32_t height)
 {
-    vkb::SwapchainBuilder swapchainBuilder{m_vulkanPhysicalDevice, m_device, m_surface};
+    this->m_width = width;
+    this->m_height = height;
+    // Headless renders straight into the draw image, so that's the only target it needs
+    if (this->m_isHeadless)
+    {
+        this->m_swapChainExtent = VkExtent2D{width, height};
+    }
+    else
+    {
+        vkb::SwapchainBuilder swapchainBuilder{m_vulkanPhysicalDevice, m_device, m_surface};
 
-    this->m_swapchainImageFormat = VK_FORMAT_B8G8R8A8_UNORM;
+        this->m_swapchainImageFormat = VK_FORMAT_B8G8R8A8_UNORM;
 
-    auto vkSurfaceFormat = VkSurfaceFormatKHR{};
-    vkSurfaceFormat.format = this->m_swapchainImageFormat;
-    vkSurfaceFormat.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+        auto vkSurfaceFormat = VkSurfaceFormatKHR{};
+        vkSurfaceFormat.format = this->m_swapchainImageFormat;
+        vkSurfaceFormat.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
 
-    vkb::Swapchain vkbSwapChain = swapchainBuilder.set_desired_format(vkSurfaceFormat)
-                                      .set_desired_present_mode(VK_PRESENT_MODE_FIFO_KHR)
-                                      .set_desired_extent(width, height)
-                                      .add_image_usage_flags(VK_IMAGE_USAGE_TRANSFER_DST_BIT)
-                                      .build()
-                                      .value();
+        vkb::Swapchain vkbSwapChain = swapchainBuilder.set_desired_format(vkSurfaceFormat)
+                                          .set_desired_present_mode(VK_PRESENT_MODE_FIFO_KHR)
+                                          .set_desired_extent(width, height)
+                                          .add_image_usage_flags(VK_IMAGE_USAGE_TRANSFER_DST_BIT)
+                                          .build()
+                                          .value();
 
-    this->m_width = width;
-    this->m_height = height;
-    this->m_swapChainExtent = vkbSwapChain.extent;
-    this->m_swapChain = vkbSwapChain.swapchain;
-    this->m_swapchainImages = vkbSwapChain.get_images().value();
-    this->m_swapchainImageViews = vkbSwapChain.get_image_views().value();
+        this->m_swapChainExtent = vkbSwapChain.extent;
+        this->m_swapChain = vkbSwapChain.swapchain;
+        this->m_swapchainImages = vkbSwapChain.get_images().value();
+        this->m_swapchainImageViews = vkbSwapChain.get_image_views().value();
+    }
     //> Init_Swapchain
+    // Resizing replaces the draw image, the old one might still be in use by the frames in flight
+    if (this->m_drawImage.image != nullptr)
+    {
+        this->DestroyAfterFrame(this->m_drawImage.imageView);
+        this->DestroyAfterFrame(this->m_drawImage.image, this->m_drawImage.allocation);
+    }
+
     // draw image size will match the window
     VkExtent3D drawImageExtent = {this->m_width, this->m_height, 1};
 
@@ -187,11 +216,35 @@ void Hush::VulkanRenderer::CreateSwapChain(uint32_t width, uint32_t height)
     HUSH_VK_ASSERT(vkCreateImageView(this->m_device, &rViewInfo, nullptr, &this->m_drawImage.imageView),
                    "Failed to create image view");
 
-    // add to deletion queues
-    this->m_mainDeletionQueue.PushFunction([=]() {
-        vkDestroyImageView(m_device, m_drawImage.imageView, nullptr);
-        vmaDestroyImage(m_allocator, m_drawImage.image, m_drawImage.allocation);
-    });
+    // The background's set still points at the old view after a resize, ResizeSwapchain waited for the GPU so it's
+    // rewritten in place. On the first call it doesn't exist yet, InitDescriptors writes it
+    if (this->m_drawImageDescriptors != nullptr)
+    {
+        DescriptorWriter writer;
+        writer.WriteImage(0, this->m_drawImage.imageView, nullptr, VK_IMAGE_LAYOUT_GENERAL,
+                          VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+        writer.UpdateSet(this->m_device, this->m_drawImageDescriptors);
+    }
+
+    // The depth image matches the draw image, and is replaced the same way
+    if (this->m_depthImage.image != nullptr)
+    {
+        this->DestroyAfterFrame(this->m_depthImage.imageView);
+        this->DestroyAfterFrame(this->m_depthImage.image, this->m_depthImage.allocation);
+    }
+    this->m_depthImage.imageFormat = VK_FORMAT_D32_SFLOAT;
+    this->m_depthImage.imageExtent = drawImageExtent;
+    // Sampled by the depth pyramid reduction
+    VkImageCreateInfo depthImageInfo = VkUtilsFactory::CreateImageCreateInfo(
+        this->m_depthImage.imageFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        drawImageExtent);
+    HUSH_VK_ASSERT(vmaCreateImage(this->m_allocator, &depthImageInfo, &rimgAllocInfo, &this->m_depthImage.image,
+                                  &this->m_depthImage.allocation, nullptr),
+                   "Depth image creation failed!");
+    VkImageViewCreateInfo depthViewInfo = VkUtilsFactory::CreateImageViewCreateInfo(
+        this->m_depthImage.imageFormat, this->m_depthImage.image, VK_IMAGE_ASPECT_DEPTH_BIT);
+    HUSH_VK_ASSERT(vkCreateImageView(this->m_device, &depthViewInfo, nullptr, &this->m_depthImage.imageView),
+                   "Failed to create depth image view");
     //< Init_Swapchain
 }
 
@@ -211,7 +264,7 @@ void Hush::VulkanRenderer::InitializeCommands() noexcept
     rc = vkAllocateCommandBuffers(this->m_device, &cmdAllocInfo, &this->m_immediateCommandBuffer);
     HUSH_VK_ASSERT(rc, "Allocating immidiate command buffers failed!");
 
-    this->m_mainDeletionQueue.PushFunction([=]() { vkDestroyCommandPool(m_device, m_immediateCommandPool, nullptr); });
+    this->m_mainDeletionQueue.Push(this->m_immediateCommandPool);
 
     for (int32_t i = 0; i < FRAME_OVERLAP; i++)
     {
@@ -223,22 +276,38 @@ void Hush::VulkanRenderer::InitializeCommands() noexcept
         cmdAllocInfo = VkUtilsFactory::CreateCommandBufferAllocateInfo(this->m_frames.at(i).commandPool);
         rc = vkAllocateCommandBuffers(this->m_device, &cmdAllocInfo, &this->m_frames.at(i).mainCommandBuffer);
         HUSH_VK_ASSERT(rc, "Allocating command buffers failed!");
-        this->m_mainDeletionQueue.PushFunction(
-            [=]() { vkDestroyCommandPool(m_device, m_frames.at(i).commandPool, nullptr); });
+        this->m_mainDeletionQueue.Push(this->m_frames.at(i).commandPool);
     }
 }
 
 void Hush::VulkanRenderer::InitImGui()
 {
+    if (this->m_isHeadless)
+    {
+        LogWarn("ImGui needs a window, headless renderers don't draw any UI");
+        return;
+    }
     this->m_uiForwarder = std::make_unique<VulkanImGuiForwarder>();
     this->m_uiForwarder->SetupImGui(this);
 }
 
 void Hush::VulkanRenderer::Draw()
 {
+    HUSH_PROFILE_SCOPE("VulkanRenderer::Draw");
     if (this->m_resizeRequested) {
         this->ResizeSwapchain();
     }
+    // Take the newest frame from the game thread, if there's none we keep drawing the last one
+    if (this->m_snapshots.Consume() && this->m_threadedRendering)
+    {
+        // Same as RenderThread's wake up, the lock keeps PublishFrame from missing it
+        {
+            std::lock_guard lock(this->m_snapshotMutex);
+        }
+        this->m_snapshotConsumed.notify_one();
+    }
+    const RenderSnapshot &snapshot = this->m_snapshots.GetReadBuffer();
+
     //Prepare and flush the render command
     FrameData &currentFrame = this->GetCurrentFrame();
     uint32_t swapchainImageIndex = 0u;
@@ -247,29 +316,156 @@ void Hush::VulkanRenderer::Draw()
     if (cmd == nullptr) {
         return;
     }
+    // Hands the uploads queued since the last frame to the transfer queue, this frame waits for them
+    uint64_t uploadWaitValue = this->m_uploadManager.SubmitPending(cmd);
+
+    // Read by every draw of the frame, the frame's previous submission is done with the buffer
+    const DrawContext &drawContext = snapshot.drawContext;
+    GPUSceneData sceneData{};
+    sceneData.viewProjection = drawContext.viewProjection.value_or(glm::mat4(1.0f));
+    currentFrame.sceneData.Write(&sceneData, sizeof(GPUSceneData));
+
+    // The gpu driven objects are written out now, the cull passes below turn them into indirect draws
+    uint32_t frameIndex = this->m_frameNumber % FRAME_OVERLAP;
+    uint32_t gpuDrivenObjects = 0u;
+    bool occlusionCulling = false;
+    if (this->m_gpuCuller.IsAvailable())
+    {
+        std::optional<GpuOcclusionInputs> occlusion;
+        if (this->m_depthPyramid.IsAvailable() && drawContext.viewProjection.has_value())
+        {
+            occlusion = this->PrepareDepthPyramid(*drawContext.viewProjection);
+        }
+        gpuDrivenObjects = this->m_gpuCuller.Prepare(frameIndex, drawContext.opaqueSurfaces,
+                                                     drawContext.cullingFrustum, occlusion, this->m_cpuSurfaces,
+                                                     this->m_frameDeletionQueue,
+                                                     this->m_frameTimeline.GetLastSubmittedValue() + 1u);
+        occlusionCulling = occlusion.has_value() && gpuDrivenObjects > 0u;
+    }
+    // Room for every bindless object the geometry passes may record from the CPU, they could all be instanced
+    uint32_t cpuInstances = 0u;
+    for (const RenderObject &surface : drawContext.transparentSurfaces)
+    {
+        cpuInstances += VulkanDrawInstancer::Accepts(surface) ? 1u : 0u;
+    }
+    if (gpuDrivenObjects > 0u)
+    {
+        for (uint32_t index : this->m_cpuSurfaces)
+        {
+            cpuInstances += VulkanDrawInstancer::Accepts(drawContext.opaqueSurfaces[index]) ? 1u : 0u;
+        }
+    }
+    else
+    {
+        for (const RenderObject &surface : drawContext.opaqueSurfaces)
+        {
+            cpuInstances += VulkanDrawInstancer::Accepts(surface) ? 1u : 0u;
+        }
+    }
+    this->m_drawInstancer.BeginFrame(frameIndex, cpuInstances);
 
-    VkImage currentImage = this->m_swapchainImages.at(swapchainImageIndex);
-    
-    this->TransitionImage(cmd, this->m_drawImage.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
-    this->DrawBackground(cmd);
-    //Transition
-	this->TransitionImage(cmd, this->m_drawImage.image, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-	//TODO: Restore when we actually care about depth stuff
-    //this->TransitionImage(cmd, this->m_drawImage.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL);
-    //Geometry
-    this->DrawGeometry(cmd);
-
-	//transtion the draw image and the swapchain image into their correct transfer layouts
-	this->TransitionImage(cmd, this->m_drawImage.image, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-	this->TransitionImage(cmd, currentImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-    this->CopyImageToImage(cmd, this->m_drawImage.image, currentImage, { this->m_width, this->m_height }, this->m_swapChainExtent);
-    this->TransitionImage(cmd, currentImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-    
-    //UI
-    this->DrawUI(cmd, this->m_swapchainImageViews[swapchainImageIndex]);
-    // set swapchain image layout to Present so we can draw it
-    this->TransitionImage(cmd, currentImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    // The passes declare what they do to each image, the graph records the layout transitions and barriers
+    VulkanRenderGraph &graph = this->m_renderGraph;
+    graph.Reset();
+    if (gpuDrivenObjects > 0u)
+    {
+        // Only buffers, which the graph doesn't track, RecordCull waits for its own writes
+        graph
+            .AddPass("GpuCull",
+                     [this, frameIndex](VkCommandBuffer passCmd) {
+                         this->m_gpuCuller.RecordCull(passCmd, frameIndex, EGpuCullPhase::Early);
+                     })
+            .SetSideEffects();
+    }
+    // The background rewrites every pixel, last frame's contents can be dropped
+    this->m_drawImageState.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    RenderGraphImage drawImage = graph.ImportImage("DrawImage", this->m_drawImage.image, this->m_drawImage.imageView,
+                                                   VK_IMAGE_ASPECT_COLOR_BIT, &this->m_drawImageState);
+    // Cleared by the first geometry pass
+    this->m_depthImageState.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    RenderGraphImage depthImage = graph.ImportImage("DepthImage", this->m_depthImage.image,
+                                                    this->m_depthImage.imageView, VK_IMAGE_ASPECT_DEPTH_BIT,
+                                                    &this->m_depthImageState);
+
+    graph.AddPass("DrawBackground", [this](VkCommandBuffer passCmd) { this->DrawBackground(passCmd); })
+        .Write(drawImage, ERenderGraphAccess::ComputeStorageWrite);
+    graph
+        .AddPass("DrawGeometry",
+                 [this, &snapshot, occlusionCulling](VkCommandBuffer passCmd) {
+                     this->DrawGeometry(passCmd, snapshot.drawContext, EGpuCullPhase::Early, !occlusionCulling);
+                 })
+        .Write(drawImage, ERenderGraphAccess::ColorAttachment)
+        .Write(depthImage, ERenderGraphAccess::DepthAttachment);
+    if (occlusionCulling)
+    {
+        // What the early phase drew is reduced into the pyramid, the late phase tests the rest against it and draws
+        // what it didn't hide
+        this->m_depthPyramidState.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        RenderGraphImage depthPyramid = graph.ImportImage("DepthPyramid", this->m_depthPyramid.GetImage(),
+                                                          this->m_depthPyramid.GetImageView(),
+                                                          VK_IMAGE_ASPECT_COLOR_BIT, &this->m_depthPyramidState);
+        graph
+            .AddPass("BuildDepthPyramid",
+                     [this, &currentFrame](VkCommandBuffer passCmd) {
+                         this->m_depthPyramid.RecordBuild(passCmd, this->m_depthImage.imageView,
+                                                          currentFrame.frameDescriptors);
+                     })
+            .Read(depthImage, ERenderGraphAccess::ComputeSampledRead)
+            .Write(depthPyramid, ERenderGraphAccess::ComputeStorageWrite);
+        graph
+            .AddPass("GpuOcclusionCull",
+                     [this, frameIndex](VkCommandBuffer passCmd) {
+                         this->m_gpuCuller.RecordCull(passCmd, frameIndex, EGpuCullPhase::Late);
+                     })
+            .Read(depthPyramid, ERenderGraphAccess::ComputeSampledRead)
+            .SetSideEffects();
+        graph
+            .AddPass("DrawLateGeometry",
+                     [this, &snapshot](VkCommandBuffer passCmd) {
+                         this->DrawGeometry(passCmd, snapshot.drawContext, EGpuCullPhase::Late, true);
+                     })
+            .Write(drawImage, ERenderGraphAccess::ColorAttachment)
+            .Write(depthImage, ERenderGraphAccess::DepthAttachment);
+    }
+
+    // Chained to the stage the acquire semaphore is waited on, so the first transition happens after the acquire
+    RenderGraphImageState swapchainState{VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                         VK_ACCESS_2_NONE};
+    if (this->m_isHeadless)
+    {
+        // Same layout the windowed path leaves it in, ReadbackDrawImage copies from it
+        graph.SetFinalAccess(drawImage, ERenderGraphAccess::TransferSource);
+    }
+    else
+    {
+        VkImage currentImage = this->m_swapchainImages.at(swapchainImageIndex);
+        VkImageView currentImageView = this->m_swapchainImageViews[swapchainImageIndex];
+        RenderGraphImage swapchainImage = graph.ImportImage("SwapchainImage", currentImage, currentImageView,
+                                                            VK_IMAGE_ASPECT_COLOR_BIT, &swapchainState);
+
+        graph
+            .AddPass("CopyImageToImage",
+                     [this, currentImage](VkCommandBuffer passCmd) {
+                         this->CopyImageToImage(passCmd, this->m_drawImage.image, currentImage,
+                                                {this->m_width, this->m_height}, this->m_swapChainExtent);
+                     })
+            .Read(drawImage, ERenderGraphAccess::TransferSource)
+            .Write(swapchainImage, ERenderGraphAccess::TransferDestination);
+        graph
+            .AddPass("DrawUI",
+                     [this, currentImageView, &snapshot](VkCommandBuffer passCmd) {
+                         this->DrawUI(passCmd, currentImageView, snapshot.uiDrawData);
+                     })
+            .Write(swapchainImage, ERenderGraphAccess::ColorAttachment);
+        graph.SetFinalAccess(swapchainImage, ERenderGraphAccess::Present);
+    }
+    graph.Execute(cmd, this->m_frameTimeline.GetLastSubmittedValue() + 1u, &currentFrame.timestampQueries);
+
+    if (this->m_isHeadless)
+    {
+        this->SubmitHeadlessFrame(cmd, currentFrame, uploadWaitValue);
+        return;
+    }
 
     // finalize the command buffer (we can no longer add commands, but it can now be executed)
     HUSH_VK_ASSERT(vkEndCommandBuffer(cmd), "End command buffer failed!");
@@ -281,17 +477,28 @@ void Hush::VulkanRenderer::Draw()
 
     VkCommandBufferSubmitInfo cmdinfo = VkUtilsFactory::CreateCommandBufferSubmitInfo(cmd);
 
-    VkSemaphoreSubmitInfo waitInfo = VkUtilsFactory::CreateSemaphoreSubmitInfo(
-        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, currentFrame.swapchainSemaphore);
+    std::array<VkSemaphoreSubmitInfo, 2> waitInfos = {
+        VkUtilsFactory::CreateSemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR,
+                                                  currentFrame.swapchainSemaphore),
+        this->m_uploadManager.CreateWaitInfo(uploadWaitValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT)};
 
-    VkSemaphoreSubmitInfo signalInfo =
-        VkUtilsFactory::CreateSemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT, currentFrame.renderSemaphore);
+    // The binary semaphore gates the present, the timeline value tells the CPU when the frame is done
+    currentFrame.timelineValue = this->m_frameTimeline.Advance();
+    std::array<VkSemaphoreSubmitInfo, 2> signalInfos = {
+        VkUtilsFactory::CreateSemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT, currentFrame.renderSemaphore),
+        this->m_frameTimeline.CreateSignalInfo(currentFrame.timelineValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT)};
 
-    VkSubmitInfo2 submit = VkUtilsFactory::SubmitInfo(&cmdinfo, &signalInfo, &waitInfo);
+    VkSubmitInfo2 submit = VkUtilsFactory::SubmitInfo(&cmdinfo, nullptr, waitInfos.data());
+    submit.waitSemaphoreInfoCount = uploadWaitValue != 0u ? 2u : 1u;
+    submit.signalSemaphoreInfoCount = static_cast<uint32_t>(signalInfos.size());
+    submit.pSignalSemaphoreInfos = signalInfos.data();
 
     // submit command buffer to the queue and execute it.
-    //  _renderFence will now block until the graphic commands finish execution
-    HUSH_VK_ASSERT(vkQueueSubmit2(this->m_graphicsQueue, 1, &submit, currentFrame.renderFence), "Queue submit failed!");
+    currentFrame.submitTicks = Profiler::Now();
+    {
+        HUSH_PROFILE_SCOPE("VulkanRenderer::Submit");
+        HUSH_VK_ASSERT(vkQueueSubmit2(this->m_graphicsQueue, 1, &submit, nullptr), "Queue submit failed!");
+    }
 
     // prepare present
     //  this will put the image we just rendered to into the visible window.
@@ -307,7 +514,11 @@ void Hush::VulkanRenderer::Draw()
 
     presentInfo.pImageIndices = &swapchainImageIndex;
 
-    VkResult presentResult = vkQueuePresentKHR(this->m_graphicsQueue, &presentInfo);
+    VkResult presentResult = VK_SUCCESS;
+    {
+        HUSH_PROFILE_SCOPE("VulkanRenderer::Present");
+        presentResult = vkQueuePresentKHR(this->m_graphicsQueue, &presentInfo);
+    }
 
     if (presentResult == VK_ERROR_OUT_OF_DATE_KHR) {
         this->m_resizeRequested = true;
@@ -320,14 +531,63 @@ void Hush::VulkanRenderer::Draw()
     this->m_frameNumber++;
 }
 
+DrawContext &Hush::VulkanRenderer::GetDrawContext() noexcept
+{
+    return this->m_snapshots.GetWriteBuffer().drawContext;
+}
+
+void Hush::VulkanRenderer::PublishFrame()
+{
+    RenderSnapshot &snapshot = this->m_snapshots.GetWriteBuffer();
+    auto *uiImpl = dynamic_cast<VulkanImGuiForwarder *>(this->m_uiForwarder.get());
+    // On a single thread the frame is drawn before the next NewUIFrame, so ImGui's draw data can be used as is
+    snapshot.uiDrawData = nullptr;
+    if (uiImpl != nullptr)
+    {
+        snapshot.uiDrawData = uiImpl->CaptureFrame(this->m_threadedRendering ? &snapshot.uiDrawDataCopy : nullptr);
+    }
+    snapshot.frameNumber = this->m_publishedFrames++;
+    if (this->m_threadedRendering)
+    {
+        // Publishing over a pending snapshot would drop it, the game thread would just simulate frames nobody sees
+        HUSH_PROFILE_SCOPE("WaitForRenderThread");
+        std::unique_lock lock(this->m_snapshotMutex);
+        this->m_snapshotConsumed.wait(lock, [this]() { return !this->m_snapshots.HasPendingData(); });
+    }
+    this->m_snapshots.Publish();
+
+    // We get back an old snapshot, clearing it keeps the capacity of its containers
+    DrawContext &nextContext = this->m_snapshots.GetWriteBuffer().drawContext;
+    nextContext.opaqueSurfaces.clear();
+    nextContext.transparentSurfaces.clear();
+    nextContext.cullingFrustum.reset();
+    nextContext.viewProjection.reset();
+}
+
+bool Hush::VulkanRenderer::HasPendingFrame() const noexcept
+{
+    return this->m_snapshots.HasPendingData();
+}
+
+void Hush::VulkanRenderer::SetThreadedRendering(bool enabled) noexcept
+{
+    this->m_threadedRendering = enabled;
+}
+
 void Hush::VulkanRenderer::NewUIFrame() const noexcept
 {
-    this->m_uiForwarder->NewFrame();
+    if (this->m_uiForwarder != nullptr)
+    {
+        this->m_uiForwarder->NewFrame();
+    }
 }
 
 void Hush::VulkanRenderer::HandleEvent(const SDL_Event *event) noexcept
 {
-    this->m_uiForwarder->HandleEvent(event);
+    if (this->m_uiForwarder != nullptr)
+    {
+        this->m_uiForwarder->HandleEvent(event);
+    }
 }
 
 void Hush::VulkanRenderer::InitRendering()
@@ -336,30 +596,98 @@ void Hush::VulkanRenderer::InitRendering()
 
     this->InitDescriptors();
 
+    this->m_pipelineCache.Init(this->m_device, this->m_vulkanPhysicalDevice);
+    this->m_pipelineRegistry.Init(this->m_device, this->m_pipelineCache.GetCache());
+    this->m_shaderLibrary.Init(this->m_device);
+
+    // The cull pipeline samples the depth pyramid through the heap
+    this->InitBindlessHeap();
+
     this->InitPipelines();
 
     this->CreateSyncObjects();
+
+    this->InitGpuTimestamps();
+
+    this->m_uploadManager.Init(this->m_device, this->m_allocator, this->m_transferQueue, this->m_transferQueueFamily,
+                               this->m_graphicsQueueFamily);
+
+    this->m_geometryPool.Init(this->m_allocator, this->m_uploadManager);
+
+    this->m_drawInstancer.Init(this->m_allocator, FRAME_OVERLAP);
+
+    for (FrameData &frame : this->m_frames)
+    {
+        frame.sceneData = VulkanVertexBuffer(sizeof(GPUSceneData),
+                                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                 VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                             VMA_MEMORY_USAGE_AUTO, this->m_allocator);
+    }
+
+    this->m_renderGraph.Init(this->m_device, this->m_allocator);
+
+#if HUSH_SHADER_HOT_RELOAD
+    this->m_shaderHotReload.Init(this->m_shaderLibrary, this->m_pipelineRegistry);
+#endif
 }
 
 void Hush::VulkanRenderer::Dispose()
 {
-    this->m_uiForwarder->Dispose();
+    if (this->m_uiForwarder != nullptr)
+    {
+        this->m_uiForwarder->Dispose();
+    }
+    for (RenderSnapshot &snapshot : this->m_snapshots.GetAllBuffers())
+    {
+        VulkanImGuiForwarder::ReleaseDrawDataCopy(&snapshot.uiDrawDataCopy);
+    }
     LogTrace("Disposed of ImGui resources");
 
     if (this->m_device != nullptr)
     {
+        // Reloads create modules and pipelines from its thread
+        this->m_shaderHotReload.Dispose();
         vkDeviceWaitIdle(this->m_device);
 
-        this->m_mainDeletionQueue.Flush();
-        for (int i = 0; i < FRAME_OVERLAP; i++)
+        // The command pools and sync objects of the frames live in the main queue
+        this->m_frameDeletionQueue.Flush(this->m_device, this->m_allocator);
+        this->m_mainDeletionQueue.Flush(this->m_device, this->m_allocator);
+        for (FrameData &frame : this->m_frames)
         {
-            this->m_frames.at(i).deletionQueue.Flush();
-            // Delete any command pools
-            vkDestroyCommandPool(this->m_device, this->m_frames.at(i).commandPool, nullptr);
-            // Destroy the sync objects
-            vkDestroyFence(this->m_device, this->m_frames.at(i).renderFence, nullptr);
-            vkDestroySemaphore(this->m_device, this->m_frames.at(i).renderSemaphore, nullptr);
-            vkDestroySemaphore(this->m_device, this->m_frames.at(i).swapchainSemaphore, nullptr);
+            frame.timestampQueries.Dispose(this->m_device);
+            frame.sceneData.Destroy();
+        }
+        this->m_frameTimeline.Dispose(this->m_device);
+        this->m_immediateTimeline.Dispose(this->m_device);
+        this->m_uploadManager.Dispose();
+        this->m_geometryPool.Dispose();
+        this->m_gpuCuller.Dispose();
+        this->m_drawInstancer.Dispose();
+        this->m_depthPyramid.Dispose();
+        this->m_bindlessHeap.Dispose();
+        this->m_renderGraph.Dispose();
+        // Async builds still feed the cache, so the registry goes first
+        this->m_pipelineRegistry.Dispose();
+        this->m_shaderLibrary.Dispose();
+        this->m_pipelineCache.Dispose();
+        this->m_globalDescriptorAllocator.DestroyPool(this->m_device);
+        for (FrameData &frame : this->m_frames)
+        {
+            frame.frameDescriptors.DestroyPool(this->m_device);
+        }
+        if (this->m_drawImage.image != nullptr)
+        {
+            vkDestroyImageView(this->m_device, this->m_drawImage.imageView, nullptr);
+            vmaDestroyImage(this->m_allocator, this->m_drawImage.image, this->m_drawImage.allocation);
+        }
+        if (this->m_depthImage.image != nullptr)
+        {
+            vkDestroyImageView(this->m_device, this->m_depthImage.imageView, nullptr);
+            vmaDestroyImage(this->m_allocator, this->m_depthImage.image, this->m_depthImage.allocation);
+        }
+        if (this->m_allocator != nullptr)
+        {
+            vmaDestroyAllocator(this->m_allocator);
         }
         this->DestroySwapChain();
         vkDestroyDevice(this->m_device, nullptr);
@@ -385,10 +713,8 @@ void Hush::VulkanRenderer::Dispose()
 
 void Hush::VulkanRenderer::ImmediateSubmit(std::function<void(VkCommandBuffer cmd)> &&function) noexcept
 {
-    VkResult rc = vkResetFences(this->m_device, 1u, &this->m_immediateFence);
-    HUSH_VK_ASSERT(rc, "Failed to reset immediate fence!");
-
-    rc = vkResetCommandBuffer(this->m_immediateCommandBuffer, 0);
+    // The last immediate submission was waited on before returning, so the command buffer is free
+    VkResult rc = vkResetCommandBuffer(this->m_immediateCommandBuffer, 0);
     HUSH_VK_ASSERT(rc, "Failed to reset immediate command buffer!");
 
     VkCommandBufferBeginInfo cmdBeginInfo =
@@ -403,13 +729,156 @@ void Hush::VulkanRenderer::ImmediateSubmit(std::function<void(VkCommandBuffer cm
 
     VkCommandBufferSubmitInfo cmdSubmitInfo =
         VkUtilsFactory::CreateCommandBufferSubmitInfo(this->m_immediateCommandBuffer);
-    VkSubmitInfo2 submit = this->SubmitInfo(&cmdSubmitInfo, nullptr, nullptr);
+    uint64_t timelineValue = this->m_immediateTimeline.Advance();
+    VkSemaphoreSubmitInfo signalInfo =
+        this->m_immediateTimeline.CreateSignalInfo(timelineValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    VkSubmitInfo2 submit = this->SubmitInfo(&cmdSubmitInfo, &signalInfo, nullptr);
 
-    rc = vkQueueSubmit2(this->m_graphicsQueue, 1u, &submit, this->m_immediateFence);
+    rc = vkQueueSubmit2(this->m_graphicsQueue, 1u, &submit, nullptr);
     HUSH_VK_ASSERT(rc, "Failed to submit graphics queue!");
 
-    rc = vkWaitForFences(this->m_device, 1u, &this->m_immediateFence, VK_TRUE, 9999999999);
-    HUSH_VK_ASSERT(rc, "Immediate fence timed out");
+    rc = this->m_immediateTimeline.Wait(this->m_device, timelineValue, VK_IMMEDIATE_SUBMIT_TIMEOUT_NS);
+    HUSH_VK_ASSERT(rc, "Immediate submit timed out");
+}
+
+const std::vector<Hush::GpuPassTiming> &Hush::VulkanRenderer::GetGpuPassTimings() const noexcept
+{
+    return this->m_gpuPassTimings;
+}
+
+void Hush::VulkanRenderer::ReadbackDrawImage(std::vector<uint8_t> &pixels)
+{
+    HUSH_PROFILE_SCOPE("VulkanRenderer::ReadbackDrawImage");
+    VkDeviceSize byteCount =
+        static_cast<VkDeviceSize>(this->m_width) * this->m_height * DRAW_IMAGE_BYTES_PER_PIXEL;
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = byteCount;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    VmaAllocationCreateInfo allocationInfo{};
+    allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocationInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VkBuffer readbackBuffer = nullptr;
+    VmaAllocation readbackAllocation = nullptr;
+    VmaAllocationInfo readbackInfo{};
+    HUSH_VK_ASSERT(vmaCreateBuffer(this->m_allocator, &bufferInfo, &allocationInfo, &readbackBuffer,
+                                   &readbackAllocation, &readbackInfo),
+                   "Readback buffer allocation failed!");
+
+    this->ImmediateSubmit([&](VkCommandBuffer cmd) {
+        // Every frame leaves the draw image as a transfer source, the barrier orders the copy after those frames
+        this->TransitionImage(cmd, this->m_drawImage.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                              VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+        VkBufferImageCopy region{};
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = {this->m_width, this->m_height, 1};
+        vkCmdCopyImageToBuffer(cmd, this->m_drawImage.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer, 1,
+                               &region);
+
+        VkMemoryBarrier2 hostBarrier{};
+        hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        hostBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        hostBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        hostBarrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+        hostBarrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.memoryBarrierCount = 1;
+        dependencyInfo.pMemoryBarriers = &hostBarrier;
+        vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+    });
+
+    HUSH_VK_ASSERT(vmaInvalidateAllocation(this->m_allocator, readbackAllocation, 0, VK_WHOLE_SIZE),
+                   "Readback buffer invalidation failed!");
+    pixels.resize(static_cast<size_t>(byteCount));
+    std::memcpy(pixels.data(), readbackInfo.pMappedData, pixels.size());
+    vmaDestroyBuffer(this->m_allocator, readbackBuffer, readbackAllocation);
+}
+
+bool Hush::VulkanRenderer::IsHeadless() const noexcept
+{
+    return this->m_isHeadless;
+}
+
+VmaAllocator Hush::VulkanRenderer::GetAllocator() const noexcept
+{
+    return this->m_allocator;
+}
+
+VkFormat Hush::VulkanRenderer::GetDrawImageFormat() const noexcept
+{
+    return this->m_drawImage.imageFormat;
+}
+
+VkFormat Hush::VulkanRenderer::GetDepthImageFormat() const noexcept
+{
+    return this->m_depthImage.imageFormat;
+}
+
+Hush::VulkanUploadManager &Hush::VulkanRenderer::GetUploadManager() noexcept
+{
+    return this->m_uploadManager;
+}
+
+Hush::VulkanGeometryPool &Hush::VulkanRenderer::GetGeometryPool() noexcept
+{
+    return this->m_geometryPool;
+}
+
+Hush::VulkanBindlessHeap &Hush::VulkanRenderer::GetBindlessHeap() noexcept
+{
+    return this->m_bindlessHeap;
+}
+
+Hush::VulkanPipelineRegistry &Hush::VulkanRenderer::GetPipelineRegistry() noexcept
+{
+    return this->m_pipelineRegistry;
+}
+
+Hush::VulkanShaderLibrary &Hush::VulkanRenderer::GetShaderLibrary() noexcept
+{
+    return this->m_shaderLibrary;
+}
+
+VkPipelineCache Hush::VulkanRenderer::GetPipelineCache() const noexcept
+{
+    return this->m_pipelineCache.GetCache();
+}
+
+bool Hush::VulkanRenderer::IsPipelineCacheWarm() const noexcept
+{
+    return this->m_pipelineCache.IsWarm();
+}
+
+double Hush::VulkanRenderer::GetPipelineStartupMilliseconds() const noexcept
+{
+    return this->m_pipelineStartupMilliseconds;
+}
+
+Hush::VulkanRenderGraph::Stats Hush::VulkanRenderer::GetRenderGraphStats() const noexcept
+{
+    return this->m_renderGraph.GetStats();
+}
+
+Hush::VulkanGpuCuller::Stats Hush::VulkanRenderer::GetGpuCullingStats() const noexcept
+{
+    return this->m_gpuCuller.GetStats();
+}
+
+Hush::VulkanRenderer::DrawStats Hush::VulkanRenderer::GetDrawStats() const noexcept
+{
+    return this->m_drawStats;
+}
+
+VkPipelineLayout Hush::VulkanRenderer::GetBindlessPipelineLayout() const noexcept
+{
+    return this->m_bindlessPipelineLayout;
 }
 
 VkInstance Hush::VulkanRenderer::GetVulkanInstance() noexcept
@@ -452,17 +921,45 @@ void Hush::VulkanRenderer::Configure(vkb::Instance vkbInstance)
     VkPhysicalDeviceVulkan12Features vulkan12Features{};
     vulkan12Features.bufferDeviceAddress = VK_TRUE;
     vulkan12Features.descriptorIndexing = VK_TRUE;
-
-    // Select our physical GPU
-    vkb::PhysicalDeviceSelector selector{vkbInstance};
-
-    vkb::PhysicalDevice vkbPhysicalDevice = selector.set_minimum_version(1, 3)
-                                                .prefer_gpu_device_type(vkb::PreferredDeviceType::discrete)
-                                                .set_required_features_13(vulkan13Features)
-                                                .set_required_features_12(vulkan12Features)
-                                                .set_surface(m_surface)
-                                                .select()
-                                                .value();
+    vulkan12Features.timelineSemaphore = VK_TRUE;
+    // Bindless heap, see VulkanBindlessHeap
+    vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+    vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+    vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+    vulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+    vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    vulkan12Features.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+
+    // Gpu driven draws (see VulkanGpuCuller) also need these, without them every object is drawn from the CPU
+    VkPhysicalDeviceVulkan12Features gpuDrivenVulkan12Features = vulkan12Features;
+    gpuDrivenVulkan12Features.drawIndirectCount = VK_TRUE;
+    VkPhysicalDeviceFeatures gpuDrivenFeatures{};
+    gpuDrivenFeatures.multiDrawIndirect = VK_TRUE;
+    gpuDrivenFeatures.drawIndirectFirstInstance = VK_TRUE;
+
+    // Select our physical GPU, one with the gpu driven features if there is any
+    auto selectDevice = [this, &vkbInstance, &vulkan13Features](const VkPhysicalDeviceVulkan12Features &features12,
+                                                                 const VkPhysicalDeviceFeatures &features) {
+        vkb::PhysicalDeviceSelector selector{vkbInstance};
+        return selector.set_minimum_version(1, 3)
+            .prefer_gpu_device_type(vkb::PreferredDeviceType::discrete)
+            .set_required_features_13(vulkan13Features)
+            .set_required_features_12(features12)
+            .set_required_features(features)
+            .set_surface(this->m_surface)
+            .select();
+    };
+    vkb::Result<vkb::PhysicalDevice> selection = selectDevice(gpuDrivenVulkan12Features, gpuDrivenFeatures);
+    this->m_gpuDrivenSupported = static_cast<bool>(selection);
+    if (!this->m_gpuDrivenSupported)
+    {
+        LogWarn("No GPU supports drawIndirectCount, multiDrawIndirect and drawIndirectFirstInstance, gpu driven "
+                "materials are drawn by the CPU");
+        selection = selectDevice(vulkan12Features, VkPhysicalDeviceFeatures{});
+    }
+    HUSH_ASSERT(selection, "No suitable GPU found, error: {}!", selection.error().message());
+    vkb::PhysicalDevice vkbPhysicalDevice = selection.value();
 
     // Get our virtual device based on the physical one
     vkb::DeviceBuilder deviceBuilder(vkbPhysicalDevice);
@@ -488,6 +985,26 @@ void Hush::VulkanRenderer::Configure(vkb::Instance vkbInstance)
     this->m_graphicsQueue = queueResult.value();
     this->m_graphicsQueueFamily = queueIndexResult.value();
 
+    // Uploads prefer a transfer only family (DMA engines), then any family without graphics
+    this->m_transferQueue = this->m_graphicsQueue;
+    this->m_transferQueueFamily = this->m_graphicsQueueFamily;
+    vkb::Result<VkQueue> transferResult = vkbDevice.get_dedicated_queue(vkb::QueueType::transfer);
+    vkb::Result<uint32_t> transferIndexResult = vkbDevice.get_dedicated_queue_index(vkb::QueueType::transfer);
+    if (!transferResult)
+    {
+        transferResult = vkbDevice.get_queue(vkb::QueueType::transfer);
+        transferIndexResult = vkbDevice.get_queue_index(vkb::QueueType::transfer);
+    }
+    if (transferResult && transferIndexResult)
+    {
+        this->m_transferQueue = transferResult.value();
+        this->m_transferQueueFamily = transferIndexResult.value();
+    }
+    else
+    {
+        LogWarn("No separate transfer queue, uploads share the graphics queue");
+    }
+
     // Initialize our allocator
     this->InitVmaAllocator();
 
@@ -503,19 +1020,15 @@ VkFormat *Hush::VulkanRenderer::GetSwapchainImageFormat() noexcept
 void Hush::VulkanRenderer::CreateSyncObjects()
 {
     // Create our sync objects and see if we were succesful
-    VkFenceCreateInfo fenceInfo = VkUtilsFactory::CreateFenceInfo(VkFenceCreateFlagBits::VK_FENCE_CREATE_SIGNALED_BIT);
     VkSemaphoreCreateInfo semaphoreInfo = VkUtilsFactory::CreateSemaphoreInfo();
 
-    VkResult rc = vkCreateFence(this->m_device, &fenceInfo, nullptr, &this->m_immediateFence);
-    HUSH_VK_ASSERT(rc, "Immediate fence creation failed!");
-
-    this->m_mainDeletionQueue.PushFunction([=]() { vkDestroyFence(m_device, m_immediateFence, nullptr); });
+    // CPU waits go through the timelines, the binary semaphores are only there for the swapchain
+    this->m_frameTimeline.Init(this->m_device);
+    this->m_immediateTimeline.Init(this->m_device);
 
+    VkResult rc = VK_SUCCESS;
     for (int i = 0; i < FRAME_OVERLAP; i++)
     {
-        rc = vkCreateFence(this->m_device, &fenceInfo, nullptr, &this->m_frames.at(i).renderFence);
-        HUSH_VK_ASSERT(rc, "Creating fence failed!");
-
         // Create the semaphores
         rc = vkCreateSemaphore(this->m_device, &semaphoreInfo, nullptr, &this->m_frames.at(i).swapchainSemaphore);
         HUSH_VK_ASSERT(rc, "Creating swapchain semaphore failed!");
@@ -523,17 +1036,18 @@ void Hush::VulkanRenderer::CreateSyncObjects()
         rc = vkCreateSemaphore(this->m_device, &semaphoreInfo, nullptr, &this->m_frames.at(i).renderSemaphore);
         HUSH_VK_ASSERT(rc, "Creating render semaphore failed!");
 
-        this->m_mainDeletionQueue.PushFunction([=]() {
-            vkDestroyFence(m_device, m_frames.at(i).renderFence, nullptr);
-            vkDestroySemaphore(m_device, m_frames.at(i).swapchainSemaphore, nullptr);
-            vkDestroySemaphore(m_device, m_frames.at(i).renderSemaphore, nullptr);
-        });
+        this->m_mainDeletionQueue.Push(this->m_frames.at(i).swapchainSemaphore);
+        this->m_mainDeletionQueue.Push(this->m_frames.at(i).renderSemaphore);
     }
 }
 
 void Hush::VulkanRenderer::DestroySwapChain()
 {
-    vkDestroySwapchainKHR(this->m_device, this->m_swapChain, nullptr);
+    // Headless devices don't even load the swapchain functions
+    if (this->m_swapChain != nullptr)
+    {
+        vkDestroySwapchainKHR(this->m_device, this->m_swapChain, nullptr);
+    }
 
     for (auto &imageView : this->m_swapchainImageViews)
     {
@@ -607,9 +1121,8 @@ void Hush::VulkanRenderer::InitVmaAllocator()
     allocatorInfo.instance = this->m_vulkanInstance;
     allocatorInfo.flags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
     allocatorInfo.pVulkanFunctions = &vulkanFunctions;
+    // Destroyed by Dispose, after everything that was allocated from it
     vmaCreateAllocator(&allocatorInfo, &this->m_allocator);
-
-    this->m_mainDeletionQueue.PushFunction([&]() { vmaDestroyAllocator(m_allocator); });
 }
 
 void Hush::VulkanRenderer::InitRenderables()
@@ -727,74 +1240,161 @@ void Hush::VulkanRenderer::InitDescriptors() noexcept
 
     vkUpdateDescriptorSets(this->m_device, 1, &drawImageWrite, 0, nullptr);
 
-    // make sure both the descriptor allocator and the new layout get cleaned up properly
-    this->m_mainDeletionQueue.PushFunction([&]() {
-        m_globalDescriptorAllocator.DestroyPool(m_device);
+    // The descriptor allocator is destroyed by Dispose
+    this->m_mainDeletionQueue.Push(this->m_drawImageDescriptorLayout);
 
-        vkDestroyDescriptorSetLayout(m_device, m_drawImageDescriptorLayout, nullptr);
-    });
+    // Per frame sets (scene uniforms, material parameters...) are allocated while recording and reset in bulk once the
+    // frame timeline says the GPU is done with them, see PrepareCommandBuffer
+    std::vector<DescriptorAllocatorGrowable::PoolSizeRatio> frameSizes = {
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 3},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 3},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4},
+    };
+    for (FrameData &frame : this->m_frames)
+    {
+        frame.frameDescriptors.Init(this->m_device, FRAME_DESCRIPTOR_SETS, frameSizes);
+    }
 }
 
 void Hush::VulkanRenderer::InitPipelines() noexcept
 {
+    // Startup pipeline creation is what the pipeline cache speeds up, compare it between a cold and a warm start
+    uint64_t startTicks = Profiler::Now();
     this->InitBackgroundPipelines();
+    this->InitGpuCulling();
+    this->InitOcclusionCulling();
     this->InitTrianglePipeline();
+    this->m_pipelineStartupMilliseconds = Profiler::TicksToMicroseconds(Profiler::Now() - startTicks) / 1000.0;
+    LogFormat(ELogLevel::Info, "Startup pipelines created in {:.2f} ms with a {} pipeline cache",
+              this->m_pipelineStartupMilliseconds, this->m_pipelineCache.IsWarm() ? "warm" : "cold");
 }
 
 void Hush::VulkanRenderer::InitBackgroundPipelines() noexcept
 {
-	//First, define the push constant range
-	VkPushConstantRange pushConstant{};
-	pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-	pushConstant.offset = 0;
-	pushConstant.size = sizeof(ComputePushConstants);
-
-    // layout code
-    VkShaderModule computeDrawShader = nullptr;
-    constexpr std::string_view shaderPath = "Y:/Programming/C++/Hush-Engine/res/gradient_color.comp.spv";
-    if (!VulkanHelper::LoadShaderModule(shaderPath, this->m_device, &computeDrawShader))
+    const ShaderAsset *computeDrawShader = this->m_shaderLibrary.Load("gradient_color.comp.spv");
+    if (computeDrawShader == nullptr)
     {
         LogError("Error when building the compute shader");
         return;
     }
+    HUSH_ASSERT(computeDrawShader->reflection.pushConstantSize <= sizeof(ComputePushConstants),
+                "Gradient shader expects {} bytes of push constants", computeDrawShader->reflection.pushConstantSize);
 
-    VkPipelineLayoutCreateInfo computeLayout{};
-    computeLayout.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    computeLayout.pNext = nullptr;
-    computeLayout.pSetLayouts = &this->m_drawImageDescriptorLayout;
-    computeLayout.setLayoutCount = 1;
-	computeLayout.pushConstantRangeCount = 1;
-	computeLayout.pPushConstantRanges = &pushConstant;
+    // Set 0 is the draw image's, the reflected push constant range matches ComputePushConstants
+    this->m_gradientPipelineLayout =
+        this->m_shaderLibrary.GetPipelineLayout({computeDrawShader}, {{0u, this->m_drawImageDescriptorLayout}});
+    HUSH_ASSERT(this->m_gradientPipelineLayout != nullptr, "Creating the gradient pipeline layout failed!");
 
-    VkResult res = vkCreatePipelineLayout(this->m_device, &computeLayout, nullptr, &this->m_gradientPipelineLayout);
-    HUSH_VK_ASSERT(res, "Creating compute pipelines failed!");
+    this->m_gradientPipeline = this->CreateComputePipeline(*computeDrawShader, this->m_gradientPipelineLayout);
+}
+
+void Hush::VulkanRenderer::InitGpuCulling() noexcept
+{
+    // Without the device features or the shader every object keeps being drawn from the CPU
+    if (!this->m_gpuDrivenSupported)
+    {
+        return;
+    }
+    const ShaderAsset *cullShader = this->m_shaderLibrary.Load("gpu_cull.comp.spv");
+    if (cullShader == nullptr)
+    {
+        LogWarn("gpu_cull.comp.spv could not be loaded, gpu driven materials are drawn by the CPU");
+        return;
+    }
+    HUSH_ASSERT(cullShader->reflection.pushConstantSize <= sizeof(GpuCullPushConstants),
+                "Cull shader expects {} bytes of push constants", cullShader->reflection.pushConstantSize);
+
+    // Buffers go through device addresses, set 0 is the bindless heap the depth pyramid is sampled from
+    VkPipelineLayout layout =
+        this->m_shaderLibrary.GetPipelineLayout({cullShader}, {{0u, this->m_bindlessHeap.GetSetLayout()}});
+    HUSH_ASSERT(layout != nullptr, "Creating the cull pipeline layout failed!");
+    this->m_gpuCuller.Init(this->m_allocator, this->CreateComputePipeline(*cullShader, layout), layout,
+                           this->m_bindlessHeap, FRAME_OVERLAP);
+}
 
+void Hush::VulkanRenderer::InitOcclusionCulling() noexcept
+{
+    // Only the gpu driven objects are occlusion culled
+    if (!this->m_gpuCuller.IsAvailable())
+    {
+        return;
+    }
+    const ShaderAsset *pyramidShader = this->m_shaderLibrary.Load("depth_pyramid.comp.spv");
+    if (pyramidShader == nullptr)
+    {
+        LogWarn("depth_pyramid.comp.spv could not be loaded, gpu driven objects are only frustum culled");
+        return;
+    }
+
+    // The source and the level written, rebound for every level from the frame's descriptors
+    {
+        DescriptorLayoutBuilder builder;
+        builder.AddBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+        builder.AddBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+        this->m_depthPyramidSetLayout = builder.Build(this->m_device, VK_SHADER_STAGE_COMPUTE_BIT);
+    }
+    this->m_mainDeletionQueue.Push(this->m_depthPyramidSetLayout);
+
+    VkPipelineLayout layout =
+        this->m_shaderLibrary.GetPipelineLayout({pyramidShader}, {{0u, this->m_depthPyramidSetLayout}});
+    HUSH_ASSERT(layout != nullptr, "Creating the depth pyramid pipeline layout failed!");
+    this->m_depthPyramid.Init(this->m_device, this->m_allocator, this->CreateComputePipeline(*pyramidShader, layout),
+                              layout, this->m_depthPyramidSetLayout);
+    this->m_depthPyramidSamplerIndex = this->m_bindlessHeap.RegisterSampler(this->m_depthPyramid.GetSampler());
+}
+
+std::optional<Hush::GpuOcclusionInputs> Hush::VulkanRenderer::PrepareDepthPyramid(const glm::mat4 &viewProjection)
+{
+    // A resize replaces the pyramid, the slot of the old view is freed once the frames that sample it are done
+    VkExtent2D depthExtent = {this->m_depthImage.imageExtent.width, this->m_depthImage.imageExtent.height};
+    if (this->m_depthPyramid.Resize(depthExtent, this->m_frameDeletionQueue,
+                                    this->m_frameTimeline.GetLastSubmittedValue() + 1u))
+    {
+        if (this->m_depthPyramidImageIndex != VulkanBindlessHeap::INVALID_INDEX)
+        {
+            this->ReleaseBindlessAfterFrame(EBindlessResource::SampledImage, this->m_depthPyramidImageIndex);
+        }
+        this->m_depthPyramidImageIndex = this->m_bindlessHeap.RegisterImage(this->m_depthPyramid.GetImageView());
+    }
+    if (this->m_depthPyramidImageIndex == VulkanBindlessHeap::INVALID_INDEX ||
+        this->m_depthPyramidSamplerIndex == VulkanBindlessHeap::INVALID_INDEX)
+    {
+        return std::nullopt;
+    }
+    return GpuOcclusionInputs{viewProjection, depthExtent, this->m_depthPyramidImageIndex,
+                              this->m_depthPyramidSamplerIndex, this->m_depthPyramid.GetLevelCount()};
+}
+
+VkPipeline Hush::VulkanRenderer::CreateComputePipeline(const ShaderAsset &shader, VkPipelineLayout layout) noexcept
+{
     VkPipelineShaderStageCreateInfo stageinfo{};
     stageinfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     stageinfo.pNext = nullptr;
-    stageinfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-    stageinfo.module = computeDrawShader;
-    stageinfo.pName = "main";
+    stageinfo.stage = shader.reflection.stage;
+    stageinfo.module = shader.module;
+    stageinfo.pName = shader.reflection.entryPoint.c_str();
 
     VkComputePipelineCreateInfo computePipelineCreateInfo{};
     computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
     computePipelineCreateInfo.pNext = nullptr;
-    computePipelineCreateInfo.layout = this->m_gradientPipelineLayout;
+    computePipelineCreateInfo.layout = layout;
     computePipelineCreateInfo.stage = stageinfo;
-    res = vkCreateComputePipelines(this->m_device, VK_NULL_HANDLE, 1, &computePipelineCreateInfo, nullptr,
-                                            &this->m_gradientPipeline);
+    VkPipeline pipeline = nullptr;
+    VkResult res = vkCreateComputePipelines(this->m_device, this->m_pipelineCache.GetCache(), 1,
+                                            &computePipelineCreateInfo, nullptr, &pipeline);
     HUSH_VK_ASSERT(res, "Creating compute pipelines failed!");
 
-    // destroy structures properly
-    vkDestroyShaderModule(this->m_device, computeDrawShader, nullptr);
-    this->m_mainDeletionQueue.PushFunction([=]() {
-        vkDestroyPipelineLayout(this->m_device, this->m_gradientPipelineLayout, nullptr);
-        vkDestroyPipeline(this->m_device, this->m_gradientPipeline, nullptr);
-    });
+    // The module and the layout belong to the shader library
+    this->m_mainDeletionQueue.Push(pipeline);
+    return pipeline;
 }
 
-void Hush::VulkanRenderer::DrawGeometry(VkCommandBuffer cmd)
+void Hush::VulkanRenderer::DrawGeometry(VkCommandBuffer cmd, const DrawContext &drawContext, EGpuCullPhase phase,
+                                        bool lastPhase)
 {
+    HUSH_PROFILE_SCOPE("VulkanRenderer::DrawGeometry");
+    bool earlyPhase = phase == EGpuCullPhase::Early;
 	//begin a render pass  connected to our draw image
 	VkRenderingAttachmentInfo colorAttachment = VkUtilsFactory::CreateAttachmentInfoWithLayout(
         this->m_drawImage.imageView, 
@@ -807,10 +1407,13 @@ void Hush::VulkanRenderer::DrawGeometry(VkCommandBuffer cmd)
         this->m_height
     };
 
-	VkRenderingInfo renderInfo = VkUtilsFactory::CreateRenderingInfo(extent, &colorAttachment, nullptr);
-	vkCmdBeginRendering(cmd, &renderInfo);
+    // Reversed depth, the early phase starts from the far plane and the late one tests against what it drew
+    float clearDepth = 0.0f;
+    VkRenderingAttachmentInfo depthAttachment =
+        VkUtilsFactory::CreateDepthAttachmentInfo(this->m_depthImage.imageView, earlyPhase ? &clearDepth : nullptr);
 
-	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, this->m_trianglePipeline);
+	VkRenderingInfo renderInfo = VkUtilsFactory::CreateRenderingInfo(extent, &colorAttachment, &depthAttachment);
+	vkCmdBeginRendering(cmd, &renderInfo);
 
 	//set dynamic viewport and scissor
 	VkViewport viewport = {};
@@ -831,14 +1434,186 @@ void Hush::VulkanRenderer::DrawGeometry(VkCommandBuffer cmd)
 
 	vkCmdSetScissor(cmd, 0, 1, &scissor);
 
-	//launch a draw command to draw 3 vertices
-	vkCmdDraw(cmd, 3, 1, 0, 0);
+    BoundDrawState bound{};
+    if (earlyPhase)
+    {
+        this->m_drawStats = {};
+        bound.pipeline = this->m_trianglePipeline->Get();
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, bound.pipeline);
+        //launch a draw command to draw 3 vertices
+        vkCmdDraw(cmd, 3, 1, 0, 0);
+    }
+
+    // Viewport and scissor are dynamic, so they carry over to the material pipelines. Every mesh shares the geometry
+    // pool, so its index buffer is bound once for all of them. Pipelines and sets are bound as the draws need them
+    vkCmdBindIndexBuffer(cmd, this->m_geometryPool.GetIndexBuffer(), 0, VK_INDEX_TYPE_UINT32);
+    const std::optional<Frustum> &frustum = drawContext.cullingFrustum;
+    if (this->m_gpuCuller.IsAvailable() && this->m_gpuCuller.GetStats().objectCount > 0u)
+    {
+        // The cull pass of the phase already wrote the draws of the gpu driven objects, one indirect call per batch
+        uint32_t frameIndex = this->m_frameNumber % FRAME_OVERLAP;
+        const std::vector<VulkanGpuCuller::Batch> &batches = this->m_gpuCuller.GetBatches(frameIndex);
+        for (uint32_t batch = 0; batch < static_cast<uint32_t>(batches.size()); batch++)
+        {
+            const MaterialPipeline &materialPipeline = *batches[batch].pipeline;
+            this->BindMaterial(cmd, materialPipeline, batches[batch].materialSet, bound);
+            GPUDrawPushConstants pushConstants{};
+            pushConstants.vertexBuffer = this->m_geometryPool.GetVertexBufferAddress();
+            pushConstants.drawObjects = this->m_gpuCuller.GetDrawObjectsAddress(frameIndex);
+            pushConstants.sceneData = this->GetCurrentFrame().sceneData.GetDeviceAddress();
+            vkCmdPushConstants(cmd, materialPipeline.layout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                               sizeof(GPUDrawPushConstants), &pushConstants);
+            this->m_gpuCuller.RecordBatchDraws(cmd, frameIndex, batch, phase);
+            this->m_drawStats.draws++;
+        }
+        if (earlyPhase)
+        {
+            // What the culler left, usually a handful, is tested one by one. It occludes the late phase's objects too
+            this->m_visibleSurfaces.clear();
+            for (uint32_t index : this->m_cpuSurfaces)
+            {
+                if (!frustum.has_value() || FrustumCuller::IsVisible(*frustum, drawContext.opaqueSurfaces[index]))
+                {
+                    this->m_visibleSurfaces.push_back(index);
+                }
+            }
+            this->DrawSorted(cmd, drawContext.opaqueSurfaces, drawContext, EDrawOrder::FrontToBack, bound);
+        }
+    }
+    else if (earlyPhase)
+    {
+        this->DrawSurfaces(cmd, drawContext.opaqueSurfaces, drawContext, EDrawOrder::FrontToBack, bound);
+    }
+    // Blending needs the transparent surfaces in order, which the compacted indirect draws don't keep. They go on top
+    // of every opaque surface
+    if (lastPhase)
+    {
+        this->DrawSurfaces(cmd, drawContext.transparentSurfaces, drawContext, EDrawOrder::BackToFront, bound);
+    }
 
 	vkCmdEndRendering(cmd);
 }
 
+void Hush::VulkanRenderer::DrawSurfaces(VkCommandBuffer cmd, const std::vector<RenderObject> &surfaces,
+                                        const DrawContext &drawContext, EDrawOrder order, BoundDrawState &bound)
+{
+    // Only what the camera sees gets recorded, big lists are culled on the job system
+    if (drawContext.cullingFrustum.has_value())
+    {
+        this->m_frustumCuller.Cull(*drawContext.cullingFrustum, surfaces, this->m_visibleSurfaces,
+                                   JobSystem::GetMain());
+    }
+    else
+    {
+        this->m_visibleSurfaces.resize(surfaces.size());
+        std::iota(this->m_visibleSurfaces.begin(), this->m_visibleSurfaces.end(), 0u);
+    }
+    this->DrawSorted(cmd, surfaces, drawContext, order, bound);
+}
+
+void Hush::VulkanRenderer::DrawSorted(VkCommandBuffer cmd, const std::vector<RenderObject> &surfaces,
+                                      const DrawContext &drawContext, EDrawOrder order, BoundDrawState &bound)
+{
+    this->m_drawSorter.Sort(surfaces, this->m_visibleSurfaces, drawContext.viewProjection, order,
+                            JobSystem::GetMain());
+    this->m_drawInstancer.Build(this->m_frameNumber % FRAME_OVERLAP, surfaces, this->m_visibleSurfaces, order,
+                                this->m_instancedDraws);
+    for (const VulkanDrawInstancer::InstancedDraw &draw : this->m_instancedDraws)
+    {
+        if (draw.firstInstance == VulkanDrawInstancer::NO_RECORDS)
+        {
+            this->DrawRenderObject(cmd, surfaces[draw.object], bound);
+        }
+        else
+        {
+            this->DrawInstanced(cmd, surfaces[draw.object], draw, bound);
+        }
+    }
+}
+
+void Hush::VulkanRenderer::BindMaterial(VkCommandBuffer cmd, const MaterialPipeline &materialPipeline,
+                                        VkDescriptorSet materialSet, BoundDrawState &bound) noexcept
+{
+    VkPipeline pipeline = materialPipeline.registered != nullptr ? materialPipeline.registered->Get()
+                                                                 : materialPipeline.pipeline;
+    if (pipeline != bound.pipeline)
+    {
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        bound.pipeline = pipeline;
+        this->m_drawStats.pipelineBinds++;
+    }
+    else
+    {
+        this->m_drawStats.pipelineBindsSkipped++;
+    }
+
+    // Materials with their own set replace the heap at set 0. A set stays valid across pipelines of the same layout,
+    // and the heap's across every layout made with its set layout
+    VkDescriptorSet set = materialSet;
+    VkPipelineLayout layout = materialPipeline.layout;
+    if (set == nullptr)
+    {
+        if (layout != this->m_bindlessPipelineLayout)
+        {
+            return;
+        }
+        set = this->m_bindlessHeap.GetSet();
+    }
+    bool compatible = layout == bound.setLayout || set == this->m_bindlessHeap.GetSet();
+    if (set == bound.set && compatible)
+    {
+        this->m_drawStats.descriptorSetBindsSkipped++;
+        return;
+    }
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &set, 0, nullptr);
+    bound.set = set;
+    bound.setLayout = layout;
+    this->m_drawStats.descriptorSetBinds++;
+}
+
+void Hush::VulkanRenderer::DrawRenderObject(VkCommandBuffer cmd, const RenderObject &renderObject,
+                                            BoundDrawState &bound) noexcept
+{
+    const MaterialPipeline *materialPipeline = renderObject.material->pipeline;
+    this->BindMaterial(cmd, *materialPipeline, renderObject.material->materialSet, bound);
+
+    // gl_VertexIndex includes vertexOffset, so the shaders index the pool's vertex buffer directly
+    GPUDrawPushConstants pushConstants{};
+    pushConstants.worldMatrix = renderObject.transform;
+    pushConstants.vertexBuffer = this->m_geometryPool.GetVertexBufferAddress();
+    pushConstants.materialIndex = renderObject.material->materialIndex;
+    pushConstants.sceneData = this->GetCurrentFrame().sceneData.GetDeviceAddress();
+    vkCmdPushConstants(cmd, materialPipeline->layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants),
+                       &pushConstants);
+
+    vkCmdDrawIndexed(cmd, renderObject.indexCount, 1, renderObject.firstIndex, renderObject.vertexOffset, 0);
+    this->m_drawStats.draws++;
+}
+
+void Hush::VulkanRenderer::DrawInstanced(VkCommandBuffer cmd, const RenderObject &renderObject,
+                                         const VulkanDrawInstancer::InstancedDraw &draw, BoundDrawState &bound) noexcept
+{
+    const MaterialPipeline *materialPipeline = renderObject.material->pipeline;
+    this->BindMaterial(cmd, *materialPipeline, renderObject.material->materialSet, bound);
+
+    // Same as the indirect draws, gl_InstanceIndex starts at firstInstance and picks each instance's record
+    GPUDrawPushConstants pushConstants{};
+    pushConstants.vertexBuffer = this->m_geometryPool.GetVertexBufferAddress();
+    pushConstants.drawObjects = this->m_drawInstancer.GetRecordsAddress(this->m_frameNumber % FRAME_OVERLAP);
+    pushConstants.sceneData = this->GetCurrentFrame().sceneData.GetDeviceAddress();
+    vkCmdPushConstants(cmd, materialPipeline->layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants),
+                       &pushConstants);
+
+    vkCmdDrawIndexed(cmd, renderObject.indexCount, draw.instanceCount, renderObject.firstIndex,
+                     renderObject.vertexOffset, draw.firstInstance);
+    this->m_drawStats.draws++;
+    this->m_drawStats.instancedDraws++;
+    this->m_drawStats.instancedObjects += draw.instanceCount;
+}
+
 void Hush::VulkanRenderer::DrawBackground(VkCommandBuffer cmd) noexcept
 {
+    HUSH_PROFILE_SCOPE("VulkanRenderer::DrawBackground");
     // bind the gradient drawing compute pipeline
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, this->m_gradientPipeline);
 
@@ -857,31 +1632,58 @@ void Hush::VulkanRenderer::DrawBackground(VkCommandBuffer cmd) noexcept
     vkCmdDispatch(cmd, roundedWidth, roundedHeight, 1);
 }
 
-void Hush::VulkanRenderer::DrawUI(VkCommandBuffer cmd, VkImageView imageView)
+void Hush::VulkanRenderer::DrawUI(VkCommandBuffer cmd, VkImageView imageView, ImDrawData *uiDrawData)
 {
+    HUSH_PROFILE_SCOPE("VulkanRenderer::DrawUI");
+    // Nothing was published yet
+    if (uiDrawData == nullptr)
+    {
+        return;
+    }
 	VkRenderingAttachmentInfo colorAttachment = VkUtilsFactory::CreateAttachmentInfoWithLayout(imageView, nullptr, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 	VkRenderingInfo renderInfo = VkUtilsFactory::CreateRenderingInfo(this->m_swapChainExtent, &colorAttachment, nullptr);
 
 	vkCmdBeginRendering(cmd, &renderInfo);
 	auto* uiImpl = dynamic_cast<VulkanImGuiForwarder*>(this->m_uiForwarder.get());
-	uiImpl->RenderFrame(cmd);
+	uiImpl->RenderDrawData(uiDrawData, cmd);
 
     vkCmdEndRendering(cmd);
 }
 
 VkCommandBuffer Hush::VulkanRenderer::PrepareCommandBuffer(FrameData& currentFrame, uint32_t* swapchainImageIndex)
 {
-    // wait until the gpu has finished rendering the last frame. Timeout of 1 second
-    const uint32_t fenceTargetCount = 1u;
-    // Wait until the gpu has finished rendering the last frame. Timeout of 1 second
-    VkResult rc =
-        vkWaitForFences(this->m_device, fenceTargetCount, &currentFrame.renderFence, true, VK_OPERATION_TIMEOUT_NS);
-    currentFrame.deletionQueue.Flush();
-	HUSH_VK_ASSERT(rc, "Fence wait failed!");
-
-    // Request an image from the swapchain
-    rc = vkAcquireNextImageKHR(this->m_device, this->m_swapChain, VK_OPERATION_TIMEOUT_NS,
-        currentFrame.swapchainSemaphore, nullptr, swapchainImageIndex);
+    // Wait until the gpu has finished the last submission of this frame, nothing to reset afterwards. Timeout of 1
+    // second
+    VkResult rc = VK_SUCCESS;
+    {
+        HUSH_PROFILE_SCOPE("VulkanRenderer::WaitForFrameTimeline");
+        rc = this->m_frameTimeline.Wait(this->m_device, currentFrame.timelineValue, VK_OPERATION_TIMEOUT_NS);
+    }
+	HUSH_VK_ASSERT(rc, "Frame timeline wait failed!");
+    {
+        // Other frames may have finished too, the completed value covers all of them
+        HUSH_PROFILE_SCOPE("VulkanRenderer::RetireDeletions");
+        uint64_t completedValue = this->m_frameTimeline.GetCompletedValue(this->m_device);
+        this->m_frameDeletionQueue.Retire(this->m_device, this->m_allocator, completedValue);
+        this->m_geometryPool.Retire(completedValue);
+        this->m_bindlessHeap.Retire(completedValue);
+        this->m_pipelineRegistry.Retire(completedValue);
+        this->m_renderGraph.Retire(completedValue);
+    }
+    // Frame boundary, nothing recorded yet can see the pipelines reloaded shaders replace
+    this->m_shaderHotReload.Update(this->m_frameTimeline.GetLastSubmittedValue() + 1u);
+    // Every set this frame allocated last time is done too, they all go back to the pools at once
+    currentFrame.frameDescriptors.ClearPool(this->m_device);
+    // The wait guarantees the queries of the last use of this frame are done, so this never stalls
+    this->ReadGpuTimestamps(currentFrame);
+
+    // Request an image from the swapchain, headless renderers only draw to the draw image
+    if (!this->m_isHeadless)
+    {
+        HUSH_PROFILE_SCOPE("VulkanRenderer::AcquireImage");
+        rc = vkAcquireNextImageKHR(this->m_device, this->m_swapChain, VK_OPERATION_TIMEOUT_NS,
+                                   currentFrame.swapchainSemaphore, nullptr, swapchainImageIndex);
+    }
 	
     //Handle resize request, pass this back to the caller to check
     if (rc == VK_ERROR_OUT_OF_DATE_KHR) {
@@ -891,9 +1693,6 @@ VkCommandBuffer Hush::VulkanRenderer::PrepareCommandBuffer(FrameData& currentFra
 	}
 	HUSH_VK_ASSERT(rc, "Image request from the swapchain failed!");
 
-	rc = vkResetFences(this->m_device, fenceTargetCount, &currentFrame.renderFence);
-	HUSH_VK_ASSERT(rc, "Fence reset failed!");
-
 	// Get the command buffer and reset it
 	VkCommandBuffer cmd = currentFrame.mainCommandBuffer;
 	// Reset the command buffer
@@ -906,13 +1705,104 @@ VkCommandBuffer Hush::VulkanRenderer::PrepareCommandBuffer(FrameData& currentFra
 		VkUtilsFactory::CreateCommandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 	rc = vkBeginCommandBuffer(cmd, &cmdBeginInfo);
 	HUSH_VK_ASSERT(rc, "Begin command buffer failed!");
+    currentFrame.timestampQueries.Reset(cmd);
 
     return cmd;
 }
 
+void Hush::VulkanRenderer::SubmitHeadlessFrame(VkCommandBuffer cmd, FrameData &currentFrame,
+                                               uint64_t uploadWaitValue)
+{
+    HUSH_VK_ASSERT(vkEndCommandBuffer(cmd), "End command buffer failed!");
+
+    // Nothing to present, the timelines are all the sync we need
+    currentFrame.timelineValue = this->m_frameTimeline.Advance();
+    VkCommandBufferSubmitInfo cmdInfo = VkUtilsFactory::CreateCommandBufferSubmitInfo(cmd);
+    VkSemaphoreSubmitInfo signalInfo =
+        this->m_frameTimeline.CreateSignalInfo(currentFrame.timelineValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    VkSemaphoreSubmitInfo uploadWaitInfo =
+        this->m_uploadManager.CreateWaitInfo(uploadWaitValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    VkSubmitInfo2 submit =
+        VkUtilsFactory::SubmitInfo(&cmdInfo, &signalInfo, uploadWaitValue != 0u ? &uploadWaitInfo : nullptr);
+
+    currentFrame.submitTicks = Profiler::Now();
+    {
+        HUSH_PROFILE_SCOPE("VulkanRenderer::Submit");
+        HUSH_VK_ASSERT(vkQueueSubmit2(this->m_graphicsQueue, 1, &submit, nullptr), "Queue submit failed!");
+    }
+    this->m_frameNumber++;
+}
+
+void Hush::VulkanRenderer::InitGpuTimestamps() noexcept
+{
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(this->m_vulkanPhysicalDevice, &properties);
+
+    uint32_t queueFamilyCount = 0u;
+    vkGetPhysicalDeviceQueueFamilyProperties(this->m_vulkanPhysicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(this->m_vulkanPhysicalDevice, &queueFamilyCount, queueFamilies.data());
+
+    uint32_t timestampValidBits = queueFamilies.at(this->m_graphicsQueueFamily).timestampValidBits;
+    if (timestampValidBits == 0u)
+    {
+        LogWarn("The graphics queue can't write timestamps, GPU pass timings are disabled");
+    }
+    for (FrameData &frame : this->m_frames)
+    {
+        frame.timestampQueries.Init(this->m_device, properties.limits.timestampPeriod, timestampValidBits);
+    }
+#if HUSH_ENABLE_PROFILER
+    this->m_gpuProfilerTrack = &Profiler::RegisterTrack("GPU");
+#endif
+}
+
+void Hush::VulkanRenderer::InitBindlessHeap() noexcept
+{
+    this->m_bindlessHeap.Init(this->m_device, this->m_vulkanPhysicalDevice);
+
+    // Same push constants as every material pipeline, so DrawRenderObject can push them whatever the layout
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    pushConstantRange.size = sizeof(GPUDrawPushConstants);
+    VkDescriptorSetLayout setLayout = this->m_bindlessHeap.GetSetLayout();
+    VkPipelineLayoutCreateInfo layoutInfo = VkUtilsFactory::PipelineLayoutCreateInfo();
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &setLayout;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushConstantRange;
+    HUSH_VK_ASSERT(vkCreatePipelineLayout(this->m_device, &layoutInfo, nullptr, &this->m_bindlessPipelineLayout),
+                   "Bindless pipeline layout creation failed!");
+    this->m_mainDeletionQueue.Push(this->m_bindlessPipelineLayout);
+}
+
+void Hush::VulkanRenderer::ReadGpuTimestamps(FrameData &frame)
+{
+    if (!frame.timestampQueries.ReadResults(this->m_device, this->m_gpuPassTimings))
+    {
+        return;
+    }
+#if HUSH_ENABLE_PROFILER
+    // The GPU clock isn't calibrated against the CPU one, so the frame is placed at its submission (the earliest it
+    // could have started) without overlapping the previous GPU frame. Durations and offsets within it are exact
+    uint64_t frameStartTicks = std::max(frame.submitTicks, this->m_lastGpuZoneEndTicks);
+    uint64_t frameEndTicks = frameStartTicks;
+    for (const GpuPassTiming &timing : this->m_gpuPassTimings)
+    {
+        uint64_t startTicks = frameStartTicks + Profiler::MicrosecondsToTicks(timing.startMilliseconds * 1000.0);
+        uint64_t endTicks = startTicks + Profiler::MicrosecondsToTicks(timing.milliseconds * 1000.0);
+        this->m_gpuProfilerTrack->Push(timing.name, startTicks, endTicks, 1u);
+        frameEndTicks = std::max(frameEndTicks, endTicks);
+    }
+    this->m_gpuProfilerTrack->Push("GPU Frame", frameStartTicks, frameEndTicks, 0u);
+    this->m_lastGpuZoneEndTicks = frameEndTicks;
+#endif
+}
+
 void Hush::VulkanRenderer::ResizeSwapchain()
 {
-    this->m_uiForwarder->EndFrame();
+    HUSH_PROFILE_SCOPE("VulkanRenderer::ResizeSwapchain");
+    // The UI frame was already ended by PublishFrame, which might be running on another thread
     vkDeviceWaitIdle(this->m_device);
     this->DestroySwapChain();
     //Defer this to the WindowRenderer interface instead of SDL
@@ -924,29 +1814,24 @@ void Hush::VulkanRenderer::ResizeSwapchain()
 
 void Hush::VulkanRenderer::InitTrianglePipeline()
 {
-	constexpr std::string_view fragmentShaderPath = "Y:/Programming/C++/Hush-Engine/res/colored_triangle.frag.spv";
-	constexpr std::string_view vertexShaderPath = "Y:/Programming/C++/Hush-Engine/res/colored_triangle.vert.spv";
-	
-	VkShaderModule triangleFragShader;
-    if (!VulkanHelper::LoadShaderModule(fragmentShaderPath, this->m_device, &triangleFragShader)) {
-		LogError("Error when building the triangle fragment shader module");
-	}
-
-	VkShaderModule triangleVertexShader;
-	if (!VulkanHelper::LoadShaderModule(vertexShaderPath, this->m_device, &triangleVertexShader)) {
-		LogError("Error when building the triangle vertex shader module");
-	}
+    const ShaderAsset *triangleFragShader = this->m_shaderLibrary.Load("colored_triangle.frag.spv");
+    const ShaderAsset *triangleVertexShader = this->m_shaderLibrary.Load("colored_triangle.vert.spv");
+    if (triangleFragShader == nullptr || triangleVertexShader == nullptr)
+    {
+        LogError("Error when building the triangle shader modules");
+        return;
+    }
 
-	//build the pipeline layout that controls the inputs/outputs of the shader
-	//we are not using descriptor sets or other systems yet, so no need to use anything other than empty default
-	VkPipelineLayoutCreateInfo pipelineLayoutInfo = VkUtilsFactory::PipelineLayoutCreateInfo();
-    VkResult rc = vkCreatePipelineLayout(this->m_device, &pipelineLayoutInfo, nullptr, &this->m_trianglePipelineLayout);
-    HUSH_VK_ASSERT(rc, "Failed to create triangle pipeline");
+    // build the pipeline layout that controls the inputs/outputs of the shader, reflection finds no sets or push
+    // constants so it's the empty default
+    this->m_trianglePipelineLayout =
+        this->m_shaderLibrary.GetPipelineLayout({triangleVertexShader, triangleFragShader});
+    HUSH_ASSERT(this->m_trianglePipelineLayout != nullptr, "Failed to create triangle pipeline");
 
 	VulkanPipelineBuilder pipelineBuilder(this->m_trianglePipelineLayout);
 
 	//connecting the vertex and pixel shaders to the pipeline
-	pipelineBuilder.SetShaders(triangleVertexShader, triangleFragShader);
+	pipelineBuilder.SetShaders(triangleVertexShader->module, triangleFragShader->module);
 	//it will draw triangles
 	pipelineBuilder.SetInputTopology(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
 	//filled triangles
@@ -962,17 +1847,11 @@ void Hush::VulkanRenderer::InitTrianglePipeline()
 
 	//connect the image format we will draw into, from draw image
 	pipelineBuilder.SetColorAttachmentFormat(this->m_drawImage.imageFormat);
-	pipelineBuilder.SetDepthFormat(VK_FORMAT_UNDEFINED);
+	pipelineBuilder.SetDepthFormat(this->m_depthImage.imageFormat);
 
 	//finally build the pipeline
-	this->m_trianglePipeline = pipelineBuilder.Build(this->m_device);
-
-	//clean structures
-	vkDestroyShaderModule(this->m_device, triangleFragShader, nullptr);
-	vkDestroyShaderModule(this->m_device, triangleVertexShader, nullptr);
+	this->m_trianglePipeline = this->m_pipelineRegistry.Acquire(pipelineBuilder);
+    HUSH_ASSERT(this->m_trianglePipeline != nullptr, "Failed to create triangle pipeline");
 
-	this->m_mainDeletionQueue.PushFunction([=]() {
-		vkDestroyPipelineLayout(m_device, m_trianglePipelineLayout, nullptr);
-		vkDestroyPipeline(m_device, m_trianglePipeline, nullptr);
-	});
+    // The modules and the layout belong to the shader library, the pipeline to the registry
 }
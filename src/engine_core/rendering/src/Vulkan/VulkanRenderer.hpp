@@ -12,12 +12,31 @@
 #include <magic_enum.hpp>
 #include "FrameData.hpp"
 #include "VkTypes.hpp"
+#include "VulkanBindlessHeap.hpp"
 #include "VulkanDeletionQueue.hpp"
+#include "VulkanDepthPyramid.hpp"
+#include "VulkanGeometryPool.hpp"
+#include "VulkanDrawInstancer.hpp"
+#include "VulkanGpuCuller.hpp"
+#include "VulkanPipelineCache.hpp"
+#include "VulkanPipelineRegistry.hpp"
+#include "VulkanRenderGraph.hpp"
+#include "VulkanShaderHotReload.hpp"
+#include "VulkanShaderLibrary.hpp"
+#include "VulkanTimeline.hpp"
+#include "VulkanUploadManager.hpp"
 #include "ImGui/IImGuiForwarder.hpp"
+#include "Shared/DrawSorting.hpp"
+#include "Shared/FrustumCulling.hpp"
+#include "Shared/RenderSnapshot.hpp"
+#include "TripleBuffer.hpp"
+#include "Profiler.hpp"
 #include "vk_mem_alloc.hpp"
 #include <VkBootstrap.h>
 #include <array>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include "VkDescriptors.hpp"
@@ -25,18 +44,42 @@
 ///@brief Double frame buffering, allows for the GPU and CPU to work in parallel. NOTE: increase to 3 if experiencing
 /// jittery framerates
 constexpr uint32_t FRAME_OVERLAP = 2;
+/// @brief Sets the first descriptor pool of each frame holds, more pools are added if a frame needs them
+constexpr uint32_t FRAME_DESCRIPTOR_SETS = 1000;
 
 constexpr uint32_t VK_OPERATION_TIMEOUT_NS = 1'000'000'000; // This is one second, trust me (1E-9)
 
+///@brief Immediate submissions may upload a lot of data, so they get more time than a frame
+constexpr uint64_t VK_IMMEDIATE_SUBMIT_TIMEOUT_NS = 10ull * VK_OPERATION_TIMEOUT_NS;
+
+///@brief The draw image is VK_FORMAT_R16G16B16A16_SFLOAT
+constexpr uint32_t DRAW_IMAGE_BYTES_PER_PIXEL = 8;
+
 namespace Hush
 {
 
     class VulkanRenderer final : public IRenderer
     {
       public:
+        /// @brief Draw calls and state binds the geometry passes recorded last frame. Draws are sorted so the ones that
+        /// share state are recorded together, the skipped binds are the ones that state was already bound for
+        struct DrawStats
+        {
+            /// @brief vkCmdDrawIndexed calls plus one per indirect batch
+            uint32_t draws = 0u;
+            /// @brief Draws of more than one instance, VulkanDrawInstancer merged instancedObjects into them. Only
+            /// bindless materials drawn from the CPU count here
+            uint32_t instancedDraws = 0u;
+            uint32_t instancedObjects = 0u;
+            uint32_t pipelineBinds = 0u;
+            uint32_t pipelineBindsSkipped = 0u;
+            uint32_t descriptorSetBinds = 0u;
+            uint32_t descriptorSetBindsSkipped = 0u;
+        };
         static PFN_vkVoidFunction CustomVulkanFunctionLoader(const char *functionName, void *userData);
         /// @brief Creates a new vulkan renderer from a given window context
-        /// @param windowContext opaque pointer to the window context
+        /// @param windowContext opaque pointer to the window context, nullptr creates a headless renderer: no surface,
+        /// swapchain nor UI, frames are only rendered into the draw image (see ReadbackDrawImage)
         VulkanRenderer(void *windowContext);
 
         VulkanRenderer(const VulkanRenderer &) = delete;
@@ -57,6 +100,14 @@ namespace Hush
 
         void Draw() override;
 
+        DrawContext &GetDrawContext() noexcept override;
+
+        void PublishFrame() override;
+
+        [[nodiscard]] bool HasPendingFrame() const noexcept override;
+
+        void SetThreadedRendering(bool enabled) noexcept override;
+
         void NewUIFrame() const noexcept override;
 
         void HandleEvent(const SDL_Event *event) noexcept override;
@@ -69,6 +120,92 @@ namespace Hush
 
         FrameData &GetLastFrame() noexcept;
 
+        /// @brief GPU time of each pass of the last frame whose timestamps were read back (FRAME_OVERLAP frames behind
+        /// the one being recorded). Only safe to call from the thread that calls Draw, the same timings are recorded
+        /// on the profiler's "GPU" track for everyone else
+        [[nodiscard]] const std::vector<GpuPassTiming> &GetGpuPassTimings() const noexcept;
+
+        /// @brief Destroys a handle once the GPU is done with every frame recorded so far, takes the same arguments
+        /// as VulkanDeletionQueue::Push. Call from the thread that calls Draw
+        template <class... Handle> void DestroyAfterFrame(Handle... handles)
+        {
+            // The frame being recorded signals the next value of the timeline
+            this->m_frameDeletionQueue.Push(handles..., this->m_frameTimeline.GetLastSubmittedValue() + 1u);
+        }
+
+        /// @brief Removes a mesh from the geometry pool once the GPU is done with every frame recorded so far. Call
+        /// from the thread that calls Draw
+        void RemoveMeshAfterFrame(const MeshGeometry &mesh)
+        {
+            this->m_geometryPool.RemoveMesh(mesh, this->m_frameTimeline.GetLastSubmittedValue() + 1u);
+        }
+
+        /// @brief Drops a reference to a registry pipeline, the last one destroys it once the GPU is done with every
+        /// frame recorded so far. Call from the thread that calls Draw
+        void ReleasePipelineAfterFrame(const RegisteredPipeline *pipeline)
+        {
+            this->m_pipelineRegistry.Release(pipeline, this->m_frameTimeline.GetLastSubmittedValue() + 1u);
+        }
+
+        /// @brief Frees a bindless slot once the GPU is done with every frame recorded so far. Call from the thread
+        /// that calls Draw
+        void ReleaseBindlessAfterFrame(EBindlessResource resource, uint32_t index)
+        {
+            this->m_bindlessHeap.Release(resource, index, this->m_frameTimeline.GetLastSubmittedValue() + 1u);
+        }
+
+        /// @brief Copies the draw image of the last submitted frame to CPU memory, waiting for the GPU to finish it, so
+        /// keep it out of timed code. Call from the thread that calls Draw
+        /// @param pixels tightly packed rows of VK_FORMAT_R16G16B16A16_SFLOAT pixels (DRAW_IMAGE_BYTES_PER_PIXEL each)
+        void ReadbackDrawImage(std::vector<uint8_t> &pixels);
+
+        [[nodiscard]] bool IsHeadless() const noexcept;
+
+        [[nodiscard]] VmaAllocator GetAllocator() const noexcept;
+
+        [[nodiscard]] VkFormat GetDrawImageFormat() const noexcept;
+
+        /// @brief Format material pipelines have to declare with SetDepthFormat, the geometry passes always have it
+        [[nodiscard]] VkFormat GetDepthImageFormat() const noexcept;
+
+        /// @brief Uploads queued here are submitted by the next Draw, which also waits for them on the GPU
+        [[nodiscard]] VulkanUploadManager &GetUploadManager() noexcept;
+
+        /// @brief Static meshes drawn through RenderObject live here, add them with VulkanGeometryPool::AddMesh
+        [[nodiscard]] VulkanGeometryPool &GetGeometryPool() noexcept;
+
+        /// @brief Textures, samplers and material buffers indexed by the shaders, release slots with
+        /// ReleaseBindlessAfterFrame
+        [[nodiscard]] VulkanBindlessHeap &GetBindlessHeap() noexcept;
+
+        /// @brief Layout for material pipelines that read the bindless heap, their draws don't bind any set. Owned by
+        /// the renderer
+        [[nodiscard]] VkPipelineLayout GetBindlessPipelineLayout() const noexcept;
+
+        /// @brief Material pipelines should come from here, so each unique state is only built once
+        [[nodiscard]] VulkanPipelineRegistry &GetPipelineRegistry() noexcept;
+
+        /// @brief Loads shaders relative to the asset root and builds their pipeline layouts, both owned by the library
+        [[nodiscard]] VulkanShaderLibrary &GetShaderLibrary() noexcept;
+
+        /// @brief Pass it to every pipeline creation, it's saved to disk by Dispose
+        [[nodiscard]] VkPipelineCache GetPipelineCache() const noexcept;
+
+        /// @brief Whether the pipeline cache was loaded from a previous run
+        [[nodiscard]] bool IsPipelineCacheWarm() const noexcept;
+
+        /// @brief Time InitRendering spent creating the renderer's own pipelines
+        [[nodiscard]] double GetPipelineStartupMilliseconds() const noexcept;
+
+        /// @brief Passes, barriers and transient memory of the last frame's render graph
+        [[nodiscard]] VulkanRenderGraph::Stats GetRenderGraphStats() const noexcept;
+
+        /// @brief Objects and batches the last frame drew indirectly, all zero without gpu_cull.comp.spv
+        [[nodiscard]] VulkanGpuCuller::Stats GetGpuCullingStats() const noexcept;
+
+        /// @brief Only safe to call from the thread that calls Draw
+        [[nodiscard]] DrawStats GetDrawStats() const noexcept;
+
         /* CONSTANT GETTERS */
 
         [[nodiscard]] VkInstance GetVulkanInstance() noexcept;
@@ -114,16 +251,68 @@ namespace Hush
 
         void InitBackgroundPipelines() noexcept;
 
-        void DrawGeometry(VkCommandBuffer cmd);
+        void InitGpuCulling() noexcept;
+
+        /// @brief Builds the depth pyramid reduction, without it gpu driven objects are only frustum culled
+        void InitOcclusionCulling() noexcept;
+
+        /// @brief Resizes the depth pyramid to the depth image and keeps its bindless slot current
+        /// @return Unset if the heap had no slot left for it, the frame is only frustum culled then
+        std::optional<GpuOcclusionInputs> PrepareDepthPyramid(const glm::mat4 &viewProjection);
+
+        /// @brief Builds the pipeline through the pipeline cache, it lives as long as the renderer
+        VkPipeline CreateComputePipeline(const ShaderAsset &shader, VkPipelineLayout layout) noexcept;
+
+        /// @brief Draws the phase's indirect batches. The early phase clears the depth and also draws the triangle and
+        /// the CPU recorded opaque surfaces
+        /// @param lastPhase whether no geometry pass follows, the transparent surfaces are drawn on top then
+        void DrawGeometry(VkCommandBuffer cmd, const DrawContext &drawContext, EGpuCullPhase phase, bool lastPhase);
+
+        /// @brief What a geometry pass has bound so far, so draws sharing state skip the binds
+        struct BoundDrawState
+        {
+            VkPipeline pipeline = nullptr;
+            /// @brief Bound at set 0, either a material's set or the bindless heap's
+            VkDescriptorSet set = nullptr;
+            /// @brief Layout set was bound with
+            VkPipelineLayout setLayout = nullptr;
+        };
+
+        /// @brief Draws the surfaces in order, the ones outside the draw context's frustum are skipped if it's set
+        void DrawSurfaces(VkCommandBuffer cmd, const std::vector<RenderObject> &surfaces,
+                          const DrawContext &drawContext, EDrawOrder order, BoundDrawState &bound);
+
+        /// @brief Sorts m_visibleSurfaces (indices into surfaces) and draws them, the ones sharing a mesh and material
+        /// instanced
+        void DrawSorted(VkCommandBuffer cmd, const std::vector<RenderObject> &surfaces, const DrawContext &drawContext,
+                        EDrawOrder order, BoundDrawState &bound);
+
+        /// @brief Binds the pipeline and set 0 unless bound already has them
+        void BindMaterial(VkCommandBuffer cmd, const MaterialPipeline &materialPipeline, VkDescriptorSet materialSet,
+                          BoundDrawState &bound) noexcept;
+
+        void DrawRenderObject(VkCommandBuffer cmd, const RenderObject &renderObject, BoundDrawState &bound) noexcept;
+
+        /// @brief Draws the records of draw, renderObject is its first object
+        void DrawInstanced(VkCommandBuffer cmd, const RenderObject &renderObject,
+                           const VulkanDrawInstancer::InstancedDraw &draw, BoundDrawState &bound) noexcept;
 
         void DrawBackground(VkCommandBuffer cmd) noexcept;
 
-        void DrawUI(VkCommandBuffer cmd, VkImageView imageView);
+        void DrawUI(VkCommandBuffer cmd, VkImageView imageView, ImDrawData *uiDrawData);
 
         VkCommandBuffer PrepareCommandBuffer(FrameData& currentFrame, uint32_t* swapchainImageIndex);
 
         void ResizeSwapchain();
 
+        void InitGpuTimestamps() noexcept;
+
+        void InitBindlessHeap() noexcept;
+
+        void SubmitHeadlessFrame(VkCommandBuffer cmd, FrameData &currentFrame, uint64_t uploadWaitValue);
+
+        void ReadGpuTimestamps(FrameData &frame);
+
         void InitTrianglePipeline();
 
         void *m_windowContext;
@@ -134,7 +323,8 @@ namespace Hush
         VkDevice m_device = nullptr;
         VkSurfaceKHR m_surface{};
         VkQueue m_graphicsQueue = nullptr;
-        VkFence m_immediateFence = nullptr;
+        /// @brief Dedicated transfer queue when the device has one, the graphics queue otherwise
+        VkQueue m_transferQueue = nullptr;
         VkCommandBuffer m_immediateCommandBuffer = nullptr;
         VkCommandPool m_immediateCommandPool = nullptr;
         VkDescriptorSet m_drawImageDescriptors = nullptr;
@@ -143,9 +333,11 @@ namespace Hush
         VkPipeline m_gradientPipeline = nullptr;
         VkPipelineLayout m_gradientPipelineLayout = nullptr;
 		VkPipelineLayout m_trianglePipelineLayout = nullptr;
-		VkPipeline m_trianglePipeline = nullptr;
+		/// @brief Registered so shader hot reload can rebuild it
+		const RegisteredPipeline *m_trianglePipeline = nullptr;
 
         uint32_t m_graphicsQueueFamily = 0u;
+        uint32_t m_transferQueueFamily = 0u;
         DescriptorAllocator m_globalDescriptorAllocator{};
 
         VkFormat m_swapchainImageFormat = VkFormat::VK_FORMAT_UNDEFINED;
@@ -156,6 +348,11 @@ namespace Hush
         uint32_t m_height = 0u;
         // draw resources
         AllocatedImage m_drawImage{};
+        /// @brief Shared by every frame in flight, so its last use carries over to the next frame's graph
+        RenderGraphImageState m_drawImageState{};
+        /// @brief Reversed depth, cleared to 0 by the early geometry pass
+        AllocatedImage m_depthImage{};
+        RenderGraphImageState m_depthImageState{};
 
         // Frame related data
         std::array<FrameData, FRAME_OVERLAP> m_frames{};
@@ -164,8 +361,60 @@ namespace Hush
         int m_frameNumber = 0;
         std::unique_ptr<IImGuiForwarder> m_uiForwarder = nullptr;
 
+        /// @brief Written by the game thread through GetDrawContext and PublishFrame, read by Draw
+        TripleBuffer<RenderSnapshot> m_snapshots{};
+        /// @brief PublishFrame sleeps on it while the previous snapshot is still pending, Draw wakes it up on Consume
+        std::mutex m_snapshotMutex;
+        std::condition_variable m_snapshotConsumed;
+        uint64_t m_publishedFrames = 0u;
+        bool m_threadedRendering = false;
+
+        std::vector<GpuPassTiming> m_gpuPassTimings{};
+        FrustumCuller m_frustumCuller{};
+        /// @brief Indices of the surfaces DrawGeometry records, reused every frame
+        std::vector<uint32_t> m_visibleSurfaces{};
+        DrawSorter m_drawSorter{};
+        VulkanDrawInstancer m_drawInstancer{};
+        /// @brief What m_drawInstancer made of m_visibleSurfaces, reused every frame
+        std::vector<VulkanDrawInstancer::InstancedDraw> m_instancedDraws{};
+        DrawStats m_drawStats{};
+        /// @brief Whether the device was created with the indirect draw features m_gpuCuller needs
+        bool m_gpuDrivenSupported = false;
+        VulkanGpuCuller m_gpuCuller{};
+        /// @brief Opaque surfaces m_gpuCuller left to DrawGeometry
+        std::vector<uint32_t> m_cpuSurfaces{};
+        /// @brief Reduced from m_depthImage between the two cull phases, what the late one tests against
+        VulkanDepthPyramid m_depthPyramid{};
+        RenderGraphImageState m_depthPyramidState{};
+        VkDescriptorSetLayout m_depthPyramidSetLayout = nullptr;
+        /// @brief Bindless slots the late cull phase samples the pyramid through
+        uint32_t m_depthPyramidImageIndex = VulkanBindlessHeap::INVALID_INDEX;
+        uint32_t m_depthPyramidSamplerIndex = VulkanBindlessHeap::INVALID_INDEX;
+        ProfileRingBuffer *m_gpuProfilerTrack = nullptr;
+        uint64_t m_lastGpuZoneEndTicks = 0u;
+
+        /// @brief Resources that live as long as the renderer, flushed by Dispose
         VulkanDeletionQueue m_mainDeletionQueue{};
+        /// @brief Retired by frame timeline value as the frames in flight finish, see DestroyAfterFrame
+        VulkanDeletionQueue m_frameDeletionQueue{};
+        /// @brief Signaled by every frame submission, one value per frame
+        VulkanTimeline m_frameTimeline{};
+        /// @brief Signaled by ImmediateSubmit, kept apart so frame values stay one per frame
+        VulkanTimeline m_immediateTimeline{};
+        VulkanUploadManager m_uploadManager{};
+        VulkanGeometryPool m_geometryPool{};
+        VulkanBindlessHeap m_bindlessHeap{};
+        /// @brief Rebuilt by every Draw, see VulkanRenderGraph
+        VulkanRenderGraph m_renderGraph{};
+        /// @brief The heap at set 0 and GPUDrawPushConstants, bound once per frame by DrawGeometry
+        VkPipelineLayout m_bindlessPipelineLayout = nullptr;
+        VulkanPipelineCache m_pipelineCache{};
+        VulkanPipelineRegistry m_pipelineRegistry{};
+        VulkanShaderLibrary m_shaderLibrary{};
+        VulkanShaderHotReload m_shaderHotReload{};
+        double m_pipelineStartupMilliseconds = 0.0;
         VmaAllocator m_allocator = nullptr; // vma lib allocator
         bool m_resizeRequested = false;
+        bool m_isHeadless = false;
     };
 } // namespace Hush
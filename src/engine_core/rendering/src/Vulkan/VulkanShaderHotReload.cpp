@@ -0,0 +1,209 @@
+/*! \file VulkanShaderHotReload.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Recompiles edited GLSL sources and swaps the pipelines that use them while the engine runs
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanShaderHotReload.hpp"
+#include "Logger.hpp"
+#include "Platform.hpp"
+#include "Profiler.hpp"
+#include "VulkanPipelineRegistry.hpp"
+#include "VulkanShaderLibrary.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iterator>
+#include <magic_enum.hpp>
+#include <system_error>
+
+#ifndef HUSH_SHADER_COMPILER
+#define HUSH_SHADER_COMPILER "glslc"
+#endif
+
+/// @brief How long the watcher thread sleeps between checks for Dispose
+static constexpr std::chrono::milliseconds WATCH_TIMEOUT{100};
+
+static constexpr std::array<std::string_view, 8> SOURCE_EXTENSIONS = {
+    ".vert", ".frag", ".comp", ".geom", ".tesc", ".tese", ".task", ".mesh",
+};
+
+static constexpr std::string_view INCLUDE_EXTENSION = ".glsl";
+
+static bool IsShaderSource(const std::filesystem::path &path)
+{
+    std::string extension = path.extension().string();
+    return std::find(SOURCE_EXTENSIONS.begin(), SOURCE_EXTENSIONS.end(), extension) != SOURCE_EXTENSIONS.end();
+}
+
+static double TicksToMilliseconds(uint64_t ticks) noexcept
+{
+    return Hush::Profiler::TicksToMicroseconds(ticks) / 1000.0;
+}
+
+bool Hush::VulkanShaderHotReload::Init(VulkanShaderLibrary &library, VulkanPipelineRegistry &registry)
+{
+    std::filesystem::path root = library.GetAssetRoot();
+    auto watcher = FileWatcher::Create(root);
+    if (!watcher.has_value())
+    {
+        LogFormat(ELogLevel::Warn, "Shader hot reload is off, {} can't be watched ({})", root.string(),
+                  magic_enum::enum_name(watcher.error()));
+        return false;
+    }
+    this->m_library = &library;
+    this->m_registry = &registry;
+    this->m_running.store(true, std::memory_order_release);
+    this->m_thread = std::thread(&VulkanShaderHotReload::WatchLoop, this, std::move(watcher.value()));
+    LogFormat(ELogLevel::Info, "Watching {} for shader changes, compiling with {}", root.string(),
+              HUSH_SHADER_COMPILER);
+    return true;
+}
+
+void Hush::VulkanShaderHotReload::Dispose() noexcept
+{
+    this->m_running.store(false, std::memory_order_release);
+    if (this->m_thread.joinable())
+    {
+        this->m_thread.join();
+    }
+    std::lock_guard lock(this->m_mutex);
+    this->m_finishedReloads.clear();
+}
+
+void Hush::VulkanShaderHotReload::Update(uint64_t retireValue)
+{
+    if (this->m_registry == nullptr)
+    {
+        return;
+    }
+    // Taken before applying, the rebuilds of every reload taken here are already queued in the registry
+    std::vector<FinishedReload> finishedReloads;
+    {
+        std::lock_guard lock(this->m_mutex);
+        finishedReloads.swap(this->m_finishedReloads);
+    }
+    this->m_registry->ApplyRebuilds(retireValue);
+    if (finishedReloads.empty())
+    {
+        return;
+    }
+
+    uint64_t swapTicks = Profiler::Now();
+    std::lock_guard lock(this->m_mutex);
+    for (const FinishedReload &reload : finishedReloads)
+    {
+        if (!reload.succeeded)
+        {
+            this->m_stats.failedReloads++;
+            continue;
+        }
+        this->m_stats.reloads++;
+        this->m_stats.rebuiltPipelines += reload.rebuiltPipelines;
+        this->m_stats.lastLatencyMilliseconds = TicksToMilliseconds(swapTicks - reload.detectedTicks);
+        LogFormat(ELogLevel::Info,
+                  "Reloaded {} in {:.1f} ms (compile {:.1f} ms, {} pipelines rebuilt in {:.1f} ms)", reload.source,
+                  this->m_stats.lastLatencyMilliseconds, reload.compileMilliseconds, reload.rebuiltPipelines,
+                  reload.rebuildMilliseconds);
+    }
+}
+
+Hush::VulkanShaderHotReload::Stats Hush::VulkanShaderHotReload::GetStats() const noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    return this->m_stats;
+}
+
+void Hush::VulkanShaderHotReload::WatchLoop(FileWatcher watcher)
+{
+    while (this->m_running.load(std::memory_order_acquire))
+    {
+        std::vector<std::filesystem::path> changedFiles = watcher.WaitForChanges(WATCH_TIMEOUT);
+        if (changedFiles.empty())
+        {
+            continue;
+        }
+        uint64_t detectedTicks = Profiler::Now();
+
+        std::vector<std::filesystem::path> sources;
+        bool includeChanged = std::any_of(changedFiles.begin(), changedFiles.end(), [](const auto &path) {
+            return path.extension() == INCLUDE_EXTENSION;
+        });
+        if (includeChanged)
+        {
+            // Includes are not tracked per source, everything that may use it is rebuilt
+            std::error_code error;
+            for (const auto &entry : std::filesystem::directory_iterator(watcher.GetDirectory(), error))
+            {
+                if (entry.is_regular_file(error) && IsShaderSource(entry.path()))
+                {
+                    sources.push_back(entry.path());
+                }
+            }
+        }
+        else
+        {
+            std::copy_if(changedFiles.begin(), changedFiles.end(), std::back_inserter(sources), IsShaderSource);
+        }
+
+        for (const std::filesystem::path &source : sources)
+        {
+            FinishedReload reload = this->ReloadSource(source, detectedTicks);
+            std::lock_guard lock(this->m_mutex);
+            this->m_finishedReloads.push_back(std::move(reload));
+        }
+    }
+}
+
+Hush::VulkanShaderHotReload::FinishedReload Hush::VulkanShaderHotReload::ReloadSource(
+    const std::filesystem::path &source, uint64_t detectedTicks)
+{
+    FinishedReload reload{source.filename().string(), detectedTicks, 0.0, 0.0, 0u, false};
+    // Replaces the .spv the library loads, the committed one in res/ or the one the build wrote
+    std::filesystem::path spirvPath = this->m_library->ResolvePath(reload.source + ".spv");
+    std::filesystem::path temporaryPath = spirvPath;
+    temporaryPath += ".tmp";
+
+    // Compiled to a temporary file, a failed compile must not replace the working SPIR-V
+    std::string command = fmt::format("\"{}\" --target-env=vulkan1.3 \"{}\" -o \"{}\"", HUSH_SHADER_COMPILER,
+                                      source.string(), temporaryPath.string());
+#if HUSH_PLATFORM_WIN
+    // cmd.exe strips the outer quotes of the whole line
+    command = "\"" + command + "\"";
+#endif
+    uint64_t compileStart = Profiler::Now();
+    int exitCode = std::system(command.c_str());
+    reload.compileMilliseconds = TicksToMilliseconds(Profiler::Now() - compileStart);
+    std::error_code error;
+    if (exitCode != 0)
+    {
+        LogFormat(ELogLevel::Error, "Compiling {} failed ({}), keeping the previous version", reload.source,
+                  exitCode);
+        std::filesystem::remove(temporaryPath, error);
+        return reload;
+    }
+    std::filesystem::rename(temporaryPath, spirvPath, error);
+    if (error)
+    {
+        LogFormat(ELogLevel::Error, "Could not replace {}: {}", spirvPath.string(), error.message());
+        return reload;
+    }
+
+    const ShaderAsset *previous = nullptr;
+    const ShaderAsset *current = this->m_library->Reload(spirvPath, &previous);
+    if (current == nullptr)
+    {
+        return reload;
+    }
+    reload.succeeded = true;
+    // Shaders nothing loaded yet have no pipelines, and unchanged output keeps the same module
+    if (previous != nullptr && previous != current)
+    {
+        uint64_t rebuildStart = Profiler::Now();
+        reload.rebuiltPipelines = this->m_registry->RebuildWithShader(previous->module, current->module);
+        reload.rebuildMilliseconds = TicksToMilliseconds(Profiler::Now() - rebuildStart);
+    }
+    return reload;
+}
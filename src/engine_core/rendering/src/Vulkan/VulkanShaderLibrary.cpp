@@ -0,0 +1,450 @@
+/*! \file VulkanShaderLibrary.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Shader modules loaded once, cached by content and reflected into pipeline layouts
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanShaderLibrary.hpp"
+#include "Logger.hpp"
+#include "Platform.hpp"
+#include "VkTypes.hpp"
+#include "filesystem/MappedFile.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <volk.h>
+
+namespace
+{
+    /// @brief FNV-1a, fed value by value
+    class Fnv1a
+    {
+      public:
+        template <typename T> void Add(const T &value) noexcept
+        {
+            this->AddBytes(reinterpret_cast<const uint8_t *>(&value), sizeof(T));
+        }
+
+        void AddBytes(const uint8_t *bytes, size_t size) noexcept
+        {
+            for (size_t i = 0u; i < size; i++)
+            {
+                this->m_hash = (this->m_hash ^ bytes[i]) * 1099511628211ull;
+            }
+        }
+
+        [[nodiscard]] uint64_t Get() const noexcept
+        {
+            return this->m_hash;
+        }
+
+      private:
+        uint64_t m_hash = 14695981039346656037ull;
+    };
+
+    /// @brief MurmurHash64A, mixes 8 bytes at a time so it shares no weakness with Fnv1a
+    uint64_t Murmur64(const uint8_t *bytes, size_t size) noexcept
+    {
+        constexpr uint64_t MULTIPLIER = 0xc6a4a7935bd1e995ull;
+        constexpr uint32_t SHIFT = 47u;
+        uint64_t hash = 0x8445d61a4e774912ull ^ (size * MULTIPLIER);
+        size_t blockBytes = size - size % sizeof(uint64_t);
+        for (size_t i = 0u; i < blockBytes; i += sizeof(uint64_t))
+        {
+            uint64_t block = 0u;
+            std::memcpy(&block, bytes + i, sizeof(uint64_t));
+            block *= MULTIPLIER;
+            block ^= block >> SHIFT;
+            block *= MULTIPLIER;
+            hash ^= block;
+            hash *= MULTIPLIER;
+        }
+        if (blockBytes < size)
+        {
+            for (size_t i = blockBytes; i < size; i++)
+            {
+                hash ^= static_cast<uint64_t>(bytes[i]) << (8u * (i - blockBytes));
+            }
+            hash *= MULTIPLIER;
+        }
+        hash ^= hash >> SHIFT;
+        hash *= MULTIPLIER;
+        hash ^= hash >> SHIFT;
+        return hash;
+    }
+} // namespace
+
+static bool HasSameInterface(const Hush::SpirvReflection &lhs, const Hush::SpirvReflection &rhs) noexcept
+{
+    return lhs.pushConstantSize == rhs.pushConstantSize &&
+           std::equal(lhs.bindings.begin(), lhs.bindings.end(), rhs.bindings.begin(), rhs.bindings.end(),
+                      [](const Hush::ReflectedBinding &left, const Hush::ReflectedBinding &right) {
+                          return left.set == right.set && left.binding == right.binding && left.type == right.type &&
+                                 left.descriptorCount == right.descriptorCount;
+                      });
+}
+
+std::filesystem::path Hush::VulkanShaderLibrary::GetDefaultAssetRoot()
+{
+#if HUSH_PLATFORM_WIN
+    char *root = nullptr;
+    size_t rootLength = 0u;
+    if (_dupenv_s(&root, &rootLength, "HUSH_ASSET_ROOT") == 0 && root != nullptr)
+    {
+        std::filesystem::path path = root;
+        free(root);
+        return path;
+    }
+#else
+    if (const char *root = std::getenv("HUSH_ASSET_ROOT"); root != nullptr)
+    {
+        return root;
+    }
+#endif
+    return HUSH_RESOURCES_DIR;
+}
+
+std::filesystem::path Hush::VulkanShaderLibrary::GetDefaultBuiltShaderRoot()
+{
+#ifdef HUSH_BUILT_SHADERS_DIR
+    return HUSH_BUILT_SHADERS_DIR;
+#else
+    return {};
+#endif
+}
+
+void Hush::VulkanShaderLibrary::Init(VkDevice device, std::filesystem::path assetRoot,
+                                     std::filesystem::path builtShaderRoot)
+{
+    std::lock_guard lock(this->m_mutex);
+    this->m_device = device;
+    this->m_assetRoot = std::move(assetRoot);
+    this->m_builtShaderRoot = std::move(builtShaderRoot);
+    this->m_loads = 0u;
+    this->m_sharedLoads = 0u;
+    LogFormat(ELogLevel::Debug, "Loading shaders from {} and {}", this->m_builtShaderRoot.string(),
+              this->m_assetRoot.string());
+}
+
+void Hush::VulkanShaderLibrary::Dispose() noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    if (this->m_device == nullptr)
+    {
+        return;
+    }
+    for (auto &[key, pipelineLayout] : this->m_pipelineLayouts)
+    {
+        vkDestroyPipelineLayout(this->m_device, pipelineLayout.layout, nullptr);
+    }
+    for (auto &[key, setLayout] : this->m_setLayouts)
+    {
+        vkDestroyDescriptorSetLayout(this->m_device, setLayout.layout, nullptr);
+    }
+    for (auto &[key, shader] : this->m_shaders)
+    {
+        vkDestroyShaderModule(this->m_device, shader->module, nullptr);
+    }
+    this->m_pipelineLayouts.clear();
+    this->m_setLayouts.clear();
+    this->m_pathCache.clear();
+    this->m_shaders.clear();
+    this->m_device = nullptr;
+}
+
+void Hush::VulkanShaderLibrary::SetAssetRoot(std::filesystem::path root)
+{
+    std::lock_guard lock(this->m_mutex);
+    this->m_assetRoot = std::move(root);
+}
+
+std::filesystem::path Hush::VulkanShaderLibrary::GetAssetRoot() const
+{
+    std::lock_guard lock(this->m_mutex);
+    return this->m_assetRoot;
+}
+
+std::filesystem::path Hush::VulkanShaderLibrary::ResolvePath(const std::filesystem::path &path) const
+{
+    std::lock_guard lock(this->m_mutex);
+    return this->ResolvePathLocked(path);
+}
+
+const Hush::ShaderAsset *Hush::VulkanShaderLibrary::Load(const std::filesystem::path &path)
+{
+    std::lock_guard lock(this->m_mutex);
+    this->m_loads++;
+    std::filesystem::path resolvedPath = this->ResolvePathLocked(path);
+    std::string pathKey = resolvedPath.string();
+    if (auto cached = this->m_pathCache.find(pathKey); cached != this->m_pathCache.end())
+    {
+        this->m_sharedLoads++;
+        return cached->second;
+    }
+    return this->LoadFileLocked(resolvedPath, std::move(pathKey));
+}
+
+const Hush::ShaderAsset *Hush::VulkanShaderLibrary::Reload(const std::filesystem::path &path,
+                                                           const ShaderAsset **outPrevious)
+{
+    std::lock_guard lock(this->m_mutex);
+    std::filesystem::path resolvedPath = this->ResolvePathLocked(path);
+    std::string pathKey = resolvedPath.string();
+    const ShaderAsset *previous = nullptr;
+    if (auto cached = this->m_pathCache.find(pathKey); cached != this->m_pathCache.end())
+    {
+        previous = cached->second;
+    }
+    if (outPrevious != nullptr)
+    {
+        *outPrevious = previous;
+    }
+
+    const ShaderAsset *current = this->LoadFileLocked(resolvedPath, std::move(pathKey));
+    if (current != nullptr && previous != nullptr && !HasSameInterface(previous->reflection, current->reflection))
+    {
+        LogFormat(ELogLevel::Warn, "{} changed its bindings or push constants, pipeline layouts built from it are "
+                                   "not updated until the next start",
+                  path.string());
+    }
+    return current;
+}
+
+const Hush::ShaderAsset *Hush::VulkanShaderLibrary::LoadFileLocked(const std::filesystem::path &resolvedPath,
+                                                                   std::string pathKey)
+{
+    auto file = MappedFile::Open(resolvedPath);
+    if (!file.has_value())
+    {
+        LogFormat(ELogLevel::Error, "Could not load shader {} ({})", pathKey, magic_enum::enum_name(file.error()));
+        return nullptr;
+    }
+    const uint8_t *data = file.value().GetData();
+    size_t size = file.value().GetSize();
+    if (size % sizeof(uint32_t) != 0u)
+    {
+        LogFormat(ELogLevel::Error, "Shader {} is not SPIR-V, its size is not a multiple of 4", pathKey);
+        return nullptr;
+    }
+
+    Fnv1a contentHash;
+    contentHash.AddBytes(data, size);
+    contentHash.Add(size);
+    uint64_t contentCheck = Murmur64(data, size);
+    auto [sharedBegin, sharedEnd] = this->m_shaders.equal_range(contentHash.Get());
+    for (auto shared = sharedBegin; shared != sharedEnd; ++shared)
+    {
+        const ShaderAsset &sharedShader = *shared->second;
+        if (sharedShader.codeSize == size && sharedShader.contentCheck == contentCheck)
+        {
+            this->m_sharedLoads++;
+            this->m_pathCache.insert_or_assign(std::move(pathKey), &sharedShader);
+            return &sharedShader;
+        }
+    }
+
+    // Mappings are page aligned, the words can go to the driver straight from the file
+    const auto *words = reinterpret_cast<const uint32_t *>(data);
+    auto shader = std::make_unique<ShaderAsset>();
+    if (!SpirvReflection::Reflect(words, size / sizeof(uint32_t), shader->reflection))
+    {
+        LogFormat(ELogLevel::Error, "Could not reflect shader {}", pathKey);
+        return nullptr;
+    }
+
+    VkShaderModuleCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.codeSize = size;
+    createInfo.pCode = words;
+    if (vkCreateShaderModule(this->m_device, &createInfo, nullptr, &shader->module) != VK_SUCCESS)
+    {
+        LogFormat(ELogLevel::Error, "Could not create the shader module for {}", pathKey);
+        return nullptr;
+    }
+    shader->contentHash = contentHash.Get();
+    shader->contentCheck = contentCheck;
+    shader->codeSize = size;
+
+    const ShaderAsset *loaded = shader.get();
+    this->m_shaders.emplace(shader->contentHash, std::move(shader));
+    this->m_pathCache.insert_or_assign(std::move(pathKey), loaded);
+    return loaded;
+}
+
+VkPipelineLayout Hush::VulkanShaderLibrary::GetPipelineLayout(const std::vector<const ShaderAsset *> &shaders,
+                                                              const std::vector<SetLayoutOverride> &setOverrides)
+{
+    std::vector<std::vector<VkDescriptorSetLayoutBinding>> sets;
+    VkPushConstantRange pushConstants{};
+    for (const ShaderAsset *shader : shaders)
+    {
+        const SpirvReflection &reflection = shader->reflection;
+        if (reflection.pushConstantSize > 0u)
+        {
+            pushConstants.stageFlags |= reflection.stage;
+            pushConstants.size = std::max(pushConstants.size, reflection.pushConstantSize);
+        }
+        for (const ReflectedBinding &reflected : reflection.bindings)
+        {
+            if (sets.size() <= reflected.set)
+            {
+                sets.resize(static_cast<size_t>(reflected.set) + 1u);
+            }
+            std::vector<VkDescriptorSetLayoutBinding> &bindings = sets[reflected.set];
+            auto existing = std::find_if(bindings.begin(), bindings.end(), [&](const auto &binding) {
+                return binding.binding == reflected.binding;
+            });
+            if (existing == bindings.end())
+            {
+                VkDescriptorSetLayoutBinding binding{};
+                binding.binding = reflected.binding;
+                binding.descriptorType = reflected.type;
+                binding.descriptorCount = reflected.descriptorCount;
+                binding.stageFlags = reflection.stage;
+                bindings.push_back(binding);
+            }
+            else if (existing->descriptorType != reflected.type ||
+                     existing->descriptorCount != reflected.descriptorCount)
+            {
+                LogFormat(ELogLevel::Error, "Shader stages disagree on set {} binding {}", reflected.set,
+                          reflected.binding);
+                return nullptr;
+            }
+            else
+            {
+                existing->stageFlags |= reflection.stage;
+            }
+        }
+    }
+    for (const SetLayoutOverride &setOverride : setOverrides)
+    {
+        if (sets.size() <= setOverride.set)
+        {
+            sets.resize(static_cast<size_t>(setOverride.set) + 1u);
+        }
+    }
+
+    std::vector<VkDescriptorSetLayout> setLayouts(sets.size(), nullptr);
+    std::lock_guard lock(this->m_mutex);
+    for (size_t set = 0u; set < sets.size(); set++)
+    {
+        auto setOverride = std::find_if(setOverrides.begin(), setOverrides.end(),
+                                        [set](const SetLayoutOverride &entry) { return entry.set == set; });
+        if (setOverride != setOverrides.end())
+        {
+            setLayouts[set] = setOverride->layout;
+            continue;
+        }
+        std::vector<VkDescriptorSetLayoutBinding> &bindings = sets[set];
+        if (std::any_of(bindings.begin(), bindings.end(), [](const auto &binding) {
+                return binding.descriptorCount == 0u;
+            }))
+        {
+            LogFormat(ELogLevel::Error, "Set {} has a runtime sized array, it needs a SetLayoutOverride", set);
+            return nullptr;
+        }
+        std::sort(bindings.begin(), bindings.end(),
+                  [](const auto &lhs, const auto &rhs) { return lhs.binding < rhs.binding; });
+        setLayouts[set] = this->GetSetLayout(bindings);
+    }
+
+    Fnv1a layoutHash;
+    for (VkDescriptorSetLayout setLayout : setLayouts)
+    {
+        layoutHash.Add(setLayout);
+    }
+    layoutHash.Add(pushConstants.stageFlags);
+    layoutHash.Add(pushConstants.size);
+    auto [cachedBegin, cachedEnd] = this->m_pipelineLayouts.equal_range(layoutHash.Get());
+    for (auto cached = cachedBegin; cached != cachedEnd; ++cached)
+    {
+        const CachedPipelineLayout &entry = cached->second;
+        if (entry.setLayouts == setLayouts && entry.pushConstants.stageFlags == pushConstants.stageFlags &&
+            entry.pushConstants.size == pushConstants.size)
+        {
+            return entry.layout;
+        }
+    }
+
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+    layoutInfo.pSetLayouts = setLayouts.data();
+    layoutInfo.pushConstantRangeCount = pushConstants.size > 0u ? 1u : 0u;
+    layoutInfo.pPushConstantRanges = &pushConstants;
+    VkPipelineLayout pipelineLayout = nullptr;
+    HUSH_VK_ASSERT(vkCreatePipelineLayout(this->m_device, &layoutInfo, nullptr, &pipelineLayout),
+                   "Reflected pipeline layout creation failed!");
+    this->m_pipelineLayouts.emplace(layoutHash.Get(),
+                                    CachedPipelineLayout{std::move(setLayouts), pushConstants, pipelineLayout});
+    return pipelineLayout;
+}
+
+Hush::VulkanShaderLibrary::Stats Hush::VulkanShaderLibrary::GetStats() const noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    Stats stats{};
+    stats.moduleCount = static_cast<uint32_t>(this->m_shaders.size());
+    stats.setLayoutCount = static_cast<uint32_t>(this->m_setLayouts.size());
+    stats.pipelineLayoutCount = static_cast<uint32_t>(this->m_pipelineLayouts.size());
+    stats.loads = this->m_loads;
+    stats.sharedLoads = this->m_sharedLoads;
+    return stats;
+}
+
+VkDescriptorSetLayout Hush::VulkanShaderLibrary::GetSetLayout(const std::vector<VkDescriptorSetLayoutBinding> &bindings)
+{
+    Fnv1a bindingsHash;
+    for (const VkDescriptorSetLayoutBinding &binding : bindings)
+    {
+        bindingsHash.Add(binding.binding);
+        bindingsHash.Add(binding.descriptorType);
+        bindingsHash.Add(binding.descriptorCount);
+        bindingsHash.Add(binding.stageFlags);
+    }
+    auto [cachedBegin, cachedEnd] = this->m_setLayouts.equal_range(bindingsHash.Get());
+    for (auto cached = cachedBegin; cached != cachedEnd; ++cached)
+    {
+        const CachedSetLayout &entry = cached->second;
+        if (std::equal(entry.bindings.begin(), entry.bindings.end(), bindings.begin(), bindings.end(),
+                       [](const VkDescriptorSetLayoutBinding &lhs, const VkDescriptorSetLayoutBinding &rhs) {
+                           return lhs.binding == rhs.binding && lhs.descriptorType == rhs.descriptorType &&
+                                  lhs.descriptorCount == rhs.descriptorCount && lhs.stageFlags == rhs.stageFlags;
+                       }))
+        {
+            return entry.layout;
+        }
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+    VkDescriptorSetLayout setLayout = nullptr;
+    HUSH_VK_ASSERT(vkCreateDescriptorSetLayout(this->m_device, &layoutInfo, nullptr, &setLayout),
+                   "Reflected descriptor set layout creation failed!");
+    this->m_setLayouts.emplace(bindingsHash.Get(), CachedSetLayout{bindings, setLayout});
+    return setLayout;
+}
+
+std::filesystem::path Hush::VulkanShaderLibrary::ResolvePathLocked(const std::filesystem::path &path) const
+{
+    if (path.is_absolute())
+    {
+        return path.lexically_normal();
+    }
+    // The build's output shadows the asset root, res/ only holds the shaders with a committed .spv
+    if (!this->m_builtShaderRoot.empty())
+    {
+        std::filesystem::path builtPath = (this->m_builtShaderRoot / path).lexically_normal();
+        std::error_code error;
+        if (std::filesystem::is_regular_file(builtPath, error))
+        {
+            return builtPath;
+        }
+    }
+    return (this->m_assetRoot / path).lexically_normal();
+}
@@ -0,0 +1,143 @@
+/*! \file VulkanShaderLibrary.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Shader modules loaded once, cached by content and reflected into pipeline layouts
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include "SpirvReflection.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    struct ShaderAsset
+    {
+        VkShaderModule module = nullptr;
+        /// @brief FNV-1a of the SPIR-V words and their size
+        uint64_t contentHash = 0u;
+        /// @brief MurmurHash64A of the SPIR-V words, independent of contentHash. Loads are only shared when both
+        /// hashes and the size match, without keeping a copy of the words around
+        uint64_t contentCheck = 0u;
+        size_t codeSize = 0u;
+        SpirvReflection reflection;
+    };
+
+    /// @brief Owns every shader module of the renderer. Files are memory mapped and handed to the driver without a
+    /// copy, a path is only read the first time it's loaded, and files with the same contents share one module.
+    /// Every cache is keyed by a hash and checks a second hash of the contents, or the full description, on a hit.
+    /// Collisions get their own entry.
+    /// Pipeline layouts are generated from the shaders' reflection and cached, so materials built from the same
+    /// shaders share their set layouts and pipeline layout instead of writing them by hand.
+    /// Modules and layouts live until Dispose, their handles stay stable which is what VulkanPipelineRegistry hashes.
+    /// Thread safe
+    class VulkanShaderLibrary
+    {
+      public:
+        /// @brief Replaces the reflected layout of one set, for sets shared with other pipelines or with bindings
+        /// reflection can't size (runtime arrays) or type (dynamic buffers)
+        struct SetLayoutOverride
+        {
+            uint32_t set;
+            VkDescriptorSetLayout layout;
+        };
+
+        struct Stats
+        {
+            uint32_t moduleCount = 0u;
+            uint32_t setLayoutCount = 0u;
+            uint32_t pipelineLayoutCount = 0u;
+            /// @brief Load calls since Init
+            uint32_t loads = 0u;
+            /// @brief Load and Reload calls answered without creating a module
+            uint32_t sharedLoads = 0u;
+        };
+
+        /// @brief HUSH_ASSET_ROOT from the environment if set, HUSH_RESOURCES_DIR otherwise
+        [[nodiscard]] static std::filesystem::path GetDefaultAssetRoot();
+
+        /// @brief HUSH_BUILT_SHADERS_DIR, where the build compiles the shaders that have no committed .spv
+        [[nodiscard]] static std::filesystem::path GetDefaultBuiltShaderRoot();
+
+        /// @param builtShaderRoot searched before assetRoot for relative paths, empty to only use assetRoot
+        void Init(VkDevice device, std::filesystem::path assetRoot = GetDefaultAssetRoot(),
+                  std::filesystem::path builtShaderRoot = GetDefaultBuiltShaderRoot());
+
+        /// @brief Destroys every module and layout right away, the GPU must be idle
+        void Dispose() noexcept;
+
+        /// @brief Relative paths given to Load from now on resolve against root, already loaded shaders stay cached
+        void SetAssetRoot(std::filesystem::path root);
+
+        [[nodiscard]] std::filesystem::path GetAssetRoot() const;
+
+        /// @brief Absolute paths are returned as is, relative ones are appended to the built shader root if the file
+        /// is there, to the asset root otherwise
+        [[nodiscard]] std::filesystem::path ResolvePath(const std::filesystem::path &path) const;
+
+        /// @brief Loads and reflects a SPIR-V file, or returns the shader already loaded from that path
+        /// @return nullptr if the file is missing or not valid SPIR-V
+        const ShaderAsset *Load(const std::filesystem::path &path);
+
+        /// @brief Reads the file again and points the path at the result, a new module if the contents changed. The
+        /// previous module stays alive for the pipelines built from it, until Dispose
+        /// @param outPrevious the shader the path resolved to before, nullptr if it was never loaded
+        /// @return nullptr if the file is missing or not valid SPIR-V, the path keeps its previous shader then
+        const ShaderAsset *Reload(const std::filesystem::path &path, const ShaderAsset **outPrevious = nullptr);
+
+        /// @brief Pipeline layout covering every binding and the push constants of the shaders. Bindings in
+        /// several stages are merged, and the push constant range spans every stage that declares a block
+        /// @return nullptr if the shaders disagree on a binding or a set can't be built from reflection
+        VkPipelineLayout GetPipelineLayout(const std::vector<const ShaderAsset *> &shaders,
+                                           const std::vector<SetLayoutOverride> &setOverrides = {});
+
+        [[nodiscard]] Stats GetStats() const noexcept;
+
+      private:
+        /// @brief Maps, hashes and reflects the file, sharing the module of identical contents
+        const ShaderAsset *LoadFileLocked(const std::filesystem::path &resolvedPath, std::string pathKey);
+
+        /// @brief Cached set layout for the bindings, which must be sorted by binding
+        VkDescriptorSetLayout GetSetLayout(const std::vector<VkDescriptorSetLayoutBinding> &bindings);
+
+        [[nodiscard]] std::filesystem::path ResolvePathLocked(const std::filesystem::path &path) const;
+
+        struct CachedSetLayout
+        {
+            std::vector<VkDescriptorSetLayoutBinding> bindings;
+            VkDescriptorSetLayout layout;
+        };
+
+        struct CachedPipelineLayout
+        {
+            std::vector<VkDescriptorSetLayout> setLayouts;
+            VkPushConstantRange pushConstants;
+            VkPipelineLayout layout;
+        };
+
+        VkDevice m_device = nullptr;
+        std::filesystem::path m_assetRoot;
+        std::filesystem::path m_builtShaderRoot;
+
+        /// @brief By content hash
+        std::unordered_multimap<uint64_t, std::unique_ptr<ShaderAsset>> m_shaders;
+        /// @brief Resolved path to its shader, saves the file read on repeated loads
+        std::unordered_map<std::string, const ShaderAsset *> m_pathCache;
+        /// @brief By hash of the bindings
+        std::unordered_multimap<uint64_t, CachedSetLayout> m_setLayouts;
+        /// @brief By hash of the set layouts and push constants
+        std::unordered_multimap<uint64_t, CachedPipelineLayout> m_pipelineLayouts;
+        uint32_t m_loads = 0u;
+        uint32_t m_sharedLoads = 0u;
+        mutable std::mutex m_mutex;
+    };
+} // namespace Hush
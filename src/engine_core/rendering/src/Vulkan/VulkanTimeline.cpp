@@ -0,0 +1,100 @@
+/*! \file VulkanTimeline.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Timeline semaphore that orders the submissions to a queue
+*/
+
+#include "VulkanTimeline.hpp"
+#include "Assertions.hpp"
+#include "VkTypes.hpp"
+#include "VkUtilsFactory.hpp"
+#include <volk.h>
+
+void Hush::VulkanTimeline::Init(VkDevice device)
+{
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0u;
+
+    VkSemaphoreCreateInfo semaphoreInfo = VkUtilsFactory::CreateSemaphoreInfo();
+    semaphoreInfo.pNext = &typeInfo;
+    HUSH_VK_ASSERT(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &this->m_semaphore),
+                   "Creating timeline semaphore failed!");
+    this->m_lastSubmittedValue = 0u;
+    this->m_completedValue = 0u;
+}
+
+void Hush::VulkanTimeline::Dispose(VkDevice device) noexcept
+{
+    if (this->m_semaphore != nullptr)
+    {
+        vkDestroySemaphore(device, this->m_semaphore, nullptr);
+        this->m_semaphore = nullptr;
+    }
+}
+
+uint64_t Hush::VulkanTimeline::Advance() noexcept
+{
+    return ++this->m_lastSubmittedValue;
+}
+
+uint64_t Hush::VulkanTimeline::GetLastSubmittedValue() const noexcept
+{
+    return this->m_lastSubmittedValue;
+}
+
+uint64_t Hush::VulkanTimeline::GetCompletedValue(VkDevice device) noexcept
+{
+    if (this->m_completedValue < this->m_lastSubmittedValue)
+    {
+        uint64_t value = 0u;
+        HUSH_VK_ASSERT(vkGetSemaphoreCounterValue(device, this->m_semaphore, &value),
+                       "Reading timeline semaphore failed!");
+        this->m_completedValue = value;
+    }
+    return this->m_completedValue;
+}
+
+bool Hush::VulkanTimeline::IsComplete(VkDevice device, uint64_t value) noexcept
+{
+    return value <= this->m_completedValue || value <= this->GetCompletedValue(device);
+}
+
+VkResult Hush::VulkanTimeline::Wait(VkDevice device, uint64_t value, uint64_t timeoutNs) noexcept
+{
+    if (this->IsComplete(device, value))
+    {
+        return VK_SUCCESS;
+    }
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1u;
+    waitInfo.pSemaphores = &this->m_semaphore;
+    waitInfo.pValues = &value;
+    VkResult rc = vkWaitSemaphores(device, &waitInfo, timeoutNs);
+    if (rc == VK_SUCCESS)
+    {
+        this->m_completedValue = value > this->m_completedValue ? value : this->m_completedValue;
+    }
+    return rc;
+}
+
+VkSemaphoreSubmitInfo Hush::VulkanTimeline::CreateSignalInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const
+{
+    VkSemaphoreSubmitInfo signalInfo = VkUtilsFactory::CreateSemaphoreSubmitInfo(stageMask, this->m_semaphore);
+    signalInfo.value = value;
+    return signalInfo;
+}
+
+VkSemaphoreSubmitInfo Hush::VulkanTimeline::CreateWaitInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const
+{
+    VkSemaphoreSubmitInfo waitInfo = VkUtilsFactory::CreateSemaphoreSubmitInfo(stageMask, this->m_semaphore);
+    waitInfo.value = value;
+    return waitInfo;
+}
+
+VkSemaphore Hush::VulkanTimeline::GetSemaphore() const noexcept
+{
+    return this->m_semaphore;
+}
@@ -0,0 +1,51 @@
+/*! \file VulkanTimeline.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Timeline semaphore that orders the submissions to a queue
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    /// @brief Timeline semaphore (Vulkan 1.2) owned by one stream of submissions. Every submission signals the next
+    /// value, so CPU waits, resource retirement and dependencies from other queues are all "wait for value X".
+    /// Values must be signaled in the order they were handed out, so Advance and the submit go together on the thread
+    /// that owns the queue
+    class VulkanTimeline
+    {
+      public:
+        void Init(VkDevice device);
+
+        void Dispose(VkDevice device) noexcept;
+
+        /// @brief Hands out the value the next submission must signal
+        uint64_t Advance() noexcept;
+
+        /// @brief Value of the last submission, everything submitted so far is done once the GPU reaches it
+        [[nodiscard]] uint64_t GetLastSubmittedValue() const noexcept;
+
+        /// @brief Value the GPU finished last, only queries the semaphore when the cached one isn't enough
+        uint64_t GetCompletedValue(VkDevice device) noexcept;
+
+        bool IsComplete(VkDevice device, uint64_t value) noexcept;
+
+        /// @brief Blocks until the GPU reaches the value, returns right away if it already did
+        /// @return VK_TIMEOUT if it took longer than timeoutNs
+        VkResult Wait(VkDevice device, uint64_t value, uint64_t timeoutNs) noexcept;
+
+        [[nodiscard]] VkSemaphoreSubmitInfo CreateSignalInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const;
+
+        [[nodiscard]] VkSemaphoreSubmitInfo CreateWaitInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const;
+
+        [[nodiscard]] VkSemaphore GetSemaphore() const noexcept;
+
+      private:
+        VkSemaphore m_semaphore = nullptr;
+        uint64_t m_lastSubmittedValue = 0u;
+        uint64_t m_completedValue = 0u;
+    };
+} // namespace Hush
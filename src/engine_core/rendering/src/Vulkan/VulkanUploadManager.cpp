@@ -0,0 +1,404 @@
+/*! \file VulkanUploadManager.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Asynchronous buffer and image uploads through the transfer queue
+*/
+
+#define VK_NO_PROTOTYPES
+#include "VulkanUploadManager.hpp"
+#include "Assertions.hpp"
+#include "Logger.hpp"
+#include "Profiler.hpp"
+#include "VkTypes.hpp"
+#include "VkUtilsFactory.hpp"
+#include "vk_mem_alloc.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <volk.h>
+
+namespace
+{
+    /// @brief Reusing a batch only waits this long for the transfer queue, it should be long done by then
+    constexpr uint64_t BATCH_REUSE_TIMEOUT_NS = 10'000'000'000ull;
+
+    uint64_t AlignUp(uint64_t value, uint64_t alignment) noexcept
+    {
+        return (value + alignment - 1u) / alignment * alignment;
+    }
+} // namespace
+
+void Hush::VulkanUploadManager::Init(VkDevice device, VmaAllocator allocator, VkQueue transferQueue,
+                                     uint32_t transferQueueFamily, uint32_t graphicsQueueFamily,
+                                     VkDeviceSize stagingCapacity)
+{
+    this->m_device = device;
+    this->m_allocator = allocator;
+    this->m_transferQueue = transferQueue;
+    this->m_transferQueueFamily = transferQueueFamily;
+    this->m_graphicsQueueFamily = graphicsQueueFamily;
+    this->m_needsOwnershipTransfer = transferQueueFamily != graphicsQueueFamily;
+    this->m_timeline.Init(device);
+
+    // Persistently mapped, the CPU only ever writes it front to back
+    this->m_stagingCapacity = AlignUp(stagingCapacity, STAGING_ALIGNMENT);
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = this->m_stagingCapacity;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo allocationInfo{};
+    allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocationInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo stagingInfo{};
+    HUSH_VK_ASSERT(vmaCreateBuffer(allocator, &bufferInfo, &allocationInfo, &this->m_stagingBuffer,
+                                   &this->m_stagingAllocation, &stagingInfo),
+                   "Staging ring allocation failed!");
+    this->m_stagingData = static_cast<uint8_t *>(stagingInfo.pMappedData);
+
+    VkCommandPoolCreateInfo commandPoolInfo =
+        VkUtilsFactory::CreateCommandPoolInfo(transferQueueFamily, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+    for (UploadBatch &batch : this->m_batches)
+    {
+        HUSH_VK_ASSERT(vkCreateCommandPool(device, &commandPoolInfo, nullptr, &batch.commandPool),
+                       "Creating upload command pool failed!");
+        VkCommandBufferAllocateInfo cmdAllocInfo = VkUtilsFactory::CreateCommandBufferAllocateInfo(batch.commandPool);
+        HUSH_VK_ASSERT(vkAllocateCommandBuffers(device, &cmdAllocInfo, &batch.commandBuffer),
+                       "Allocating upload command buffer failed!");
+    }
+
+    LogFormat(ELogLevel::Debug, "Upload manager on queue family {} ({} the graphics one), {} KB of staging memory",
+              transferQueueFamily, this->m_needsOwnershipTransfer ? "apart from" : "shared with",
+              this->m_stagingCapacity / 1024u);
+}
+
+void Hush::VulkanUploadManager::Dispose() noexcept
+{
+    if (this->m_device == nullptr)
+    {
+        return;
+    }
+    VkResult rc = this->m_timeline.Wait(this->m_device, this->m_timeline.GetLastSubmittedValue(),
+                                        BATCH_REUSE_TIMEOUT_NS);
+    if (rc != VK_SUCCESS)
+    {
+        LogWarn("Uploads were still in flight while disposing of the upload manager");
+    }
+    this->m_deletionQueue.Flush(this->m_device, this->m_allocator);
+    for (UploadBatch &batch : this->m_batches)
+    {
+        vkDestroyCommandPool(this->m_device, batch.commandPool, nullptr);
+        batch = UploadBatch{};
+    }
+    vmaDestroyBuffer(this->m_allocator, this->m_stagingBuffer, this->m_stagingAllocation);
+    this->m_stagingBuffer = nullptr;
+    this->m_stagingAllocation = nullptr;
+    this->m_stagingData = nullptr;
+    this->m_timeline.Dispose(this->m_device);
+    this->m_device = nullptr;
+}
+
+Hush::UploadTicket Hush::VulkanUploadManager::UploadBuffer(VkBuffer destination, VkDeviceSize destinationOffset,
+                                                           const void *data, VkDeviceSize size,
+                                                           bool concurrentDestination)
+{
+    std::lock_guard lock(this->m_mutex);
+    UploadBatch &batch = this->GetOpenBatch();
+
+    VkDeviceSize stagingOffset = 0u;
+    VkBuffer stagingBuffer = this->WriteStaging(data, size, &stagingOffset);
+    VkBufferCopy region{};
+    region.srcOffset = stagingOffset;
+    region.dstOffset = destinationOffset;
+    region.size = size;
+    vkCmdCopyBuffer(batch.commandBuffer, stagingBuffer, destination, 1u, &region);
+
+    VkBufferMemoryBarrier2 &barrier = this->m_bufferBarriers.emplace_back();
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    this->SetReleaseFamilies(barrier);
+    if (concurrentDestination)
+    {
+        // No owner to hand it to, the frame's wait on the upload timeline makes the copy visible
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    }
+    barrier.buffer = destination;
+    barrier.offset = destinationOffset;
+    barrier.size = size;
+
+    // The open batch signals the next value of the timeline
+    return UploadTicket{this->m_timeline.GetLastSubmittedValue() + 1u};
+}
+
+Hush::UploadTicket Hush::VulkanUploadManager::UploadImage(VkImage destination, VkExtent3D extent,
+                                                          VkImageLayout finalLayout, const void *data,
+                                                          VkDeviceSize size)
+{
+    std::lock_guard lock(this->m_mutex);
+    UploadBatch &batch = this->GetOpenBatch();
+
+    VkDeviceSize stagingOffset = 0u;
+    VkBuffer stagingBuffer = this->WriteStaging(data, size, &stagingOffset);
+
+    VkImageMemoryBarrier2 toTransfer{};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    toTransfer.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+    toTransfer.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    toTransfer.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = destination;
+    toTransfer.subresourceRange = VkUtilsFactory::ImageSubResourceRange(VK_IMAGE_ASPECT_COLOR_BIT);
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = 1u;
+    dependencyInfo.pImageMemoryBarriers = &toTransfer;
+    vkCmdPipelineBarrier2(batch.commandBuffer, &dependencyInfo);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = stagingOffset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1u;
+    region.imageExtent = extent;
+    vkCmdCopyBufferToImage(batch.commandBuffer, stagingBuffer, destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1u,
+                           &region);
+
+    VkImageMemoryBarrier2 &barrier = this->m_imageBarriers.emplace_back(toTransfer);
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = finalLayout;
+    this->SetReleaseFamilies(barrier);
+
+    return UploadTicket{this->m_timeline.GetLastSubmittedValue() + 1u};
+}
+
+uint64_t Hush::VulkanUploadManager::SubmitPending(VkCommandBuffer graphicsCmd)
+{
+    HUSH_PROFILE_SCOPE("VulkanUploadManager::SubmitPending");
+    std::lock_guard lock(this->m_mutex);
+    if (!this->m_isBatchOpen)
+    {
+        return 0u;
+    }
+    UploadBatch &batch = this->m_batches.at(this->m_openBatchIndex);
+
+    // Release half of the ownership transfer, its destination stage is ignored. On a shared family this is a plain
+    // barrier that makes the copies visible to everything after them
+    VkPipelineStageFlags2 releaseStage =
+        this->m_needsOwnershipTransfer ? VK_PIPELINE_STAGE_2_NONE : VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    VkAccessFlags2 releaseAccess = this->m_needsOwnershipTransfer ? VK_ACCESS_2_NONE : VK_ACCESS_2_MEMORY_READ_BIT;
+    for (VkBufferMemoryBarrier2 &barrier : this->m_bufferBarriers)
+    {
+        barrier.dstStageMask = releaseStage;
+        barrier.dstAccessMask = releaseAccess;
+    }
+    for (VkImageMemoryBarrier2 &barrier : this->m_imageBarriers)
+    {
+        barrier.dstStageMask = releaseStage;
+        barrier.dstAccessMask = releaseAccess;
+    }
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(this->m_bufferBarriers.size());
+    dependencyInfo.pBufferMemoryBarriers = this->m_bufferBarriers.data();
+    dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(this->m_imageBarriers.size());
+    dependencyInfo.pImageMemoryBarriers = this->m_imageBarriers.data();
+    vkCmdPipelineBarrier2(batch.commandBuffer, &dependencyInfo);
+    HUSH_VK_ASSERT(vkEndCommandBuffer(batch.commandBuffer), "Ending upload command buffer failed!");
+
+    batch.timelineValue = this->m_timeline.Advance();
+    batch.stagingEnd = this->m_stagingHead;
+    VkCommandBufferSubmitInfo cmdInfo = VkUtilsFactory::CreateCommandBufferSubmitInfo(batch.commandBuffer);
+    VkSemaphoreSubmitInfo signalInfo =
+        this->m_timeline.CreateSignalInfo(batch.timelineValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    VkSubmitInfo2 submit = VkUtilsFactory::SubmitInfo(&cmdInfo, &signalInfo, nullptr);
+    HUSH_VK_ASSERT(vkQueueSubmit2(this->m_transferQueue, 1u, &submit, nullptr), "Upload submit failed!");
+
+    if (this->m_needsOwnershipTransfer)
+    {
+        // Acquire half, same families and layouts as the release. The frame waits on the timeline before it runs, so
+        // there's no source stage to wait for
+        for (VkBufferMemoryBarrier2 &barrier : this->m_bufferBarriers)
+        {
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+            barrier.srcAccessMask = VK_ACCESS_2_NONE;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+        }
+        for (VkImageMemoryBarrier2 &barrier : this->m_imageBarriers)
+        {
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+            barrier.srcAccessMask = VK_ACCESS_2_NONE;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+        }
+        vkCmdPipelineBarrier2(graphicsCmd, &dependencyInfo);
+    }
+
+    // Clearing keeps the capacity, so steady streaming doesn't allocate
+    this->m_bufferBarriers.clear();
+    this->m_imageBarriers.clear();
+    this->m_isBatchOpen = false;
+    this->m_openBatchIndex = (this->m_openBatchIndex + 1u) % BATCH_COUNT;
+    this->RetireCompletedBatches();
+    return batch.timelineValue;
+}
+
+VkSemaphoreSubmitInfo Hush::VulkanUploadManager::CreateWaitInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const
+{
+    return this->m_timeline.CreateWaitInfo(value, stageMask);
+}
+
+bool Hush::VulkanUploadManager::IsComplete(const UploadTicket &ticket) noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    return this->m_timeline.IsComplete(this->m_device, ticket.timelineValue);
+}
+
+VkResult Hush::VulkanUploadManager::Wait(const UploadTicket &ticket, uint64_t timeoutNs) noexcept
+{
+    {
+        std::lock_guard lock(this->m_mutex);
+        if (this->m_timeline.IsComplete(this->m_device, ticket.timelineValue))
+        {
+            return VK_SUCCESS;
+        }
+        // Waiting on the open batch would never return, it's only submitted by the next frame
+        if (ticket.timelineValue > this->m_timeline.GetLastSubmittedValue())
+        {
+            return VK_NOT_READY;
+        }
+    }
+    // Don't hold the lock while blocked, the other threads can keep queuing uploads
+    VkSemaphore semaphore = this->m_timeline.GetSemaphore();
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1u;
+    waitInfo.pSemaphores = &semaphore;
+    waitInfo.pValues = &ticket.timelineValue;
+    return vkWaitSemaphores(this->m_device, &waitInfo, timeoutNs);
+}
+
+std::vector<uint32_t> Hush::VulkanUploadManager::GetConcurrentQueueFamilies() const
+{
+    if (!this->m_needsOwnershipTransfer)
+    {
+        return {};
+    }
+    return {this->m_transferQueueFamily, this->m_graphicsQueueFamily};
+}
+
+VkDeviceSize Hush::VulkanUploadManager::GetStagingBytesInFlight() const noexcept
+{
+    std::lock_guard lock(this->m_mutex);
+    return this->m_stagingHead - this->m_stagingTail;
+}
+
+Hush::VulkanUploadManager::UploadBatch &Hush::VulkanUploadManager::GetOpenBatch()
+{
+    UploadBatch &batch = this->m_batches.at(this->m_openBatchIndex);
+    if (this->m_isBatchOpen)
+    {
+        return batch;
+    }
+    // Only blocks when the transfer queue is BATCH_COUNT submissions behind
+    HUSH_VK_ASSERT(this->m_timeline.Wait(this->m_device, batch.timelineValue, BATCH_REUSE_TIMEOUT_NS),
+                   "Waiting for an upload batch failed!");
+    HUSH_VK_ASSERT(vkResetCommandPool(this->m_device, batch.commandPool, 0u), "Resetting upload command pool failed!");
+
+    VkCommandBufferBeginInfo beginInfo =
+        VkUtilsFactory::CreateCommandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    HUSH_VK_ASSERT(vkBeginCommandBuffer(batch.commandBuffer, &beginInfo), "Beginning upload command buffer failed!");
+    this->m_isBatchOpen = true;
+    return batch;
+}
+
+bool Hush::VulkanUploadManager::ReserveStaging(VkDeviceSize size, VkDeviceSize *offset)
+{
+    if (size > this->m_stagingCapacity)
+    {
+        return false;
+    }
+    auto tryReserve = [this, size, offset]() {
+        uint64_t start = AlignUp(this->m_stagingHead, STAGING_ALIGNMENT);
+        // Copies never wrap around the end of the ring, skip to its start instead
+        if (start % this->m_stagingCapacity + size > this->m_stagingCapacity)
+        {
+            start = AlignUp(start, this->m_stagingCapacity);
+        }
+        if (start + size - this->m_stagingTail > this->m_stagingCapacity)
+        {
+            return false;
+        }
+        this->m_stagingHead = start + size;
+        *offset = start % this->m_stagingCapacity;
+        return true;
+    };
+    if (tryReserve())
+    {
+        return true;
+    }
+    this->RetireCompletedBatches();
+    return tryReserve();
+}
+
+VkBuffer Hush::VulkanUploadManager::WriteStaging(const void *data, VkDeviceSize size, VkDeviceSize *offset)
+{
+    if (this->ReserveStaging(size, offset))
+    {
+        std::memcpy(this->m_stagingData + *offset, data, static_cast<size_t>(size));
+        HUSH_VK_ASSERT(vmaFlushAllocation(this->m_allocator, this->m_stagingAllocation, *offset, size),
+                       "Staging ring flush failed!");
+        return this->m_stagingBuffer;
+    }
+
+    // Rather than stalling for the ring to drain, give the upload its own buffer
+    LogFormat(ELogLevel::Debug, "Upload of {} bytes doesn't fit in the staging ring, using a dedicated buffer", size);
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo allocationInfo{};
+    allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocationInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VkBuffer buffer = nullptr;
+    VmaAllocation allocation = nullptr;
+    VmaAllocationInfo stagingInfo{};
+    HUSH_VK_ASSERT(vmaCreateBuffer(this->m_allocator, &bufferInfo, &allocationInfo, &buffer, &allocation, &stagingInfo),
+                   "Staging buffer allocation failed!");
+    std::memcpy(stagingInfo.pMappedData, data, static_cast<size_t>(size));
+    HUSH_VK_ASSERT(vmaFlushAllocation(this->m_allocator, allocation, 0u, size), "Staging buffer flush failed!");
+
+    this->m_deletionQueue.Push(buffer, allocation, this->m_timeline.GetLastSubmittedValue() + 1u);
+    *offset = 0u;
+    return buffer;
+}
+
+template <class Barrier> void Hush::VulkanUploadManager::SetReleaseFamilies(Barrier &barrier) const noexcept
+{
+    bool transfer = this->m_needsOwnershipTransfer;
+    barrier.srcQueueFamilyIndex = transfer ? this->m_transferQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = transfer ? this->m_graphicsQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+}
+
+void Hush::VulkanUploadManager::RetireCompletedBatches()
+{
+    uint64_t completedValue = this->m_timeline.GetCompletedValue(this->m_device);
+    for (const UploadBatch &batch : this->m_batches)
+    {
+        if (batch.timelineValue != 0u && batch.timelineValue <= completedValue)
+        {
+            this->m_stagingTail = std::max(this->m_stagingTail, batch.stagingEnd);
+        }
+    }
+    this->m_deletionQueue.Retire(this->m_device, this->m_allocator, completedValue);
+}
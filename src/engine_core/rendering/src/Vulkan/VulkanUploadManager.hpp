@@ -0,0 +1,145 @@
+/*! \file VulkanUploadManager.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Asynchronous buffer and image uploads through the transfer queue
+*/
+
+#pragma once
+#define VK_NO_PROTOTYPES
+#include "VulkanDeletionQueue.hpp"
+#include "VulkanTimeline.hpp"
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Hush
+{
+    /// @brief Returned by every upload, completes once the transfer queue is done copying it. Whatever the renderer
+    /// records after that can use the destination
+    struct UploadTicket
+    {
+        /// @brief Value of the upload timeline signaled by the batch holding the upload, 0 means nothing to wait for
+        uint64_t timelineValue = 0u;
+    };
+
+    /// @brief Copies data to GPU only buffers and images without blocking the caller. Data is written to a persistently
+    /// mapped staging ring and the copies are recorded into a batch, the renderer submits that batch to the transfer
+    /// queue once per frame (SubmitPending) and makes the frame wait on it through the upload timeline.
+    /// When the transfer queue belongs to another family the destinations are released to the graphics family after
+    /// the copy and acquired by the frame, so they must be created with VK_SHARING_MODE_EXCLUSIVE and must not be in
+    /// use by the GPU while the upload is in flight. Buffers the frames keep reading while other ranges of them are
+    /// written are created concurrent across GetConcurrentQueueFamilies instead, and uploaded as concurrent.
+    /// Uploads can be queued from any thread, SubmitPending and Dispose belong to the thread that calls Draw
+    class VulkanUploadManager
+    {
+      public:
+        static constexpr VkDeviceSize DEFAULT_STAGING_CAPACITY = 64ull * 1024ull * 1024ull;
+
+        /// @brief Batches submitted to the GPU at once, queuing uploads only waits for the GPU when all of them are
+        /// still in flight
+        static constexpr uint32_t BATCH_COUNT = 4u;
+
+        /// @brief Offsets into the staging ring are kept at this alignment, enough for buffer to image copies of
+        /// formats up to 16 bytes per texel
+        static constexpr VkDeviceSize STAGING_ALIGNMENT = 16u;
+
+        /// @param transferQueue may be the graphics queue itself when the device has no separate transfer family
+        void Init(VkDevice device, VmaAllocator allocator, VkQueue transferQueue, uint32_t transferQueueFamily,
+                  uint32_t graphicsQueueFamily, VkDeviceSize stagingCapacity = DEFAULT_STAGING_CAPACITY);
+
+        /// @brief Waits for every upload in flight and destroys the staging memory
+        void Dispose() noexcept;
+
+        /// @brief Queues a copy of size bytes into destination, data is copied before returning
+        /// @param destination needs VK_BUFFER_USAGE_TRANSFER_DST_BIT
+        /// @param concurrentDestination destination was created concurrent across GetConcurrentQueueFamilies, it
+        /// skips the ownership transfer and the GPU may read the rest of it meanwhile
+        UploadTicket UploadBuffer(VkBuffer destination, VkDeviceSize destinationOffset, const void *data,
+                                  VkDeviceSize size, bool concurrentDestination = false);
+
+        /// @brief Queues a copy into mip 0, layer 0 of a color image, data holds tightly packed texels
+        /// @param destination needs VK_IMAGE_USAGE_TRANSFER_DST_BIT, its current contents are discarded
+        /// @param finalLayout layout the image is left in for the frames that use it
+        UploadTicket UploadImage(VkImage destination, VkExtent3D extent, VkImageLayout finalLayout, const void *data,
+                                 VkDeviceSize size);
+
+        /// @brief Submits the uploads queued since the last call to the transfer queue and records the ownership
+        /// acquire of their destinations into the frame command buffer. Call right after beginning it
+        /// @return Upload timeline value the frame submission must wait on (see CreateWaitInfo), 0 if none
+        uint64_t SubmitPending(VkCommandBuffer graphicsCmd);
+
+        [[nodiscard]] VkSemaphoreSubmitInfo CreateWaitInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const;
+
+        [[nodiscard]] bool IsComplete(const UploadTicket &ticket) noexcept;
+
+        /// @brief Blocks until the upload is done, the batch holding it must have been submitted by SubmitPending
+        /// @return VK_TIMEOUT if it took longer than timeoutNs
+        VkResult Wait(const UploadTicket &ticket, uint64_t timeoutNs) noexcept;
+
+        /// @brief The transfer and graphics families, or nothing when they are the same and exclusive buffers can be
+        /// written and read without transfers
+        [[nodiscard]] std::vector<uint32_t> GetConcurrentQueueFamilies() const;
+
+        /// @brief Staging bytes still in use by the GPU or by the open batch
+        [[nodiscard]] VkDeviceSize GetStagingBytesInFlight() const noexcept;
+
+      private:
+        struct UploadBatch
+        {
+            VkCommandPool commandPool = nullptr;
+            VkCommandBuffer commandBuffer = nullptr;
+            /// @brief Signaled once every copy of the batch is done, 0 if it was never submitted
+            uint64_t timelineValue = 0u;
+            /// @brief Ring head once the batch was closed, the ring tail moves up to it when the batch completes
+            uint64_t stagingEnd = 0u;
+        };
+
+        /// @brief Opens the next batch if none is being recorded, waiting for its last use to finish
+        UploadBatch &GetOpenBatch();
+
+        /// @brief Takes size bytes out of the staging ring
+        /// @return false when the ring doesn't have room, even after retiring the completed batches
+        bool ReserveStaging(VkDeviceSize size, VkDeviceSize *offset);
+
+        /// @brief Copies data into the ring or, when it doesn't fit, into a staging buffer of its own that is
+        /// destroyed along with the batch
+        VkBuffer WriteStaging(const void *data, VkDeviceSize size, VkDeviceSize *offset);
+
+        void RetireCompletedBatches();
+
+        /// @brief Hands the barrier's resource from the transfer family to the graphics one, if they differ
+        template <class Barrier> void SetReleaseFamilies(Barrier &barrier) const noexcept;
+
+        VkDevice m_device = nullptr;
+        VmaAllocator m_allocator = nullptr;
+        VkQueue m_transferQueue = nullptr;
+        uint32_t m_transferQueueFamily = 0u;
+        uint32_t m_graphicsQueueFamily = 0u;
+        bool m_needsOwnershipTransfer = false;
+
+        VkBuffer m_stagingBuffer = nullptr;
+        VmaAllocation m_stagingAllocation = nullptr;
+        uint8_t *m_stagingData = nullptr;
+        VkDeviceSize m_stagingCapacity = 0u;
+        /// @brief Monotonic byte positions, the physical offset is position % m_stagingCapacity
+        uint64_t m_stagingHead = 0u;
+        uint64_t m_stagingTail = 0u;
+
+        std::array<UploadBatch, BATCH_COUNT> m_batches{};
+        uint32_t m_openBatchIndex = 0u;
+        bool m_isBatchOpen = false;
+
+        /// @brief Barriers that hand the destinations of the open batch to the graphics queue, also used to build the
+        /// acquire half of the transfer
+        std::vector<VkBufferMemoryBarrier2> m_bufferBarriers;
+        std::vector<VkImageMemoryBarrier2> m_imageBarriers;
+
+        VulkanTimeline m_timeline{};
+        /// @brief Oversized staging buffers, retired by upload timeline value
+        VulkanDeletionQueue m_deletionQueue{};
+        mutable std::mutex m_mutex;
+    };
+} // namespace Hush
@@ -1,27 +1,202 @@
+#define VK_NO_PROTOTYPES
 #include "VulkanVertexBuffer.hpp"
 #include "VkTypes.hpp"
+#include "VulkanDeletionQueue.hpp"
 
-Hush::VulkanVertexBuffer::VulkanVertexBuffer(uint32_t size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, VmaAllocator allocator)
+#include <cstring>
+#include <utility>
+#include <volk.h>
+
+Hush::VulkanVertexBuffer::VulkanVertexBuffer(VkDeviceSize capacity, VkBufferUsageFlags usage,
+                                             VmaMemoryUsage memoryUsage, VmaAllocator allocator,
+                                             VmaAllocationCreateFlags allocationFlags,
+                                             std::vector<uint32_t> concurrentQueueFamilies)
+    : m_allocator(allocator), m_usage(usage), m_memoryUsage(memoryUsage), m_allocationFlags(allocationFlags),
+      m_concurrentQueueFamilies(std::move(concurrentQueueFamilies))
+{
+    this->Allocate(capacity);
+}
+
+Hush::VulkanVertexBuffer::VulkanVertexBuffer(VulkanVertexBuffer &&rhs) noexcept
+    : m_buffer(std::exchange(rhs.m_buffer, nullptr)), m_allocator(rhs.m_allocator),
+      m_allocation(std::exchange(rhs.m_allocation, nullptr)), m_allocInfo(rhs.m_allocInfo),
+      m_deviceAddress(std::exchange(rhs.m_deviceAddress, 0u)), m_usage(rhs.m_usage), m_memoryUsage(rhs.m_memoryUsage),
+      m_allocationFlags(rhs.m_allocationFlags), m_concurrentQueueFamilies(std::move(rhs.m_concurrentQueueFamilies)),
+      m_size(std::exchange(rhs.m_size, 0u)),
+      m_capacity(std::exchange(rhs.m_capacity, 0u))
+{
+}
+
+Hush::VulkanVertexBuffer &Hush::VulkanVertexBuffer::operator=(VulkanVertexBuffer &&rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this->Destroy();
+        this->m_buffer = std::exchange(rhs.m_buffer, nullptr);
+        this->m_allocator = rhs.m_allocator;
+        this->m_allocation = std::exchange(rhs.m_allocation, nullptr);
+        this->m_allocInfo = rhs.m_allocInfo;
+        this->m_deviceAddress = std::exchange(rhs.m_deviceAddress, 0u);
+        this->m_usage = rhs.m_usage;
+        this->m_memoryUsage = rhs.m_memoryUsage;
+        this->m_allocationFlags = rhs.m_allocationFlags;
+        this->m_concurrentQueueFamilies = std::move(rhs.m_concurrentQueueFamilies);
+        this->m_size = std::exchange(rhs.m_size, 0u);
+        this->m_capacity = std::exchange(rhs.m_capacity, 0u);
+    }
+    return *this;
+}
+
+void Hush::VulkanVertexBuffer::Destroy() noexcept
+{
+    if (this->m_buffer != nullptr)
+    {
+        vmaDestroyBuffer(this->m_allocator, this->m_buffer, this->m_allocation);
+    }
+    this->m_buffer = nullptr;
+    this->m_allocation = nullptr;
+    this->m_allocInfo = {};
+    this->m_deviceAddress = 0u;
+    this->m_size = 0u;
+    this->m_capacity = 0u;
+}
+
+void Hush::VulkanVertexBuffer::Retire(VulkanDeletionQueue &deletionQueue, uint64_t retireValue)
+{
+    if (this->m_buffer != nullptr)
+    {
+        deletionQueue.Push(this->m_buffer, this->m_allocation, retireValue);
+    }
+    this->m_buffer = nullptr;
+    this->m_allocation = nullptr;
+    this->m_allocInfo = {};
+    this->m_deviceAddress = 0u;
+    this->m_size = 0u;
+    this->m_capacity = 0u;
+}
+
+void Hush::VulkanVertexBuffer::Write(const void *data, VkDeviceSize size, VkDeviceSize offset)
+{
+    HUSH_ASSERT(this->m_allocInfo.pMappedData != nullptr, "Writing to a buffer that isn't mapped!");
+    HUSH_ASSERT(offset + size <= this->m_capacity, "Writing {} bytes at {} overflows a buffer of {} bytes", size,
+                offset, this->m_capacity);
+    std::memcpy(static_cast<uint8_t *>(this->m_allocInfo.pMappedData) + offset, data, static_cast<size_t>(size));
+    HUSH_VK_ASSERT(vmaFlushAllocation(this->m_allocator, this->m_allocation, offset, size),
+                   "Vertex buffer flush failed!");
+    this->m_size = offset + size > this->m_size ? offset + size : this->m_size;
+}
+
+void Hush::VulkanVertexBuffer::Grow(VkCommandBuffer cmd, VkDeviceSize minCapacity, VulkanDeletionQueue &deletionQueue,
+                                    uint64_t retireValue)
+{
+    if (minCapacity <= this->m_capacity)
+    {
+        return;
+    }
+    VkDeviceSize newCapacity = this->m_capacity > 0u ? this->m_capacity : minCapacity;
+    while (newCapacity < minCapacity)
+    {
+        newCapacity *= 2u;
+    }
+
+    VkBuffer oldBuffer = this->m_buffer;
+    VmaAllocation oldAllocation = this->m_allocation;
+    VkDeviceSize size = this->m_size;
+    this->Allocate(newCapacity);
+    this->m_size = size;
+
+    if (size > 0u)
+    {
+        VkBufferCopy region{};
+        region.size = size;
+        vkCmdCopyBuffer(cmd, oldBuffer, this->m_buffer, 1u, &region);
+
+        // Whatever reads the buffer next in cmd sees the copied contents
+        VkMemoryBarrier2 copyBarrier{};
+        copyBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        copyBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        copyBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        copyBarrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        copyBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.memoryBarrierCount = 1u;
+        dependencyInfo.pMemoryBarriers = &copyBarrier;
+        vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+    }
+    if (oldBuffer != nullptr)
+    {
+        deletionQueue.Push(oldBuffer, oldAllocation, retireValue);
+    }
+}
+
+VkBuffer Hush::VulkanVertexBuffer::GetBuffer() const noexcept
+{
+    return this->m_buffer;
+}
+
+VmaAllocation Hush::VulkanVertexBuffer::GetAllocation() const noexcept
+{
+    return this->m_allocation;
+}
+
+VkDeviceAddress Hush::VulkanVertexBuffer::GetDeviceAddress() const noexcept
+{
+    return this->m_deviceAddress;
+}
+
+void *Hush::VulkanVertexBuffer::GetMappedData() const noexcept
+{
+    return this->m_allocInfo.pMappedData;
+}
+
+VkDeviceSize Hush::VulkanVertexBuffer::GetSize() const noexcept
+{
+    return this->m_size;
+}
+
+VkDeviceSize Hush::VulkanVertexBuffer::GetCapacity() const noexcept
+{
+    return this->m_capacity;
+}
+
+void Hush::VulkanVertexBuffer::Allocate(VkDeviceSize capacity)
 {
     // allocate buffer
     VkBufferCreateInfo bufferInfo = {};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferInfo.pNext = nullptr;
-    bufferInfo.size = size;
+    bufferInfo.size = capacity;
 
-    bufferInfo.usage = usage;
+    // Growing copies the old contents over on the GPU
+    bufferInfo.usage = this->m_usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    if (this->m_concurrentQueueFamilies.size() > 1u)
+    {
+        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = static_cast<uint32_t>(this->m_concurrentQueueFamilies.size());
+        bufferInfo.pQueueFamilyIndices = this->m_concurrentQueueFamilies.data();
+    }
 
     VmaAllocationCreateInfo vmaallocInfo = {};
-    vmaallocInfo.usage = memoryUsage;
-    vmaallocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    vmaallocInfo.usage = this->m_memoryUsage;
+    vmaallocInfo.flags = this->m_allocationFlags;
 
     // allocate the buffer
-    HUSH_VK_ASSERT(vmaCreateBuffer(allocator, &bufferInfo, &vmaallocInfo, &this->m_buffer, &this->m_allocation,
-                                   &this->m_allocInfo),
+    HUSH_VK_ASSERT(vmaCreateBuffer(this->m_allocator, &bufferInfo, &vmaallocInfo, &this->m_buffer,
+                                   &this->m_allocation, &this->m_allocInfo),
                    "Vertex buffer allocation failed!");
-}
+    this->m_capacity = capacity;
+    this->m_size = 0u;
 
-uint32_t Hush::VulkanVertexBuffer::GetSize() const noexcept
-{
-    return this->m_size;
+    this->m_deviceAddress = 0u;
+    if ((this->m_usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0u)
+    {
+        VmaAllocatorInfo allocatorInfo{};
+        vmaGetAllocatorInfo(this->m_allocator, &allocatorInfo);
+        VkBufferDeviceAddressInfo addressInfo{};
+        addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        addressInfo.buffer = this->m_buffer;
+        this->m_deviceAddress = vkGetBufferDeviceAddress(allocatorInfo.device, &addressInfo);
+    }
 }
@@ -9,24 +9,87 @@
 #include "VkTypes.hpp"
 #include "vk_mem_alloc.hpp"
 
+#include <vector>
+
 namespace Hush
 {
+    class VulkanDeletionQueue;
+
+    /// @brief One VkBuffer with its own VMA allocation, grows by doubling. Buffers created with
+    /// VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT cache their device address
     class VulkanVertexBuffer final
     {
     public:
-        VulkanVertexBuffer(uint32_t size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, VmaAllocator allocator);
+        static constexpr VmaAllocationCreateFlags MAPPED_ALLOCATION_FLAGS =
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        VulkanVertexBuffer() = default;
+
+        /// @param allocationFlags MAPPED_ALLOCATION_FLAGS keeps the buffer persistently mapped, 0 leaves it GPU only
+        /// (fill it through the upload manager then)
+        /// @param concurrentQueueFamilies creates the buffer VK_SHARING_MODE_CONCURRENT across them, exclusive when
+        /// there are less than two (see VulkanUploadManager::GetConcurrentQueueFamilies)
+        VulkanVertexBuffer(VkDeviceSize capacity, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage,
+                           VmaAllocator allocator, VmaAllocationCreateFlags allocationFlags = MAPPED_ALLOCATION_FLAGS,
+                           std::vector<uint32_t> concurrentQueueFamilies = {});
+
+        VulkanVertexBuffer(const VulkanVertexBuffer &) = delete;
+        VulkanVertexBuffer &operator=(const VulkanVertexBuffer &) = delete;
+
+        VulkanVertexBuffer(VulkanVertexBuffer &&rhs) noexcept;
+        VulkanVertexBuffer &operator=(VulkanVertexBuffer &&rhs) noexcept;
+
+        /// @brief Buffers aren't destroyed implicitly, the GPU may still be using them
+        ~VulkanVertexBuffer() = default;
+
+        /// @brief Destroys the buffer right away, the GPU must be done with it
+        void Destroy() noexcept;
+
+        /// @brief Hands the buffer to deletionQueue, tagged with retireValue, and leaves this one empty
+        void Retire(VulkanDeletionQueue &deletionQueue, uint64_t retireValue);
 
-        [[nodiscard]] uint32_t GetSize() const noexcept;
+        /// @brief Copies data into the mapping and grows the size to cover it, only for mapped buffers
+        void Write(const void *data, VkDeviceSize size, VkDeviceSize offset = 0u);
+
+        /// @brief Reallocates the buffer with at least minCapacity bytes, doubling the current capacity, and records a
+        /// copy of its contents into cmd. The old buffer goes to deletionQueue, tagged with retireValue, so the frames
+        /// in flight can keep reading it
+        void Grow(VkCommandBuffer cmd, VkDeviceSize minCapacity, VulkanDeletionQueue &deletionQueue,
+                  uint64_t retireValue);
+
+        [[nodiscard]] VkBuffer GetBuffer() const noexcept;
+
+        [[nodiscard]] VmaAllocation GetAllocation() const noexcept;
+
+        /// @brief 0 unless the buffer was created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+        [[nodiscard]] VkDeviceAddress GetDeviceAddress() const noexcept;
+
+        /// @brief nullptr for buffers that aren't mapped
+        [[nodiscard]] void *GetMappedData() const noexcept;
+
+        [[nodiscard]] VkDeviceSize GetSize() const noexcept;
+
+        [[nodiscard]] VkDeviceSize GetCapacity() const noexcept;
 
     private:
+        void Allocate(VkDeviceSize capacity);
+
         VkBuffer m_buffer = nullptr;
 
+        VmaAllocator m_allocator = nullptr;
         VmaAllocation m_allocation = nullptr;
         VmaAllocationInfo m_allocInfo{};
+        VkDeviceAddress m_deviceAddress = 0u;
+
+        VkBufferUsageFlags m_usage = 0u;
+        VmaMemoryUsage m_memoryUsage = VMA_MEMORY_USAGE_UNKNOWN;
+        VmaAllocationCreateFlags m_allocationFlags = 0u;
+        /// @brief Kept so Grow creates the new buffer with the same sharing mode
+        std::vector<uint32_t> m_concurrentQueueFamilies;
 
         /// @brief The size of the current data in the buffer, must be <= m_capacity
-        uint32_t m_size = 0;
-        /// @brief The initial size of the buffer's data, and therefore, the max size it accepts
-        uint32_t m_capacity = 0;
+        VkDeviceSize m_size = 0;
+        /// @brief Bytes allocated for the buffer, Grow raises it
+        VkDeviceSize m_capacity = 0;
     };
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@
 #include "Logger.hpp"
 #include "Vulkan/VulkanRenderer.hpp"
 #include "Assertions.hpp"
+#include <algorithm>
 
 Hush::WindowRenderer::WindowRenderer(const char *windowName) noexcept
 {
@@ -49,40 +50,78 @@ Hush::WindowRenderer::WindowRenderer(const char *windowName) noexcept
 
 void Hush::WindowRenderer::HandleEvents(bool *applicationRunning)
 {
-    SDL_Event event;
-    KeyCode code = 0;
     InputManager::ResetMouseAcceleration();
-    SDL_PollEvent(&event);
-    // Forward event to the renderer
-    switch (event.type)
+    // Gather everything the OS has for us, then drain the whole queue so no input waits for the next frame
+    SDL_PumpEvents();
+    uint32_t queueDepth = GetQueuedEventCount();
+
+    uint32_t eventCount = 0;
+    uint32_t batchCount = 0;
+    int fetchedEvents = 0;
+    do
     {
-    case SDL_QUIT:
-        *applicationRunning = false;
-        break;
-    case SDL_KEYDOWN:
-        code = event.key.keysym.scancode;
-        InputManager::SendKeyEvent(code, EKeyState::Pressed);
-        break;
-    case SDL_KEYUP:
-        code = event.key.keysym.scancode;
-        InputManager::SendKeyEvent(code, EKeyState::Released);
-        break;
-    case SDL_MOUSEBUTTONDOWN:
-        InputManager::SendMouseButtonEvent(event.button.button, EKeyState::Pressed);
-        break;
-    case SDL_MOUSEBUTTONUP:
-        InputManager::SendMouseButtonEvent(event.button.button, EKeyState::Released);
-        break;
-    case SDL_MOUSEMOTION:
-        InputManager::SendMouseMovementEvent(event.motion.x, event.motion.y, event.motion.xrel, event.motion.yrel);
-        break;
-    case SDL_WINDOWEVENT:
-        CheckWindowState(event.window, &this->m_isActive);
-        break;
-    default:
-        break;
+        fetchedEvents = SDL_PeepEvents(this->m_eventBuffer.data(), EVENT_BUFFER_CAPACITY, SDL_GETEVENT,
+                                       SDL_FIRSTEVENT, SDL_LASTEVENT);
+        if (fetchedEvents < 0)
+        {
+            Hush::LogFormat(Hush::ELogLevel::Error, "Fetching SDL events failed with error {}!", SDL_GetError());
+            break;
+        }
+        this->DispatchEvents(this->m_eventBuffer.data(), fetchedEvents, applicationRunning);
+        eventCount += static_cast<uint32_t>(fetchedEvents);
+        batchCount++;
+        // A full buffer means there might be more waiting
+    } while (fetchedEvents == EVENT_BUFFER_CAPACITY);
+
+    this->m_eventStats.eventsThisFrame = eventCount;
+    this->m_eventStats.maxEventsPerFrame = std::max(this->m_eventStats.maxEventsPerFrame, eventCount);
+    this->m_eventStats.queueDepthThisFrame = queueDepth;
+    this->m_eventStats.maxQueueDepth = std::max(this->m_eventStats.maxQueueDepth, queueDepth);
+    this->m_eventStats.batchesThisFrame = batchCount;
+    if (GetQueuedEventCount() != 0)
+    {
+        this->m_eventStats.framesWithCarriedOverEvents++;
+    }
+}
+
+void Hush::WindowRenderer::DispatchEvents(const SDL_Event *events, int count, bool *applicationRunning)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const SDL_Event &event = events[i];
+        KeyCode code = 0;
+        switch (event.type)
+        {
+        case SDL_QUIT:
+            *applicationRunning = false;
+            break;
+        case SDL_KEYDOWN:
+            code = event.key.keysym.scancode;
+            InputManager::SendKeyEvent(code, EKeyState::Pressed);
+            break;
+        case SDL_KEYUP:
+            code = event.key.keysym.scancode;
+            InputManager::SendKeyEvent(code, EKeyState::Released);
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+            InputManager::SendMouseButtonEvent(event.button.button, EKeyState::Pressed);
+            break;
+        case SDL_MOUSEBUTTONUP:
+            InputManager::SendMouseButtonEvent(event.button.button, EKeyState::Released);
+            break;
+        case SDL_MOUSEMOTION:
+            InputManager::SendMouseMovementEvent(event.motion.x, event.motion.y, event.motion.xrel,
+                                                 event.motion.yrel);
+            break;
+        case SDL_WINDOWEVENT:
+            CheckWindowState(event.window, &this->m_isActive);
+            break;
+        default:
+            break;
+        }
+        // Forward event to the renderer
+        this->m_windowRenderer->HandleEvent(&event);
     }
-    this->m_windowRenderer->HandleEvent(&event);
 }
 
 Hush::WindowRenderer::~WindowRenderer()
@@ -102,6 +141,11 @@ bool Hush::WindowRenderer::IsActive() const noexcept
     return this->m_isActive;
 }
 
+const Hush::EventPumpStats &Hush::WindowRenderer::GetEventPumpStats() const noexcept
+{
+    return this->m_eventStats;
+}
+
 bool Hush::WindowRenderer::InitSDLIfNotStarted() noexcept
 {
     if (SDL_WasInit(SDL_INIT_EVERYTHING) != 0)
@@ -113,6 +157,13 @@ bool Hush::WindowRenderer::InitSDLIfNotStarted() noexcept
     return rc == 0;
 }
 
+uint32_t Hush::WindowRenderer::GetQueuedEventCount() noexcept
+{
+    // Peeking with a null buffer only counts the events without removing them
+    int queuedEvents = SDL_PeepEvents(nullptr, 0, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+    return queuedEvents > 0 ? static_cast<uint32_t>(queuedEvents) : 0u;
+}
+
 void Hush::WindowRenderer::CheckWindowState(const SDL_WindowEvent windowEvent, bool *isActive) noexcept
 {
     switch (windowEvent.event)
@@ -11,14 +11,34 @@
 
 #include <SDL2/SDL.h>
 #include <InputManager.hpp>
+#include <array>
 #include <memory>
 
 #include "Renderer.hpp"
 
 constexpr int DEFAULT_WINDOW_HEIGHT = 900;
 constexpr int DEFAULT_WINDOW_WIDTH = 1600;
+///@brief Max amount of events fetched from SDL in one go, the queue is drained in batches of this size every frame
+constexpr int EVENT_BUFFER_CAPACITY = 256;
 namespace Hush
 {
+    /// @brief Counters of the event pump, used to verify that all the queued input is consumed on the frame it arrives
+    struct EventPumpStats
+    {
+        /// @brief Events dispatched on the last call to HandleEvents
+        uint32_t eventsThisFrame = 0;
+        /// @brief Highest amount of events dispatched on a single frame
+        uint32_t maxEventsPerFrame = 0;
+        /// @brief Events waiting on the SDL queue at the start of the last frame
+        uint32_t queueDepthThisFrame = 0;
+        /// @brief Highest SDL queue depth observed at the start of a frame
+        uint32_t maxQueueDepth = 0;
+        /// @brief Batches of EVENT_BUFFER_CAPACITY events needed to drain the queue on the last frame
+        uint32_t batchesThisFrame = 0;
+        /// @brief Frames that ended with events still on the queue, should always be 0
+        uint64_t framesWithCarriedOverEvents = 0;
+    };
+
     class WindowRenderer
     {
       public:
@@ -40,6 +60,8 @@ namespace Hush
 
         [[nodiscard]] bool IsActive() const noexcept;
 
+        [[nodiscard]] const EventPumpStats &GetEventPumpStats() const noexcept;
+
       private:
         /// @brief Pointer that represents the unique instance of an SDL window associated with this context
         /// (This is declared as a raw pointer for compatibility with C)
@@ -51,8 +73,18 @@ namespace Hush
 
         bool m_isActive = false;
 
+        /// @brief Preallocated storage the SDL queue gets drained into, avoids any allocation on the event path
+        std::array<SDL_Event, EVENT_BUFFER_CAPACITY> m_eventBuffer{};
+
+        EventPumpStats m_eventStats{};
+
         bool InitSDLIfNotStarted() noexcept;
 
+        /// @brief Forwards a batch of events to the input manager and the renderer in a single pass
+        void DispatchEvents(const SDL_Event *events, int count, bool *applicationRunning);
+
+        static uint32_t GetQueuedEventCount() noexcept;
+
         void CheckWindowState(const SDL_WindowEvent windowEvent, bool *isActive) noexcept;
 
         constexpr uint32_t GetInitialRendererFlags()
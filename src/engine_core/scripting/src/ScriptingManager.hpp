@@ -8,6 +8,7 @@
 #include "DotnetHost.hpp"
 #include "Logger.hpp"
 #include "LibManager.hpp"
+#include "Profiler.hpp"
 #include "StringUtils.hpp"
 
 #include <coreclr/coreclr_delegates.h>
@@ -45,6 +46,7 @@ namespace Hush
         R InvokeCSharpWithReturn(const char *targetNamespace, const char *targetClass, const char *fnName,
                                  Types... args)
         {
+            HUSH_PROFILE_SCOPE("ScriptingManager::InvokeCSharpWithReturn");
             // TODO: Consider caching the functions in memory to a map so that we don't have to constantly load them
             // every time
             std::string fullClassPath =
@@ -60,12 +62,14 @@ namespace Hush
                                 "Failed to invoke C# method with name {}. Please verify the signature", fnName);
                 return R();
             }
+            HUSH_PROFILE_SCOPE("ScriptingManager::ManagedCall");
             return testDelegate(args...);
         }
 
         template <class... Types>
         void InvokeCSharp(const char *targetNamespace, const char *targetClass, const char *fnName, Types... args)
         {
+            HUSH_PROFILE_SCOPE("ScriptingManager::InvokeCSharp");
             // TODO: Consider caching the functions in memory to a map so that we don't have to constantly load them
             // every time
             std::string fullClassPath =
@@ -81,6 +85,7 @@ namespace Hush
                                 fnName, rc);
                 return;
             }
+            HUSH_PROFILE_SCOPE("ScriptingManager::ManagedCall");
             testDelegate(args...);
         }
 
@@ -94,6 +99,7 @@ namespace Hush
 
         template <class... Types> int GetMethodFromCS(const char *fullClassPath, const char *fnName, void **outMethod)
         {
+            HUSH_PROFILE_SCOPE("ScriptingManager::GetMethodFromCS");
 #if _WIN32
             std::wstring pathStr = StringUtils::ToWString(fullClassPath);
             const char_t *classPath = pathStr.data();
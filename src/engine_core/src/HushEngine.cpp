@@ -23,36 +23,83 @@ void Hush::HushEngine::Run()
 
     this->m_app->Init();
 
+    rendererImpl->SetThreadedRendering(this->m_threadedRendering);
+    if (this->m_threadedRendering)
+    {
+        this->m_renderThread = std::make_unique<RenderThread>(rendererImpl);
+        this->m_renderThread->Start();
+    }
+
     while (this->m_isApplicationRunning)
     {
-        std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
-        mainRenderer.HandleEvents(&this->m_isApplicationRunning);
+        HUSH_PROFILE_SCOPE(Profiler::FRAME_ZONE_NAME);
+        this->m_scheduler.BeginFrame();
+        FrameMemory::BeginFrame();
+        {
+            HUSH_PROFILE_SCOPE("HandleEvents");
+            mainRenderer.HandleEvents(&this->m_isApplicationRunning);
+        }
         // TODO: Change this to the window renderer
         if (!mainRenderer.IsActive())
         {
-            // Arbitrary sleep to avoid taking all CPU usage
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            // Throttle to the idle frame rate to avoid taking all CPU usage
+            this->m_scheduler.WaitIdle();
             continue;
         }
 
-        this->m_app->Update();
+        {
+            HUSH_PROFILE_SCOPE("FixedUpdate");
+            while (this->m_scheduler.ConsumeFixedStep())
+            {
+                this->m_app->FixedUpdate();
+            }
+        }
 
-        this->m_app->OnPreRender();
+        {
+            HUSH_PROFILE_SCOPE("Update");
+            this->m_app->Update();
+        }
 
-        rendererImpl->NewUIFrame();
+        {
+            HUSH_PROFILE_SCOPE("OnPreRender");
+            this->m_app->OnPreRender();
+        }
+
+        {
+            HUSH_PROFILE_SCOPE("BuildUI");
+            rendererImpl->NewUIFrame();
 
-        this->m_app->OnRender();
+            this->m_app->OnRender();
 
-        // UI::DrawPanels();
+            // UI::DrawPanels();
+        }
 
-        rendererImpl->Draw();
+        {
+            HUSH_PROFILE_SCOPE("PublishFrame");
+            rendererImpl->PublishFrame();
+        }
+        if (this->m_renderThread != nullptr)
+        {
+            this->m_renderThread->NotifyFramePublished();
+        }
+        else
+        {
+            rendererImpl->Draw();
+        }
 
-        this->m_app->OnPostRender();
+        {
+            HUSH_PROFILE_SCOPE("OnPostRender");
+            this->m_app->OnPostRender();
+        }
 
-        std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        (void)elapsed;
+        {
+            HUSH_PROFILE_SCOPE("WaitForNextFrame");
+            this->m_scheduler.EndFrame();
+        }
     }
+
+    // The renderer gets destroyed with the window, so the render thread can't outlive this scope
+    this->m_renderThread.reset();
 }
 
 void Hush::HushEngine::Quit()
@@ -60,6 +107,29 @@ void Hush::HushEngine::Quit()
     this->m_isApplicationRunning = false;
 }
 
+void Hush::HushEngine::SetTargetFrameRate(uint32_t targetFrameRate) noexcept
+{
+    this->m_scheduler.SetTargetFrameRate(targetFrameRate);
+}
+
+const Hush::FrameStats &Hush::HushEngine::GetLastFrameStats() const noexcept
+{
+    return this->m_scheduler.GetLastFrameStats();
+}
+
+void Hush::HushEngine::SetThreadedRendering(bool enabled) noexcept
+{
+    this->m_threadedRendering = enabled;
+}
+
 void Hush::HushEngine::Init()
 {
+    HUSH_PROFILE_THREAD("Main");
+#if HUSH_ENABLE_PROFILER
+    // Spent here rather than on the first zone converted to time
+    Profiler::Calibrate();
+#endif
+    // Created from the main thread, so it becomes thread 0 of the job system and helps while waiting on jobs
+    this->m_jobSystem = std::make_unique<JobSystem>();
+    JobSystem::SetMain(this->m_jobSystem.get());
 }
@@ -7,7 +7,12 @@
 #pragma once
 #include "DotnetHost.hpp"
 #include "IApplication.hpp"
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+#include "RenderThread.hpp"
 #include "WindowRenderer.hpp"
+#include <memory/FrameMemory.hpp>
+#include <timing/FrameScheduler.hpp>
 
 #include <string_view>
 
@@ -40,13 +45,33 @@ namespace Hush
         /// </summary>
         void Quit();
 
+        /// @brief Caps the main loop to the given frames per second, 0 leaves it uncapped (only limited by vsync)
+        void SetTargetFrameRate(uint32_t targetFrameRate) noexcept;
+
+        [[nodiscard]] const FrameStats &GetLastFrameStats() const noexcept;
+
+        /// @brief Call before Run, records and submits frames on a dedicated render thread while the main thread
+        /// simulates the next one, so a frame takes about max(simulation, rendering) instead of their sum. The main
+        /// thread stays at most one frame ahead, see IRenderer::PublishFrame
+        void SetThreadedRendering(bool enabled) noexcept;
+
       private:
         void Init();
 
         std::unique_ptr<IApplication> m_app;
 
+        /// @brief Shared by the engine subsystems and the application, see JobSystem::GetMain
+        std::unique_ptr<JobSystem> m_jobSystem;
+
+        FrameScheduler m_scheduler{DEFAULT_FIXED_TIME_STEP, 0u};
+
+        /// @brief Only alive while running with threaded rendering
+        std::unique_ptr<RenderThread> m_renderThread;
+
         bool m_isApplicationRunning = false;
+        bool m_threadedRendering = false;
         static constexpr std::string_view ENGINE_WINDOW_NAME = "Hush Engine";
+        static constexpr double DEFAULT_FIXED_TIME_STEP = 1.0 / 60.0;
     };
 
 } // namespace Hush
@@ -1,13 +1,22 @@
 #include "HushEngine.hpp"
 #include "Assertions.hpp"
+#include <cstring>
 #include <memory>
 
 #include "Logger.hpp"
 
-int main()
+int main(int argc, char *argv[])
 {
     Hush::HushEngine engine;
 
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--threaded-rendering") == 0)
+        {
+            engine.SetThreadedRendering(true);
+        }
+    }
+
     engine.Run();
 
     engine.Quit();
@@ -0,0 +1,352 @@
+/*! \file JobSystem.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Engine owned work stealing job system
+*/
+
+#include "JobSystem.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+
+/// @brief Failed attempts to find work before a worker goes to sleep
+constexpr uint32_t SPINS_BEFORE_SLEEP = 64;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+static thread_local const Hush::JobSystem *S_CURRENT_JOB_SYSTEM = nullptr;
+static thread_local uint32_t S_CURRENT_THREAD_INDEX = Hush::JobSystem::INVALID_THREAD_INDEX;
+static Hush::JobSystem *S_MAIN_JOB_SYSTEM = nullptr;
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+Hush::JobSystem::JobSystem(uint32_t workerCount)
+{
+    if (workerCount == AUTO_WORKER_COUNT)
+    {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+    uint32_t threadCount = workerCount + 1;
+
+    this->m_queues.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        auto queue = std::make_unique<ThreadQueue>();
+        queue->stealSeed = i + 1;
+        this->m_queues.push_back(std::move(queue));
+    }
+
+    // The creating thread takes part in the system as thread 0
+    S_CURRENT_JOB_SYSTEM = this;
+    S_CURRENT_THREAD_INDEX = 0;
+
+    this->m_workers.reserve(workerCount);
+    for (uint32_t i = 1; i < threadCount; i++)
+    {
+        this->m_workers.emplace_back([this, i]() { this->WorkerLoop(i); });
+    }
+    LogFormat(ELogLevel::Debug, "Job system started with {} worker threads", workerCount);
+}
+
+Hush::JobSystem::~JobSystem()
+{
+    this->m_running.store(false, std::memory_order_release);
+    {
+        std::lock_guard lock(this->m_sleepMutex);
+        this->m_wakeCondition.notify_all();
+    }
+    for (std::thread &worker : this->m_workers)
+    {
+        worker.join();
+    }
+    if (S_CURRENT_JOB_SYSTEM == this)
+    {
+        S_CURRENT_JOB_SYSTEM = nullptr;
+        S_CURRENT_THREAD_INDEX = INVALID_THREAD_INDEX;
+    }
+    if (S_MAIN_JOB_SYSTEM == this)
+    {
+        S_MAIN_JOB_SYSTEM = nullptr;
+    }
+}
+
+void Hush::JobSystem::Run(const Job &job, JobCounter *counter)
+{
+    this->Run(&job, 1u, counter);
+}
+
+void Hush::JobSystem::Run(const Job *jobs, uint32_t count, JobCounter *counter)
+{
+    if (counter != nullptr)
+    {
+        counter->m_pending.fetch_add(count, std::memory_order_acq_rel);
+    }
+
+    uint32_t threadIndex = this->GetCurrentThreadIndex();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        Job job = jobs[i];
+        job.counter = counter;
+        this->m_queuedJobs.fetch_add(1u, std::memory_order_seq_cst);
+
+        if (threadIndex == INVALID_THREAD_INDEX)
+        {
+            this->PushToGlobalQueue(job);
+            continue;
+        }
+
+        ThreadQueue &queue = *this->m_queues[threadIndex];
+        JobSlot *slot = AcquireSlot(queue);
+        if (slot == nullptr)
+        {
+            // Out of slots, don't block the caller, just do the work here
+            this->m_queuedJobs.fetch_sub(1u, std::memory_order_relaxed);
+            this->Execute(job);
+            continue;
+        }
+        slot->job = job;
+        if (!queue.deque.Push(slot))
+        {
+            slot->inUse.store(false, std::memory_order_release);
+            this->m_queuedJobs.fetch_sub(1u, std::memory_order_relaxed);
+            this->Execute(job);
+        }
+    }
+    this->WakeWorkers(count);
+}
+
+void Hush::JobSystem::WaitFor(const JobCounter &counter)
+{
+    uint32_t threadIndex = this->GetCurrentThreadIndex();
+    while (!counter.IsDone())
+    {
+        // Help instead of blocking, the jobs we are waiting for might be sitting on our own deque
+        if (!this->TryRunOneJob(threadIndex))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint32_t Hush::JobSystem::GetThreadCount() const noexcept
+{
+    return static_cast<uint32_t>(this->m_queues.size());
+}
+
+uint32_t Hush::JobSystem::GetCurrentThreadIndex() const noexcept
+{
+    return S_CURRENT_JOB_SYSTEM == this ? S_CURRENT_THREAD_INDEX : INVALID_THREAD_INDEX;
+}
+
+Hush::JobSystem *Hush::JobSystem::GetMain() noexcept
+{
+    return S_MAIN_JOB_SYSTEM;
+}
+
+void Hush::JobSystem::SetMain(JobSystem *jobSystem) noexcept
+{
+    S_MAIN_JOB_SYSTEM = jobSystem;
+}
+
+void Hush::JobSystem::WorkerLoop(uint32_t threadIndex)
+{
+    S_CURRENT_JOB_SYSTEM = this;
+    S_CURRENT_THREAD_INDEX = threadIndex;
+
+    uint32_t idleSpins = 0;
+    while (this->m_running.load(std::memory_order_acquire))
+    {
+        if (this->TryRunOneJob(threadIndex))
+        {
+            idleSpins = 0;
+            continue;
+        }
+        if (++idleSpins < SPINS_BEFORE_SLEEP)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        idleSpins = 0;
+
+        std::unique_lock lock(this->m_sleepMutex);
+        this->m_sleepingWorkers.fetch_add(1u, std::memory_order_seq_cst);
+        this->m_wakeCondition.wait(lock, [this]() {
+            return this->m_queuedJobs.load(std::memory_order_seq_cst) > 0 ||
+                   !this->m_running.load(std::memory_order_acquire);
+        });
+        this->m_sleepingWorkers.fetch_sub(1u, std::memory_order_relaxed);
+    }
+}
+
+bool Hush::JobSystem::TryRunOneJob(uint32_t threadIndex)
+{
+    JobSlot *slot = nullptr;
+    if (threadIndex != INVALID_THREAD_INDEX)
+    {
+        slot = this->m_queues[threadIndex]->deque.Pop();
+    }
+
+    if (slot == nullptr)
+    {
+        Job globalJob;
+        // If the job got parked on its dependency, go look for the work it depends on
+        if (this->PopFromGlobalQueue(globalJob) && this->Execute(globalJob))
+        {
+            return true;
+        }
+        slot = this->StealFromOthers(threadIndex);
+    }
+
+    if (slot == nullptr)
+    {
+        return false;
+    }
+
+    this->m_queuedJobs.fetch_sub(1u, std::memory_order_relaxed);
+    // Copy the job out so the slot can be reused while we run it
+    Job job = slot->job;
+    slot->inUse.store(false, std::memory_order_release);
+    this->Execute(job);
+    return true;
+}
+
+Hush::JobSystem::JobSlot *Hush::JobSystem::AcquireSlot(ThreadQueue &queue) noexcept
+{
+    for (uint32_t attempt = 0; attempt < MAX_JOBS_PER_THREAD; attempt++)
+    {
+        JobSlot &slot = queue.jobPool[queue.nextJobSlot];
+        queue.nextJobSlot = (queue.nextJobSlot + 1) & (MAX_JOBS_PER_THREAD - 1);
+        if (!slot.inUse.load(std::memory_order_acquire))
+        {
+            slot.inUse.store(true, std::memory_order_relaxed);
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+bool Hush::JobSystem::Execute(const Job &job)
+{
+    if (job.dependency != nullptr && !job.dependency->IsDone() && this->Park(job))
+    {
+        return false;
+    }
+
+    job.function(job.data);
+
+    // The counter may be gone once it reaches 0, only its address is used after that
+    JobCounter *counter = job.counter;
+    if (counter != nullptr && counter->m_pending.fetch_sub(1u, std::memory_order_seq_cst) == 1u &&
+        this->m_parkedJobCount.load(std::memory_order_seq_cst) > 0u)
+    {
+        this->ReleaseParkedJobs(counter);
+    }
+    return true;
+}
+
+bool Hush::JobSystem::Park(const Job &job)
+{
+    std::lock_guard lock(this->m_globalMutex);
+    // Checked again under the lock: whoever brings the dependency to 0 takes it after, and sees this job
+    this->m_parkedJobCount.fetch_add(1u, std::memory_order_seq_cst);
+    if (job.dependency->m_pending.load(std::memory_order_seq_cst) == 0u)
+    {
+        this->m_parkedJobCount.fetch_sub(1u, std::memory_order_relaxed);
+        return false;
+    }
+    this->m_parkedJobs.push_back(job);
+    return true;
+}
+
+void Hush::JobSystem::ReleaseParkedJobs(const JobCounter *counter)
+{
+    uint32_t released = 0u;
+    {
+        std::lock_guard lock(this->m_globalMutex);
+        auto parked = std::stable_partition(this->m_parkedJobs.begin(), this->m_parkedJobs.end(),
+                                            [counter](const Job &job) { return job.dependency != counter; });
+        for (auto it = parked; it != this->m_parkedJobs.end(); ++it)
+        {
+            this->m_globalQueue.push_back(*it);
+            released++;
+        }
+        this->m_parkedJobs.erase(parked, this->m_parkedJobs.end());
+        this->m_parkedJobCount.fetch_sub(released, std::memory_order_relaxed);
+        this->m_globalQueueSize.fetch_add(released, std::memory_order_release);
+        this->m_queuedJobs.fetch_add(released, std::memory_order_seq_cst);
+    }
+    if (released > 0u)
+    {
+        this->WakeWorkers(released);
+    }
+}
+
+Hush::JobSystem::JobSlot *Hush::JobSystem::StealFromOthers(uint32_t threadIndex)
+{
+    auto threadCount = static_cast<uint32_t>(this->m_queues.size());
+    uint32_t start = 0;
+    if (threadIndex != INVALID_THREAD_INDEX)
+    {
+        // Xorshift so every thread picks a different victim first
+        uint32_t &seed = this->m_queues[threadIndex]->stealSeed;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        start = seed % threadCount;
+    }
+
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        uint32_t victim = (start + i) % threadCount;
+        if (victim == threadIndex)
+        {
+            continue;
+        }
+        JobSlot *slot = this->m_queues[victim]->deque.Steal();
+        if (slot != nullptr)
+        {
+            return slot;
+        }
+    }
+    return nullptr;
+}
+
+void Hush::JobSystem::PushToGlobalQueue(const Job &job)
+{
+    std::lock_guard lock(this->m_globalMutex);
+    this->m_globalQueue.push_back(job);
+    this->m_globalQueueSize.fetch_add(1u, std::memory_order_release);
+}
+
+bool Hush::JobSystem::PopFromGlobalQueue(Job &outJob)
+{
+    // Avoid taking the lock on the hot path, the global queue is empty most of the time
+    if (this->m_globalQueueSize.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+    std::lock_guard lock(this->m_globalMutex);
+    if (this->m_globalQueue.empty())
+    {
+        return false;
+    }
+    outJob = this->m_globalQueue.front();
+    this->m_globalQueue.pop_front();
+    this->m_globalQueueSize.fetch_sub(1u, std::memory_order_relaxed);
+    this->m_queuedJobs.fetch_sub(1u, std::memory_order_relaxed);
+    return true;
+}
+
+void Hush::JobSystem::WakeWorkers(uint32_t jobCount)
+{
+    if (this->m_sleepingWorkers.load(std::memory_order_seq_cst) == 0)
+    {
+        return;
+    }
+    std::lock_guard lock(this->m_sleepMutex);
+    if (jobCount == 1)
+    {
+        this->m_wakeCondition.notify_one();
+        return;
+    }
+    this->m_wakeCondition.notify_all();
+}
@@ -0,0 +1,217 @@
+/*! \file JobSystem.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Engine owned work stealing job system
+*/
+
+#pragma once
+#include "WorkStealingDeque.hpp"
+#include <memory/FrameMemory.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Hush
+{
+    using JobFunction = void (*)(void *data);
+
+    /// @brief Tracks how many jobs of a group are still pending, jobs signal it when they finish
+    class JobCounter
+    {
+      public:
+        JobCounter() noexcept = default;
+
+        JobCounter(const JobCounter &) = delete;
+        JobCounter &operator=(const JobCounter &) = delete;
+        JobCounter(JobCounter &&) = delete;
+        JobCounter &operator=(JobCounter &&) = delete;
+
+        ~JobCounter() = default;
+
+        [[nodiscard]] bool IsDone() const noexcept
+        {
+            return this->m_pending.load(std::memory_order_acquire) == 0;
+        }
+
+        [[nodiscard]] uint32_t GetPending() const noexcept
+        {
+            return this->m_pending.load(std::memory_order_acquire);
+        }
+
+      private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_pending{0};
+    };
+
+    /// @brief Unit of work, both the function and the data must outlive the execution of the job
+    struct Job
+    {
+        JobFunction function = nullptr;
+        void *data = nullptr;
+        /// @brief Filled by JobSystem::Run, decremented once the job finishes
+        JobCounter *counter = nullptr;
+        /// @brief Optional, the job won't start until this counter reaches 0
+        const JobCounter *dependency = nullptr;
+    };
+
+    /// @brief Work stealing job system with one worker per core.
+    /// Every worker (and the thread that created the system) owns a lock-free deque, idle workers steal from the
+    /// others. Waiting on a counter executes pending jobs instead of blocking the thread
+    class JobSystem
+    {
+      public:
+        /// @param workerCount Threads to spawn on top of the calling one, AUTO_WORKER_COUNT spawns one per extra
+        /// hardware thread
+        explicit JobSystem(uint32_t workerCount = AUTO_WORKER_COUNT);
+
+        JobSystem(const JobSystem &) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+        JobSystem(JobSystem &&) = delete;
+        JobSystem &operator=(JobSystem &&) = delete;
+
+        ~JobSystem();
+
+        /// @brief Schedules a job
+        /// @param counter optional counter, incremented now and decremented when the job finishes
+        void Run(const Job &job, JobCounter *counter = nullptr);
+
+        /// @brief Schedules a batch of jobs that share the same counter
+        void Run(const Job *jobs, uint32_t count, JobCounter *counter);
+
+        /// @brief Executes pending jobs on the calling thread until the counter reaches 0
+        void WaitFor(const JobCounter &counter);
+
+        /// @brief Splits [0, count) in batches of batchSize and runs function(begin, end) on each of them in parallel,
+        /// returns once every batch is done
+        template <class F> void ParallelFor(uint32_t count, uint32_t batchSize, F &&function)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            batchSize = batchSize == 0 ? 1 : batchSize;
+            uint32_t batchCount = (count + batchSize - 1) / batchSize;
+            if (batchCount == 1)
+            {
+                function(0u, count);
+                return;
+            }
+
+            using Function = std::remove_reference_t<F>;
+            struct Batch
+            {
+                Function *function;
+                uint32_t begin;
+                uint32_t end;
+            };
+            static_assert(std::is_trivially_destructible_v<Job>, "Jobs on the scratch arena are never destroyed");
+            // Both arrays die with this call, the scratch arena keeps them off the heap
+            LinearAllocator &scratch = FrameMemory::GetScratchArena();
+            ArenaScope scratchScope(scratch);
+            Batch *batches = scratch.Allocate<Batch>(batchCount);
+            Job *jobs = scratch.Allocate<Job>(batchCount);
+            for (uint32_t i = 0; i < batchCount; i++)
+            {
+                uint32_t begin = i * batchSize;
+                new (&batches[i]) Batch{&function, begin, begin + batchSize < count ? begin + batchSize : count};
+                new (&jobs[i]) Job{};
+                jobs[i].function = [](void *data) {
+                    auto *batch = static_cast<Batch *>(data);
+                    (*batch->function)(batch->begin, batch->end);
+                };
+                jobs[i].data = &batches[i];
+            }
+            JobCounter counter;
+            this->Run(jobs, batchCount, &counter);
+            this->WaitFor(counter);
+        }
+
+        /// @brief Amount of threads executing jobs, including the one that created the system
+        [[nodiscard]] uint32_t GetThreadCount() const noexcept;
+
+        /// @brief Index of the calling thread inside this system, or INVALID_THREAD_INDEX if it doesn't belong to it
+        [[nodiscard]] uint32_t GetCurrentThreadIndex() const noexcept;
+
+        static JobSystem *GetMain() noexcept;
+
+        static void SetMain(JobSystem *jobSystem) noexcept;
+
+        static constexpr uint32_t INVALID_THREAD_INDEX = UINT32_MAX;
+
+        static constexpr uint32_t AUTO_WORKER_COUNT = UINT32_MAX;
+
+      private:
+        static constexpr uint32_t MAX_JOBS_PER_THREAD = 4096;
+
+        struct JobSlot
+        {
+            Job job;
+            std::atomic<bool> inUse{false};
+        };
+
+        /// @brief Per thread data, the deque plus a pool of job slots so scheduling never allocates
+        struct alignas(64) ThreadQueue
+        {
+            WorkStealingDeque<JobSlot *, MAX_JOBS_PER_THREAD> deque;
+            std::array<JobSlot, MAX_JOBS_PER_THREAD> jobPool{};
+            uint32_t nextJobSlot = 0;
+            uint32_t stealSeed = 0;
+        };
+
+        void WorkerLoop(uint32_t threadIndex);
+
+        /// @brief Finds a job (own deque, global queue, then stealing) and runs it
+        /// @return false if no job was found
+        bool TryRunOneJob(uint32_t threadIndex);
+
+        /// @brief Grabs a free slot of the thread's pool, owner thread only
+        /// @return the slot, or nullptr if every slot is taken
+        static JobSlot *AcquireSlot(ThreadQueue &queue) noexcept;
+
+        /// @brief Runs a job, or parks it if its dependency is not done yet
+        /// @return true if the job was executed
+        bool Execute(const Job &job);
+
+        /// @brief Keeps the job out of every queue until its dependency reaches 0
+        /// @return false if the dependency got there first, the job has to run now
+        bool Park(const Job &job);
+
+        /// @brief Moves the jobs parked on counter to the global queue, counter just reached 0
+        void ReleaseParkedJobs(const JobCounter *counter);
+
+        JobSlot *StealFromOthers(uint32_t threadIndex);
+
+        void PushToGlobalQueue(const Job &job);
+
+        bool PopFromGlobalQueue(Job &outJob);
+
+        void WakeWorkers(uint32_t jobCount);
+
+        std::vector<std::unique_ptr<ThreadQueue>> m_queues;
+        std::vector<std::thread> m_workers;
+
+        // Jobs coming from threads outside of the system, or whose dependencies just finished, cold path
+        std::mutex m_globalMutex;
+        std::deque<Job> m_globalQueue;
+        std::atomic<uint32_t> m_globalQueueSize{0};
+        /// @brief Jobs whose dependency wasn't done, guarded by m_globalMutex. Not counted in m_queuedJobs, so the
+        /// workers sleep instead of spinning on them
+        std::vector<Job> m_parkedJobs;
+        std::atomic<uint32_t> m_parkedJobCount{0};
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wakeCondition;
+        std::atomic<uint32_t> m_queuedJobs{0};
+        std::atomic<uint32_t> m_sleepingWorkers{0};
+        std::atomic<bool> m_running{true};
+    };
+} // namespace Hush
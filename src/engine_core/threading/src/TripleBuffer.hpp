@@ -0,0 +1,75 @@
+/*! \file TripleBuffer.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Lock-free single producer, single consumer triple buffer
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Hush
+{
+    /// @brief Hands the latest value written by one thread to another without any locks or copies.
+    /// The writer always has a buffer to write to and the reader always has the latest complete one, if the writer
+    /// publishes faster than the reader consumes, the older values are dropped
+    /// @tparam T type of the buffers, reused between publishes so containers keep their capacity
+    template <class T> class TripleBuffer
+    {
+      public:
+        /// @brief Writer only, the buffer to fill before calling Publish
+        T &GetWriteBuffer() noexcept
+        {
+            return this->m_buffers[this->m_writeIndex];
+        }
+
+        /// @brief Writer only, hands the write buffer to the reader and takes the previous shared one as the new write
+        /// buffer
+        void Publish() noexcept
+        {
+            uint8_t previous = this->m_shared.exchange(this->m_writeIndex | DIRTY_BIT, std::memory_order_acq_rel);
+            this->m_writeIndex = previous & INDEX_MASK;
+        }
+
+        /// @brief Reader only, takes the latest published buffer if there's one
+        /// @return true if GetReadBuffer changed
+        bool Consume() noexcept
+        {
+            if (!this->HasPendingData())
+            {
+                return false;
+            }
+            uint8_t previous = this->m_shared.exchange(this->m_readIndex, std::memory_order_acq_rel);
+            this->m_readIndex = previous & INDEX_MASK;
+            return true;
+        }
+
+        /// @brief Reader only, the latest consumed buffer
+        T &GetReadBuffer() noexcept
+        {
+            return this->m_buffers[this->m_readIndex];
+        }
+
+        /// @brief Any thread, whether there's a published buffer the reader hasn't consumed yet
+        [[nodiscard]] bool HasPendingData() const noexcept
+        {
+            return (this->m_shared.load(std::memory_order_acquire) & DIRTY_BIT) != 0;
+        }
+
+        /// @brief Direct access to every buffer, only safe while neither the reader nor the writer are running
+        std::array<T, 3> &GetAllBuffers() noexcept
+        {
+            return this->m_buffers;
+        }
+
+      private:
+        static constexpr uint8_t INDEX_MASK = 0b011;
+        static constexpr uint8_t DIRTY_BIT = 0b100;
+
+        std::array<T, 3> m_buffers{};
+        alignas(64) std::atomic<uint8_t> m_shared{1};
+        alignas(64) uint8_t m_writeIndex = 0;
+        alignas(64) uint8_t m_readIndex = 2;
+    };
+} // namespace Hush
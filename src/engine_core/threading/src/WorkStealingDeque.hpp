@@ -0,0 +1,106 @@
+/*! \file WorkStealingDeque.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Lock-free, fixed capacity, work stealing deque
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace Hush
+{
+    /// @brief Chase-Lev work stealing deque, implemented following "Correct and Efficient Work-Stealing for Weak
+    /// Memory Models" (Le et al. 2013).
+    /// Only the owner thread can Push and Pop (LIFO, from the bottom), any other thread can Steal (FIFO, from the top)
+    /// @tparam T pointer type stored in the deque
+    /// @tparam Capacity max amount of elements, must be a power of 2
+    template <class T, uint32_t Capacity> class WorkStealingDeque
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+        static_assert(std::is_pointer_v<T>, "Elements of the deque must be pointers");
+
+      public:
+        /// @brief Owner only, pushes an element to the bottom of the deque
+        /// @return false if the deque is full
+        bool Push(T element) noexcept
+        {
+            int64_t bottom = this->m_bottom.load(std::memory_order_relaxed);
+            int64_t top = this->m_top.load(std::memory_order_acquire);
+            if (bottom - top >= static_cast<int64_t>(Capacity))
+            {
+                return false;
+            }
+            this->m_buffer[bottom & MASK].store(element, std::memory_order_relaxed);
+            // Publishes the element (and whatever it points to) to the thieves that acquire the bottom
+            this->m_bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Owner only, pops the last pushed element
+        /// @return the element, or nullptr if the deque is empty or a thief won the race for the last element
+        T Pop() noexcept
+        {
+            int64_t bottom = this->m_bottom.load(std::memory_order_relaxed) - 1;
+            this->m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = this->m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                // Empty, restore the bottom
+                this->m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T element = this->m_buffer[bottom & MASK].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // Last element, race against the thieves for it
+                if (!this->m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                         std::memory_order_relaxed))
+                {
+                    element = nullptr;
+                }
+                this->m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return element;
+        }
+
+        /// @brief Any thread, takes the oldest element of the deque
+        /// @return the element, or nullptr if the deque is empty or another thread took it first
+        T Steal() noexcept
+        {
+            int64_t top = this->m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = this->m_bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+            T element = this->m_buffer[top & MASK].load(std::memory_order_relaxed);
+            if (!this->m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return element;
+        }
+
+        /// @brief Approximation of the element count, only exact when called from the owner with no thieves around
+        [[nodiscard]] uint32_t GetSizeApprox() const noexcept
+        {
+            int64_t size = this->m_bottom.load(std::memory_order_relaxed) - this->m_top.load(std::memory_order_relaxed);
+            return size > 0 ? static_cast<uint32_t>(size) : 0u;
+        }
+
+      private:
+        static constexpr int64_t MASK = static_cast<int64_t>(Capacity) - 1;
+        // Keep top and bottom on different cache lines, thieves hammer the top while the owner works on the bottom
+        alignas(64) std::atomic<int64_t> m_top{0};
+        alignas(64) std::atomic<int64_t> m_bottom{0};
+        alignas(64) std::array<std::atomic<T>, Capacity> m_buffer{};
+    };
+} // namespace Hush
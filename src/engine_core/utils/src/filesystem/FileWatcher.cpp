@@ -0,0 +1,153 @@
+/*! \file FileWatcher.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Implementation of FileWatcher.hpp
+*/
+
+#include "FileWatcher.hpp"
+#include "Logger.hpp"
+#include "Platform.hpp"
+
+#include <algorithm>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#if HUSH_PLATFORM_LINUX
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+Hush::FileWatcher::FileWatcher(std::filesystem::path directory, int inotifyHandle, int watchHandle) noexcept
+    : m_directory(std::move(directory)), m_inotifyHandle(inotifyHandle), m_watchHandle(watchHandle)
+{
+}
+
+Hush::FileWatcher::FileWatcher(FileWatcher &&rhs) noexcept
+    : m_directory(std::move(rhs.m_directory)), m_inotifyHandle(std::exchange(rhs.m_inotifyHandle, -1)),
+      m_watchHandle(std::exchange(rhs.m_watchHandle, -1)), m_writeTimes(std::move(rhs.m_writeTimes))
+{
+}
+
+Hush::FileWatcher &Hush::FileWatcher::operator=(FileWatcher &&rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this->Close();
+        this->m_directory = std::move(rhs.m_directory);
+        this->m_inotifyHandle = std::exchange(rhs.m_inotifyHandle, -1);
+        this->m_watchHandle = std::exchange(rhs.m_watchHandle, -1);
+        this->m_writeTimes = std::move(rhs.m_writeTimes);
+    }
+    return *this;
+}
+
+Hush::FileWatcher::~FileWatcher()
+{
+    this->Close();
+}
+
+Hush::Result<Hush::FileWatcher, Hush::FileWatcher::EError> Hush::FileWatcher::Create(
+    const std::filesystem::path &directory) noexcept
+{
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error))
+    {
+        LogFormat(ELogLevel::Debug, "Can't watch {}, it's not a directory", directory.string());
+        return EError::NotADirectory;
+    }
+#if HUSH_PLATFORM_LINUX
+    int inotifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyHandle < 0)
+    {
+        return EError::InternalError;
+    }
+    // Editors either write in place or write a temporary and move it over the file
+    int watchHandle = inotify_add_watch(inotifyHandle, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watchHandle < 0)
+    {
+        close(inotifyHandle);
+        return EError::InternalError;
+    }
+    return FileWatcher(directory, inotifyHandle, watchHandle);
+#else
+    FileWatcher watcher(directory, -1, -1);
+    watcher.ScanWriteTimes(nullptr);
+    return watcher;
+#endif
+}
+
+std::vector<std::filesystem::path> Hush::FileWatcher::WaitForChanges(std::chrono::milliseconds timeout)
+{
+    std::vector<std::filesystem::path> changedFiles;
+#if HUSH_PLATFORM_LINUX
+    pollfd pollHandle{};
+    pollHandle.fd = this->m_inotifyHandle;
+    pollHandle.events = POLLIN;
+    if (poll(&pollHandle, 1, static_cast<int>(timeout.count())) <= 0)
+    {
+        return changedFiles;
+    }
+    alignas(inotify_event) char buffer[4096];
+    ssize_t bytesRead = 0;
+    while ((bytesRead = read(this->m_inotifyHandle, buffer, sizeof(buffer))) > 0)
+    {
+        for (ssize_t offset = 0; offset < bytesRead;)
+        {
+            const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            if (event->len > 0u && (event->mask & IN_ISDIR) == 0u)
+            {
+                changedFiles.emplace_back(this->m_directory / event->name);
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+#else
+    std::this_thread::sleep_for(timeout);
+    this->ScanWriteTimes(&changedFiles);
+#endif
+    // A single save can fire several events
+    std::sort(changedFiles.begin(), changedFiles.end());
+    changedFiles.erase(std::unique(changedFiles.begin(), changedFiles.end()), changedFiles.end());
+    return changedFiles;
+}
+
+void Hush::FileWatcher::Close() noexcept
+{
+#if HUSH_PLATFORM_LINUX
+    if (this->m_inotifyHandle >= 0)
+    {
+        inotify_rm_watch(this->m_inotifyHandle, this->m_watchHandle);
+        close(this->m_inotifyHandle);
+    }
+#endif
+    this->m_inotifyHandle = -1;
+    this->m_watchHandle = -1;
+}
+
+void Hush::FileWatcher::ScanWriteTimes(std::vector<std::filesystem::path> *changedFiles)
+{
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(this->m_directory, error))
+    {
+        if (!entry.is_regular_file(error))
+        {
+            continue;
+        }
+        std::filesystem::file_time_type writeTime = entry.last_write_time(error);
+        auto [it, inserted] = this->m_writeTimes.try_emplace(entry.path().string(), writeTime);
+        if (!inserted && it->second != writeTime)
+        {
+            it->second = writeTime;
+            if (changedFiles != nullptr)
+            {
+                changedFiles->push_back(entry.path());
+            }
+        }
+        else if (inserted && changedFiles != nullptr)
+        {
+            changedFiles->push_back(entry.path());
+        }
+    }
+}
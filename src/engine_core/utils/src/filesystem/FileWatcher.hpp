@@ -0,0 +1,61 @@
+/*! \file FileWatcher.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Reports the files written in a directory
+*/
+
+#pragma once
+#include <Result.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Hush
+{
+    /// @brief Watches the files directly inside a directory. Uses inotify on Linux, other platforms compare write
+    /// times every time WaitForChanges wakes up. Not thread safe, meant to be owned by the thread that waits on it
+    class FileWatcher
+    {
+        FileWatcher(std::filesystem::path directory, int inotifyHandle, int watchHandle) noexcept;
+
+      public:
+        enum class EError
+        {
+            NotADirectory,
+            InternalError,
+        };
+
+        FileWatcher(const FileWatcher &) = delete;
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        FileWatcher(FileWatcher &&rhs) noexcept;
+        FileWatcher &operator=(FileWatcher &&rhs) noexcept;
+
+        ~FileWatcher();
+
+        static Result<FileWatcher, EError> Create(const std::filesystem::path &directory) noexcept;
+
+        /// @brief Blocks for up to timeout, returning as soon as a file was written, created or moved in
+        /// @return The changed files, each once, empty on timeout
+        std::vector<std::filesystem::path> WaitForChanges(std::chrono::milliseconds timeout);
+
+        [[nodiscard]] const std::filesystem::path &GetDirectory() const noexcept
+        {
+            return this->m_directory;
+        }
+
+      private:
+        void Close() noexcept;
+
+        /// @brief Write times of the last scan, only used without inotify
+        void ScanWriteTimes(std::vector<std::filesystem::path> *changedFiles);
+
+        std::filesystem::path m_directory;
+        int m_inotifyHandle = -1;
+        int m_watchHandle = -1;
+        std::unordered_map<std::string, std::filesystem::file_time_type> m_writeTimes;
+    };
+} // namespace Hush
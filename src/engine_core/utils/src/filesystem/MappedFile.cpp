@@ -0,0 +1,126 @@
+/*! \file MappedFile.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Implementation of MappedFile.hpp
+*/
+
+#include "MappedFile.hpp"
+#include "Logger.hpp"
+#include "Platform.hpp"
+
+#include <utility>
+
+#if HUSH_PLATFORM_WIN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Hush::MappedFile::MappedFile(const uint8_t *data, size_t size, void *fileHandle, void *mappingHandle) noexcept
+    : m_data(data), m_size(size), m_fileHandle(fileHandle), m_mappingHandle(mappingHandle)
+{
+}
+
+Hush::MappedFile::MappedFile(MappedFile &&rhs) noexcept
+    : m_data(std::exchange(rhs.m_data, nullptr)), m_size(std::exchange(rhs.m_size, 0u)),
+      m_fileHandle(std::exchange(rhs.m_fileHandle, nullptr)),
+      m_mappingHandle(std::exchange(rhs.m_mappingHandle, nullptr))
+{
+}
+
+Hush::MappedFile &Hush::MappedFile::operator=(MappedFile &&rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this->Close();
+        this->m_data = std::exchange(rhs.m_data, nullptr);
+        this->m_size = std::exchange(rhs.m_size, 0u);
+        this->m_fileHandle = std::exchange(rhs.m_fileHandle, nullptr);
+        this->m_mappingHandle = std::exchange(rhs.m_mappingHandle, nullptr);
+    }
+    return *this;
+}
+
+Hush::MappedFile::~MappedFile()
+{
+    this->Close();
+}
+
+Hush::Result<Hush::MappedFile, Hush::MappedFile::EError> Hush::MappedFile::Open(
+    const std::filesystem::path &path) noexcept
+{
+#if HUSH_PLATFORM_WIN
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LogFormat(ELogLevel::Debug, "Could not open {} for mapping", path.string());
+        return EError::NotFound;
+    }
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return EError::Empty;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return EError::InternalError;
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return EError::InternalError;
+    }
+    return MappedFile(static_cast<const uint8_t *>(view), static_cast<size_t>(fileSize.QuadPart), file, mapping);
+#else
+    int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0)
+    {
+        LogFormat(ELogLevel::Debug, "Could not open {} for mapping", path.string());
+        return EError::NotFound;
+    }
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(file);
+        return EError::Empty;
+    }
+    auto size = static_cast<size_t>(fileStat.st_size);
+    void *view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps the file alive on its own
+    close(file);
+    if (view == MAP_FAILED)
+    {
+        return EError::InternalError;
+    }
+    return MappedFile(static_cast<const uint8_t *>(view), size, nullptr, nullptr);
+#endif
+}
+
+void Hush::MappedFile::Close() noexcept
+{
+    if (this->m_data == nullptr)
+    {
+        return;
+    }
+#if HUSH_PLATFORM_WIN
+    UnmapViewOfFile(this->m_data);
+    CloseHandle(this->m_mappingHandle);
+    CloseHandle(this->m_fileHandle);
+#else
+    munmap(const_cast<uint8_t *>(this->m_data), this->m_size);
+#endif
+    this->m_data = nullptr;
+    this->m_size = 0u;
+    this->m_fileHandle = nullptr;
+    this->m_mappingHandle = nullptr;
+}
@@ -0,0 +1,60 @@
+/*! \file MappedFile.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Read only memory mapped file
+*/
+
+#pragma once
+#include <Result.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace Hush
+{
+    /// @brief Maps a whole file read only, the OS pages it in on demand and nothing is copied. The view stays valid
+    /// as long as the MappedFile lives
+    class MappedFile
+    {
+        MappedFile(const uint8_t *data, size_t size, void *fileHandle, void *mappingHandle) noexcept;
+
+      public:
+        enum class EError
+        {
+            NotFound,
+            /// @brief Empty files can't be mapped
+            Empty,
+            InternalError,
+        };
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&rhs) noexcept;
+        MappedFile &operator=(MappedFile &&rhs) noexcept;
+
+        ~MappedFile();
+
+        static Result<MappedFile, EError> Open(const std::filesystem::path &path) noexcept;
+
+        [[nodiscard]] const uint8_t *GetData() const noexcept
+        {
+            return this->m_data;
+        }
+
+        [[nodiscard]] size_t GetSize() const noexcept
+        {
+            return this->m_size;
+        }
+
+      private:
+        void Close() noexcept;
+
+        const uint8_t *m_data = nullptr;
+        size_t m_size = 0u;
+        /// @brief File and mapping objects on Windows, unused elsewhere (the mapping outlives the descriptor)
+        void *m_fileHandle = nullptr;
+        void *m_mappingHandle = nullptr;
+    };
+} // namespace Hush
@@ -0,0 +1,189 @@
+/*! \file AllocationCounters.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Counts the calls to the global operator new, to find the code that still allocates every frame
+*/
+
+#include "AllocationCounters.hpp"
+#include "Platform.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Constant initialized, so they work for allocations done before main
+    std::atomic<uint64_t> g_allocationCount{0u};
+    std::atomic<uint64_t> g_allocatedBytes{0u};
+} // namespace
+
+uint64_t Hush::AllocationCounters::GetAllocationCount() noexcept
+{
+    return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t Hush::AllocationCounters::GetAllocatedBytes() noexcept
+{
+    return g_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+#if HUSH_TRACK_ALLOCATIONS
+
+// Replacements of the global allocation functions, they are defined in the same file as the getters so the linker
+// always picks them up along with them
+
+namespace
+{
+    void *TrackedAllocate(size_t size) noexcept
+    {
+        g_allocationCount.fetch_add(1u, std::memory_order_relaxed);
+        g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size == 0u ? 1u : size);
+    }
+
+    void *TrackedAllocateAligned(size_t size, std::align_val_t alignment) noexcept
+    {
+        g_allocationCount.fetch_add(1u, std::memory_order_relaxed);
+        g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        auto alignmentBytes = static_cast<size_t>(alignment);
+#if HUSH_PLATFORM_WIN
+        return _aligned_malloc(size == 0u ? 1u : size, alignmentBytes);
+#else
+        // aligned_alloc wants the size to be a multiple of the alignment
+        size_t paddedSize = (size + alignmentBytes - 1u) / alignmentBytes * alignmentBytes;
+        return std::aligned_alloc(alignmentBytes, paddedSize == 0u ? alignmentBytes : paddedSize);
+#endif
+    }
+
+    void TrackedFreeAligned(void *memory) noexcept
+    {
+#if HUSH_PLATFORM_WIN
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+
+    void *AllocateOrThrow(size_t size)
+    {
+        void *memory = TrackedAllocate(size);
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    void *AllocateAlignedOrThrow(size_t size, std::align_val_t alignment)
+    {
+        void *memory = TrackedAllocateAligned(size, alignment);
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+} // namespace
+
+void *operator new(size_t size)
+{
+    return AllocateOrThrow(size);
+}
+
+void *operator new[](size_t size)
+{
+    return AllocateOrThrow(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return TrackedAllocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return TrackedAllocate(size);
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    return AllocateAlignedOrThrow(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    return AllocateAlignedOrThrow(size, alignment);
+}
+
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return TrackedAllocateAligned(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return TrackedAllocateAligned(size, alignment);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+    TrackedFreeAligned(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t) noexcept
+{
+    TrackedFreeAligned(memory);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t) noexcept
+{
+    TrackedFreeAligned(memory);
+}
+
+void operator delete[](void *memory, size_t, std::align_val_t) noexcept
+{
+    TrackedFreeAligned(memory);
+}
+
+void operator delete(void *memory, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    TrackedFreeAligned(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    TrackedFreeAligned(memory);
+}
+
+#endif
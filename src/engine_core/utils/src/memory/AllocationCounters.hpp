@@ -0,0 +1,29 @@
+/*! \file AllocationCounters.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Counts the calls to the global operator new, to find the code that still allocates every frame
+*/
+
+#pragma once
+#include <cstdint>
+
+#ifndef HUSH_TRACK_ALLOCATIONS
+#define HUSH_TRACK_ALLOCATIONS 0
+#endif
+
+namespace Hush
+{
+    /// @brief Running totals of the global operator new. Only counted when built with HUSH_TRACK_ALLOCATIONS, which
+    /// replaces the global new/delete operators. Direct malloc calls (C libraries, drivers) aren't seen
+    class AllocationCounters
+    {
+      public:
+        static constexpr bool IS_TRACKING = HUSH_TRACK_ALLOCATIONS != 0;
+
+        /// @brief Allocations since the program started, from every thread
+        static uint64_t GetAllocationCount() noexcept;
+
+        /// @brief Bytes requested since the program started, frees aren't subtracted
+        static uint64_t GetAllocatedBytes() noexcept;
+    };
+} // namespace Hush
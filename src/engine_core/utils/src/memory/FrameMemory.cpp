@@ -0,0 +1,109 @@
+/*! \file FrameMemory.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Per thread frame arenas for transient CPU data, recycled by the main loop every frame
+*/
+
+#include "FrameMemory.hpp"
+#include "AllocationCounters.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    using Hush::FrameMemory;
+
+    /// @brief Never moved once created, the resources point to the arenas
+    struct ThreadArenas
+    {
+        std::array<Hush::LinearAllocator, FrameMemory::SLOT_COUNT> arenas;
+        std::array<Hush::LinearMemoryResource, FrameMemory::SLOT_COUNT> resources{
+            Hush::LinearMemoryResource(arenas[0]), Hush::LinearMemoryResource(arenas[1])};
+    };
+
+    static_assert(FrameMemory::SLOT_COUNT == 2, "Update the resources initializer of ThreadArenas");
+
+    /// @brief Arenas of every thread that ever used them, BeginFrame walks them to reset the recycled slot
+    struct FrameMemoryRegistry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadArenas>> threads;
+    };
+
+    FrameMemoryRegistry &GetRegistry()
+    {
+        static FrameMemoryRegistry registry;
+        return registry;
+    }
+
+    std::atomic<uint32_t> g_currentSlot{0u};
+    uint64_t g_lastAllocationCount = 0u;
+    uint64_t g_lastAllocatedBytes = 0u;
+    Hush::FrameMemoryStats g_lastFrameStats{};
+
+    thread_local ThreadArenas *tlsThreadArenas = nullptr;
+
+    ThreadArenas &GetThreadArenas() noexcept
+    {
+        if (tlsThreadArenas == nullptr)
+        {
+            FrameMemoryRegistry &registry = GetRegistry();
+            std::lock_guard lock(registry.mutex);
+            tlsThreadArenas = registry.threads.emplace_back(std::make_unique<ThreadArenas>()).get();
+        }
+        return *tlsThreadArenas;
+    }
+} // namespace
+
+void Hush::FrameMemory::BeginFrame() noexcept
+{
+    uint64_t allocationCount = AllocationCounters::GetAllocationCount();
+    uint64_t allocatedBytes = AllocationCounters::GetAllocatedBytes();
+    g_lastFrameStats.heapAllocations = allocationCount - g_lastAllocationCount;
+    g_lastFrameStats.heapBytes = allocatedBytes - g_lastAllocatedBytes;
+
+    uint32_t slot = (g_currentSlot.load(std::memory_order_relaxed) + 1u) % SLOT_COUNT;
+    g_lastFrameStats.arenaBytes = 0u;
+    g_lastFrameStats.arenaOverflows = 0u;
+    {
+        FrameMemoryRegistry &registry = GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        for (const std::unique_ptr<ThreadArenas> &thread : registry.threads)
+        {
+            LinearAllocator &arena = thread->arenas[slot];
+            g_lastFrameStats.arenaBytes += arena.GetUsedBytes();
+            g_lastFrameStats.arenaOverflows += arena.GetOverflowCount();
+            arena.Reset();
+        }
+    }
+    g_currentSlot.store(slot, std::memory_order_release);
+
+    // Resetting may regrow an arena, leave that out of the next frame's count
+    g_lastAllocationCount = AllocationCounters::GetAllocationCount();
+    g_lastAllocatedBytes = AllocationCounters::GetAllocatedBytes();
+}
+
+Hush::LinearAllocator &Hush::FrameMemory::GetThreadArena() noexcept
+{
+    return GetThreadArenas().arenas[g_currentSlot.load(std::memory_order_acquire)];
+}
+
+std::pmr::memory_resource *Hush::FrameMemory::GetThreadResource() noexcept
+{
+    return &GetThreadArenas().resources[g_currentSlot.load(std::memory_order_acquire)];
+}
+
+Hush::LinearAllocator &Hush::FrameMemory::GetScratchArena() noexcept
+{
+    thread_local LinearAllocator scratchArena;
+    return scratchArena;
+}
+
+const Hush::FrameMemoryStats &Hush::FrameMemory::GetLastFrameStats() noexcept
+{
+    return g_lastFrameStats;
+}
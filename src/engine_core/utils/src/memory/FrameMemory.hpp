@@ -0,0 +1,54 @@
+/*! \file FrameMemory.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Per thread frame arenas for transient CPU data, recycled by the main loop every frame
+*/
+
+#pragma once
+#include "LinearAllocator.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+
+namespace Hush
+{
+    /// @brief Memory usage of one frame, see FrameMemory::GetLastFrameStats
+    struct FrameMemoryStats
+    {
+        /// @brief Calls to the global operator new during the last frame, 0 unless built with HUSH_TRACK_ALLOCATIONS
+        uint64_t heapAllocations = 0u;
+        uint64_t heapBytes = 0u;
+        /// @brief Bytes taken from the frame arenas of every thread, by the frame that just got recycled (it's
+        /// SLOT_COUNT - 1 frames older than the heap counts)
+        uint64_t arenaBytes = 0u;
+        /// @brief Times that frame didn't fit in an arena and had to go to the heap
+        uint64_t arenaOverflows = 0u;
+    };
+
+    /// @brief Every thread gets SLOT_COUNT frame arenas, one per frame in flight, so memory of the previous frame stays
+    /// valid while the next one is being built. BeginFrame resets the arenas of the slot coming around again.
+    /// Only use the frame arenas from threads paced by the main loop (the main thread and its jobs), a thread running
+    /// ahead or behind by more than one frame, like the render thread, would see its memory recycled under it
+    class FrameMemory
+    {
+      public:
+        static constexpr uint32_t SLOT_COUNT = 2;
+
+        /// @brief Call from the main thread at the start of every frame, with no jobs of the older frame in flight
+        static void BeginFrame() noexcept;
+
+        /// @brief Arena of the calling thread for the current frame, released SLOT_COUNT frames from now
+        static LinearAllocator &GetThreadArena() noexcept;
+
+        /// @brief std::pmr view of GetThreadArena, e.g. std::pmr::vector<int> values(FrameMemory::GetThreadResource())
+        static std::pmr::memory_resource *GetThreadResource() noexcept;
+
+        /// @brief Thread local allocator that is never reset by the frame, for memory released before the function
+        /// that took it returns. Always pair it with an ArenaScope, it's safe to use from any thread. When the
+        /// outermost scope ends after an overflow the arena grows to fit, later calls stay off the heap
+        static LinearAllocator &GetScratchArena() noexcept;
+
+        /// @brief Only valid on the main thread
+        [[nodiscard]] static const FrameMemoryStats &GetLastFrameStats() noexcept;
+    };
+} // namespace Hush
@@ -0,0 +1,129 @@
+/*! \file FreeListAllocator.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Offset allocator over a range of abstract units, for memory the CPU doesn't own (GPU buffers)
+*/
+
+#include "FreeListAllocator.hpp"
+#include "Assertions.hpp"
+
+#include <algorithm>
+
+Hush::FreeListAllocator::FreeListAllocator(uint64_t capacity)
+{
+    this->Reset(capacity);
+}
+
+void Hush::FreeListAllocator::Reset(uint64_t capacity)
+{
+    this->m_freeRanges.clear();
+    if (capacity > 0u)
+    {
+        this->m_freeRanges.push_back({0u, capacity});
+    }
+    this->m_capacity = capacity;
+    this->m_freeUnits = capacity;
+}
+
+uint64_t Hush::FreeListAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+    if (size == 0u)
+    {
+        return INVALID_OFFSET;
+    }
+    for (size_t i = 0u; i < this->m_freeRanges.size(); i++)
+    {
+        Range range = this->m_freeRanges[i];
+        uint64_t offset = (range.offset + alignment - 1u) & ~(alignment - 1u);
+        uint64_t padding = offset - range.offset;
+        if (padding + size > range.size)
+        {
+            continue;
+        }
+        uint64_t tailSize = range.size - padding - size;
+        auto position = this->m_freeRanges.begin() + static_cast<ptrdiff_t>(i);
+        if (padding > 0u && tailSize > 0u)
+        {
+            // Splits in two, the padding stays free in front of the allocation
+            this->m_freeRanges[i].size = padding;
+            this->m_freeRanges.insert(position + 1, Range{offset + size, tailSize});
+        }
+        else if (padding > 0u)
+        {
+            this->m_freeRanges[i].size = padding;
+        }
+        else if (tailSize > 0u)
+        {
+            this->m_freeRanges[i] = Range{offset + size, tailSize};
+        }
+        else
+        {
+            this->m_freeRanges.erase(position);
+        }
+        this->m_freeUnits -= size;
+        return offset;
+    }
+    return INVALID_OFFSET;
+}
+
+void Hush::FreeListAllocator::Free(uint64_t offset, uint64_t size)
+{
+    if (size == 0u)
+    {
+        return;
+    }
+    HUSH_ASSERT(offset + size <= this->m_capacity, "Freeing [{}, {}) out of a capacity of {}", offset, offset + size,
+                this->m_capacity);
+    auto next = std::lower_bound(this->m_freeRanges.begin(), this->m_freeRanges.end(), offset,
+                                 [](const Range &range, uint64_t value) { return range.offset < value; });
+    HUSH_ASSERT(next == this->m_freeRanges.end() || offset + size <= next->offset,
+                "Freeing [{}, {}) overlaps a free range", offset, offset + size);
+
+    auto previous = next != this->m_freeRanges.begin() ? std::prev(next) : this->m_freeRanges.end();
+    bool mergesPrevious = previous != this->m_freeRanges.end() && previous->offset + previous->size == offset;
+    bool mergesNext = next != this->m_freeRanges.end() && offset + size == next->offset;
+    if (mergesPrevious && mergesNext)
+    {
+        previous->size += size + next->size;
+        this->m_freeRanges.erase(next);
+    }
+    else if (mergesPrevious)
+    {
+        previous->size += size;
+    }
+    else if (mergesNext)
+    {
+        next->offset = offset;
+        next->size += size;
+    }
+    else
+    {
+        this->m_freeRanges.insert(next, Range{offset, size});
+    }
+    this->m_freeUnits += size;
+}
+
+uint64_t Hush::FreeListAllocator::GetCapacity() const noexcept
+{
+    return this->m_capacity;
+}
+
+uint64_t Hush::FreeListAllocator::GetFreeUnits() const noexcept
+{
+    return this->m_freeUnits;
+}
+
+uint64_t Hush::FreeListAllocator::GetLargestFreeRange() const noexcept
+{
+    uint64_t largest = 0u;
+    for (const Range &range : this->m_freeRanges)
+    {
+        largest = std::max(largest, range.size);
+    }
+    return largest;
+}
+
+size_t Hush::FreeListAllocator::GetFreeRangeCount() const noexcept
+{
+    return this->m_freeRanges.size();
+}
@@ -0,0 +1,56 @@
+/*! \file FreeListAllocator.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Offset allocator over a range of abstract units, for memory the CPU doesn't own (GPU buffers)
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Hush
+{
+    /// @brief Hands out [offset, offset + size) ranges of a capacity measured in any unit (bytes, vertices,
+    /// indices...), it never touches the memory itself. Free ranges are kept sorted by offset and merged with their
+    /// neighbours when released, allocation is first fit. Not thread safe
+    class FreeListAllocator
+    {
+      public:
+        static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+        explicit FreeListAllocator(uint64_t capacity = 0u);
+
+        /// @brief Forgets every allocation, the whole capacity is free again
+        void Reset(uint64_t capacity);
+
+        /// @brief First free range that fits size units at the given alignment (a power of two)
+        /// @return INVALID_OFFSET when no range is big enough
+        [[nodiscard]] uint64_t Allocate(uint64_t size, uint64_t alignment = 1u);
+
+        /// @brief Returns a range handed out by Allocate, size must be the one it was allocated with
+        void Free(uint64_t offset, uint64_t size);
+
+        [[nodiscard]] uint64_t GetCapacity() const noexcept;
+
+        [[nodiscard]] uint64_t GetFreeUnits() const noexcept;
+
+        /// @brief Biggest allocation that's guaranteed to succeed, the free space is fragmented when it's much smaller
+        /// than GetFreeUnits
+        [[nodiscard]] uint64_t GetLargestFreeRange() const noexcept;
+
+        [[nodiscard]] size_t GetFreeRangeCount() const noexcept;
+
+      private:
+        struct Range
+        {
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        /// @brief Sorted by offset, two ranges are never adjacent
+        std::vector<Range> m_freeRanges;
+        uint64_t m_capacity = 0u;
+        uint64_t m_freeUnits = 0u;
+    };
+} // namespace Hush
@@ -0,0 +1,169 @@
+/*! \file LinearAllocator.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Bump allocator for transient data, everything it hands out is released at once by Reset
+*/
+
+#include "LinearAllocator.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    /// @brief Overflow blocks we can record before the list itself needs the heap
+    constexpr size_t RESERVED_OVERFLOW_BLOCKS = 32u;
+} // namespace
+
+Hush::LinearAllocator::LinearAllocator(size_t capacity)
+    : m_buffer(AllocateBlock(capacity)), m_capacity(m_buffer != nullptr ? capacity : 0u)
+{
+    this->m_overflowBlocks.reserve(RESERVED_OVERFLOW_BLOCKS);
+}
+
+Hush::LinearAllocator::LinearAllocator(LinearAllocator &&rhs) noexcept
+    : m_buffer(std::exchange(rhs.m_buffer, nullptr)), m_capacity(std::exchange(rhs.m_capacity, 0u)),
+      m_offset(std::exchange(rhs.m_offset, 0u)), m_overflowBytes(std::exchange(rhs.m_overflowBytes, 0u)),
+      m_overflowCount(std::exchange(rhs.m_overflowCount, 0u)), m_peakBytes(std::exchange(rhs.m_peakBytes, 0u)),
+      m_overflowBlocks(std::move(rhs.m_overflowBlocks))
+{
+}
+
+Hush::LinearAllocator &Hush::LinearAllocator::operator=(LinearAllocator &&rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this->ReleaseAll();
+        this->m_buffer = std::exchange(rhs.m_buffer, nullptr);
+        this->m_capacity = std::exchange(rhs.m_capacity, 0u);
+        this->m_offset = std::exchange(rhs.m_offset, 0u);
+        this->m_overflowBytes = std::exchange(rhs.m_overflowBytes, 0u);
+        this->m_overflowCount = std::exchange(rhs.m_overflowCount, 0u);
+        this->m_peakBytes = std::exchange(rhs.m_peakBytes, 0u);
+        this->m_overflowBlocks = std::move(rhs.m_overflowBlocks);
+    }
+    return *this;
+}
+
+Hush::LinearAllocator::~LinearAllocator()
+{
+    this->ReleaseAll();
+}
+
+void *Hush::LinearAllocator::Allocate(size_t size, size_t alignment) noexcept
+{
+    if (this->m_buffer != nullptr)
+    {
+        std::byte *aligned = AlignPointer(this->m_buffer + this->m_offset, alignment);
+        auto alignedOffset = static_cast<size_t>(aligned - this->m_buffer);
+        if (alignedOffset <= this->m_capacity && size <= this->m_capacity - alignedOffset)
+        {
+            this->m_offset = alignedOffset + size;
+            this->m_peakBytes = std::max(this->m_peakBytes, this->m_offset + this->m_overflowBytes);
+            return aligned;
+        }
+    }
+    return this->AllocateOverflow(size, alignment);
+}
+
+void Hush::LinearAllocator::Reset() noexcept
+{
+    this->ReleaseOverflowBlocks(0u);
+    this->m_offset = 0u;
+    this->GrowToPeak();
+    this->m_overflowCount = 0u;
+}
+
+Hush::LinearAllocator::Marker Hush::LinearAllocator::GetMarker() const noexcept
+{
+    return {this->m_offset, this->m_overflowBlocks.size()};
+}
+
+void Hush::LinearAllocator::ResetToMarker(const Marker &marker) noexcept
+{
+    // Allocations only ever move forward, so everything past the marker is newer than it
+    this->ReleaseOverflowBlocks(marker.overflowBlockCount);
+    this->m_offset = marker.offset;
+    if (marker.offset == 0u && marker.overflowBlockCount == 0u)
+    {
+        // The overflow count is left for Reset, the frame stats read it
+        this->GrowToPeak();
+    }
+}
+
+size_t Hush::LinearAllocator::GetUsedBytes() const noexcept
+{
+    return this->m_offset + this->m_overflowBytes;
+}
+
+size_t Hush::LinearAllocator::GetCapacity() const noexcept
+{
+    return this->m_capacity;
+}
+
+size_t Hush::LinearAllocator::GetOverflowCount() const noexcept
+{
+    return this->m_overflowCount;
+}
+
+void *Hush::LinearAllocator::AllocateOverflow(size_t size, size_t alignment) noexcept
+{
+    size_t padding = alignment > BLOCK_ALIGNMENT ? alignment - BLOCK_ALIGNMENT : 0u;
+    std::byte *block = AllocateBlock(size + padding);
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+    this->m_overflowBlocks.push_back({block, size + padding});
+    this->m_overflowBytes += size + padding;
+    this->m_overflowCount++;
+    this->m_peakBytes = std::max(this->m_peakBytes, this->m_offset + this->m_overflowBytes);
+    return AlignPointer(block, alignment);
+}
+
+void Hush::LinearAllocator::ReleaseOverflowBlocks(size_t keepCount) noexcept
+{
+    while (this->m_overflowBlocks.size() > keepCount)
+    {
+        const OverflowBlock &block = this->m_overflowBlocks.back();
+        this->m_overflowBytes -= block.size;
+        ::operator delete(block.memory, std::align_val_t{BLOCK_ALIGNMENT});
+        this->m_overflowBlocks.pop_back();
+    }
+}
+
+void Hush::LinearAllocator::ReleaseAll() noexcept
+{
+    this->ReleaseOverflowBlocks(0u);
+    if (this->m_buffer != nullptr)
+    {
+        ::operator delete(this->m_buffer, std::align_val_t{BLOCK_ALIGNMENT});
+        this->m_buffer = nullptr;
+    }
+    this->m_capacity = 0u;
+}
+
+void Hush::LinearAllocator::GrowToPeak() noexcept
+{
+    if (this->m_peakBytes > this->m_capacity)
+    {
+        // Grow with some headroom, so a frame slightly bigger than the last one doesn't overflow again
+        size_t newCapacity = this->m_peakBytes + this->m_peakBytes / 4u;
+        this->ReleaseAll();
+        this->m_buffer = AllocateBlock(newCapacity);
+        this->m_capacity = this->m_buffer != nullptr ? newCapacity : 0u;
+    }
+    this->m_peakBytes = 0u;
+}
+
+std::byte *Hush::LinearAllocator::AllocateBlock(size_t size) noexcept
+{
+    return static_cast<std::byte *>(::operator new(size, std::align_val_t{BLOCK_ALIGNMENT}, std::nothrow));
+}
+
+std::byte *Hush::LinearAllocator::AlignPointer(std::byte *pointer, size_t alignment) noexcept
+{
+    auto address = reinterpret_cast<uintptr_t>(pointer);
+    uintptr_t aligned = (address + alignment - 1u) & ~static_cast<uintptr_t>(alignment - 1u);
+    return pointer + (aligned - address);
+}
@@ -0,0 +1,156 @@
+/*! \file LinearAllocator.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Bump allocator for transient data, everything it hands out is released at once by Reset
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+namespace Hush
+{
+    /// @brief Hands out memory by bumping an offset into a single block, individual allocations are never freed.
+    /// When a frame needs more than the block holds, the rest comes from extra blocks on the heap and the next Reset
+    /// grows the block to the high water mark, so a steady state workload does no heap allocations at all
+    class LinearAllocator
+    {
+      public:
+        static constexpr size_t DEFAULT_CAPACITY = 256u * 1024u;
+        /// @brief Alignment of every block, allocations with a bigger one get padded
+        static constexpr size_t BLOCK_ALIGNMENT = 64u;
+
+        /// @brief Position of the allocator, used to release everything allocated after it (see ArenaScope)
+        struct Marker
+        {
+            size_t offset;
+            size_t overflowBlockCount;
+        };
+
+        explicit LinearAllocator(size_t capacity = DEFAULT_CAPACITY);
+
+        LinearAllocator(const LinearAllocator &) = delete;
+        LinearAllocator &operator=(const LinearAllocator &) = delete;
+
+        LinearAllocator(LinearAllocator &&rhs) noexcept;
+        LinearAllocator &operator=(LinearAllocator &&rhs) noexcept;
+
+        ~LinearAllocator();
+
+        /// @return Memory for size bytes with the given alignment (a power of two), nullptr only if the heap is out
+        [[nodiscard]] void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+
+        /// @brief Uninitialized storage for count objects of type T
+        template <class T> [[nodiscard]] T *Allocate(size_t count) noexcept
+        {
+            return static_cast<T *>(this->Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        /// @brief Releases every allocation. O(1) unless the last frame overflowed, in which case the block is regrown
+        void Reset() noexcept;
+
+        [[nodiscard]] Marker GetMarker() const noexcept;
+
+        /// @brief Releases everything allocated after the marker was taken, the overflow blocks included. They still
+        /// count towards the size the next Reset grows the block to. A marker taken on an empty allocator grows the
+        /// block right away, so allocators that are never Reset (only rewound by scopes) stop overflowing too
+        void ResetToMarker(const Marker &marker) noexcept;
+
+        /// @brief Bytes handed out since the last Reset, including overflow blocks
+        [[nodiscard]] size_t GetUsedBytes() const noexcept;
+
+        [[nodiscard]] size_t GetCapacity() const noexcept;
+
+        /// @brief Heap allocations done because the block was full since the last Reset
+        [[nodiscard]] size_t GetOverflowCount() const noexcept;
+
+      private:
+        struct OverflowBlock
+        {
+            std::byte *memory;
+            size_t size;
+        };
+
+        void *AllocateOverflow(size_t size, size_t alignment) noexcept;
+
+        void ReleaseOverflowBlocks(size_t keepCount) noexcept;
+
+        void ReleaseAll() noexcept;
+
+        /// @brief Grows the block to the high water mark if it went past it, and starts tracking a new one. Nothing
+        /// can be allocated
+        void GrowToPeak() noexcept;
+
+        static std::byte *AllocateBlock(size_t size) noexcept;
+
+        static std::byte *AlignPointer(std::byte *pointer, size_t alignment) noexcept;
+
+        std::byte *m_buffer = nullptr;
+        size_t m_capacity = 0u;
+        size_t m_offset = 0u;
+        size_t m_overflowBytes = 0u;
+        size_t m_overflowCount = 0u;
+        /// @brief Most bytes used at once since the last Reset, the block grows to fit it
+        size_t m_peakBytes = 0u;
+        /// @brief Reserved up front, so recording an overflow doesn't add one more heap allocation
+        std::vector<OverflowBlock> m_overflowBlocks;
+    };
+
+    /// @brief Rewinds an allocator to where it was when the scope started, for transient memory that's done with
+    /// before the frame is
+    class ArenaScope
+    {
+      public:
+        explicit ArenaScope(LinearAllocator &allocator) noexcept
+            : m_allocator(allocator), m_marker(allocator.GetMarker())
+        {
+        }
+
+        ArenaScope(const ArenaScope &) = delete;
+        ArenaScope &operator=(const ArenaScope &) = delete;
+
+        ~ArenaScope()
+        {
+            this->m_allocator.ResetToMarker(this->m_marker);
+        }
+
+      private:
+        LinearAllocator &m_allocator;
+        LinearAllocator::Marker m_marker;
+    };
+
+    /// @brief std::pmr adapter, lets std::pmr::vector and friends allocate from a LinearAllocator. Deallocation is a
+    /// no-op, the memory goes back with the allocator's Reset
+    class LinearMemoryResource final : public std::pmr::memory_resource
+    {
+      public:
+        explicit LinearMemoryResource(LinearAllocator &allocator) noexcept : m_allocator(&allocator)
+        {
+        }
+
+      private:
+        void *do_allocate(size_t bytes, size_t alignment) override
+        {
+            void *memory = this->m_allocator->Allocate(bytes, alignment);
+            if (memory == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return memory;
+        }
+
+        void do_deallocate(void *, size_t, size_t) override
+        {
+        }
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        LinearAllocator *m_allocator;
+    };
+} // namespace Hush
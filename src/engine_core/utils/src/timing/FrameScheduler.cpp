@@ -0,0 +1,200 @@
+/*! \file FrameScheduler.cpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Paces the main loop, computes delta time and drives the fixed timestep simulation
+*/
+
+#include "FrameScheduler.hpp"
+#include "Time.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+/// @brief Longest delta time we accept, anything above (breakpoints, window drags, etc.) gets clamped
+constexpr double MAX_DELTA_TIME = 0.25;
+
+constexpr uint32_t DEFAULT_IDLE_FRAME_RATE = 10;
+
+constexpr std::chrono::milliseconds SLEEP_GRANULARITY{1};
+
+using SecondsDuration = std::chrono::duration<double>;
+using MillisecondsDuration = std::chrono::duration<double, std::milli>;
+
+Hush::FrameScheduler::FrameScheduler(double fixedTimeStep, uint32_t targetFrameRate) noexcept
+    : m_startTime(Clock::now()), m_frameStart(m_startTime), m_nextDeadline(m_startTime),
+      m_targetPeriod(PeriodFromFrameRate(targetFrameRate)), m_idlePeriod(PeriodFromFrameRate(DEFAULT_IDLE_FRAME_RATE)),
+      m_fixedTimeStep(fixedTimeStep)
+{
+    this->PublishTime();
+}
+
+void Hush::FrameScheduler::BeginFrame() noexcept
+{
+    Clock::time_point now = Clock::now();
+    if (this->m_resync)
+    {
+        // Coming back from idle (or the first frame), nothing was simulated in between so there's no time to catch up
+        this->m_deltaTime = 0.0;
+        this->m_nextDeadline = now + this->m_targetPeriod;
+        this->m_resync = false;
+    }
+    else
+    {
+        this->m_deltaTime = std::min(SecondsDuration(now - this->m_frameStart).count(), MAX_DELTA_TIME);
+    }
+    this->m_frameStart = now;
+    this->m_accumulator += this->m_deltaTime;
+    this->m_fixedStepsThisFrame = 0;
+    this->m_frameCount++;
+
+    this->m_currentStats.fixedSteps = 0;
+    this->m_currentStats.missedDeadline = false;
+
+    this->PublishTime();
+}
+
+bool Hush::FrameScheduler::ConsumeFixedStep() noexcept
+{
+    if (this->m_accumulator < this->m_fixedTimeStep)
+    {
+        this->PublishTime();
+        return false;
+    }
+
+    if (this->m_fixedStepsThisFrame >= this->m_maxFixedSteps)
+    {
+        // We can't keep up, drop the whole steps left and keep the remainder for the interpolation alpha
+        double droppedSteps = std::floor(this->m_accumulator / this->m_fixedTimeStep);
+        this->m_currentStats.droppedFixedSteps += static_cast<uint64_t>(droppedSteps);
+        this->m_accumulator -= droppedSteps * this->m_fixedTimeStep;
+        this->PublishTime();
+        return false;
+    }
+
+    this->m_accumulator -= this->m_fixedTimeStep;
+    this->m_fixedStepsThisFrame++;
+    this->m_currentStats.fixedSteps = this->m_fixedStepsThisFrame;
+    return true;
+}
+
+void Hush::FrameScheduler::EndFrame() noexcept
+{
+    Clock::time_point cpuEnd = Clock::now();
+    Clock::duration waited{};
+
+    if (this->m_targetPeriod > Clock::duration::zero())
+    {
+        if (cpuEnd > this->m_nextDeadline)
+        {
+            // Don't try to make up for the lost time by rushing the next frames, just restart the cadence from here
+            this->m_currentStats.missedDeadline = true;
+            this->m_currentStats.missedDeadlines++;
+            this->m_nextDeadline = cpuEnd + this->m_targetPeriod;
+        }
+        else
+        {
+            waited = this->WaitUntil(this->m_nextDeadline);
+            this->m_nextDeadline += this->m_targetPeriod;
+        }
+    }
+
+    this->m_currentStats.cpuTimeMs = MillisecondsDuration(cpuEnd - this->m_frameStart).count();
+    this->m_currentStats.waitTimeMs = MillisecondsDuration(waited).count();
+    this->m_currentStats.frameTimeMs = this->m_currentStats.cpuTimeMs + this->m_currentStats.waitTimeMs;
+    this->m_lastStats = this->m_currentStats;
+}
+
+void Hush::FrameScheduler::WaitIdle() noexcept
+{
+    this->WaitUntil(Clock::now() + this->m_idlePeriod);
+    this->m_resync = true;
+}
+
+void Hush::FrameScheduler::SetTargetFrameRate(uint32_t targetFrameRate) noexcept
+{
+    this->m_targetPeriod = PeriodFromFrameRate(targetFrameRate);
+    this->m_resync = true;
+}
+
+void Hush::FrameScheduler::SetFixedTimeStep(double fixedTimeStep) noexcept
+{
+    this->m_fixedTimeStep = fixedTimeStep;
+    this->PublishTime();
+}
+
+void Hush::FrameScheduler::SetMaxFixedStepsPerFrame(uint32_t maxSteps) noexcept
+{
+    this->m_maxFixedSteps = maxSteps;
+}
+
+void Hush::FrameScheduler::SetIdleFrameRate(uint32_t idleFrameRate) noexcept
+{
+    this->m_idlePeriod = PeriodFromFrameRate(idleFrameRate);
+}
+
+double Hush::FrameScheduler::GetDeltaTime() const noexcept
+{
+    return this->m_deltaTime;
+}
+
+double Hush::FrameScheduler::GetFixedTimeStep() const noexcept
+{
+    return this->m_fixedTimeStep;
+}
+
+const Hush::FrameStats &Hush::FrameScheduler::GetLastFrameStats() const noexcept
+{
+    return this->m_lastStats;
+}
+
+Hush::FrameScheduler::Clock::duration Hush::FrameScheduler::WaitUntil(Clock::time_point deadline) noexcept
+{
+    Clock::time_point waitStart = Clock::now();
+    // Sleep in small steps while the remaining time is bigger than what the OS might overshoot
+    while (true)
+    {
+        Clock::time_point sleepStart = Clock::now();
+        double remaining = SecondsDuration(deadline - sleepStart).count();
+        if (remaining <= this->m_sleepEstimate)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(SLEEP_GRANULARITY);
+        this->UpdateSleepEstimate(SecondsDuration(Clock::now() - sleepStart).count());
+    }
+    // Spin the rest, this is what keeps the frame times stable
+    while (Clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+    return Clock::now() - waitStart;
+}
+
+void Hush::FrameScheduler::UpdateSleepEstimate(double observedSeconds) noexcept
+{
+    this->m_sleepSamples++;
+    double delta = observedSeconds - this->m_sleepMean;
+    this->m_sleepMean += delta / static_cast<double>(this->m_sleepSamples);
+    this->m_sleepM2 += delta * (observedSeconds - this->m_sleepMean);
+    double stdDev = std::sqrt(this->m_sleepM2 / static_cast<double>(this->m_sleepSamples - 1));
+    this->m_sleepEstimate = this->m_sleepMean + stdDev;
+}
+
+void Hush::FrameScheduler::PublishTime() const noexcept
+{
+    Time::S_DELTA_TIME = static_cast<float>(this->m_deltaTime);
+    Time::S_FIXED_DELTA_TIME = static_cast<float>(this->m_fixedTimeStep);
+    Time::S_FIXED_ALPHA = static_cast<float>(this->m_accumulator / this->m_fixedTimeStep);
+    Time::S_TIME_SINCE_STARTUP = SecondsDuration(this->m_frameStart - this->m_startTime).count();
+    Time::S_FRAME_COUNT = this->m_frameCount;
+}
+
+Hush::FrameScheduler::Clock::duration Hush::FrameScheduler::PeriodFromFrameRate(uint32_t frameRate) noexcept
+{
+    if (frameRate == 0)
+    {
+        return Clock::duration::zero();
+    }
+    return std::chrono::duration_cast<Clock::duration>(SecondsDuration(1.0 / static_cast<double>(frameRate)));
+}
@@ -0,0 +1,109 @@
+/*! \file FrameScheduler.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Paces the main loop, computes delta time and drives the fixed timestep simulation
+*/
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace Hush
+{
+    /// @brief Timing information of the last finished frame
+    struct FrameStats
+    {
+        /// @brief Time spent doing work on the CPU (everything between BeginFrame and EndFrame)
+        double cpuTimeMs = 0.0;
+        /// @brief Time spent waiting to hit the target frame rate
+        double waitTimeMs = 0.0;
+        /// @brief Total duration of the frame, cpu + wait
+        double frameTimeMs = 0.0;
+        /// @brief Fixed updates run on this frame
+        uint32_t fixedSteps = 0;
+        /// @brief Whether the CPU work alone took longer than the target frame time
+        bool missedDeadline = false;
+        /// @brief Deadlines missed since the scheduler started
+        uint64_t missedDeadlines = 0;
+        /// @brief Fixed steps dropped because a frame needed more than the max steps per frame
+        uint64_t droppedFixedSteps = 0;
+    };
+
+    /// @brief Frame pacing with a fixed timestep accumulator, based on https://gafferongames.com/post/fix_your_timestep/
+    /// Waits are done with a hybrid sleep/spin approach, the OS sleep is only trusted up to its measured error and
+    /// the rest of the wait spins, which keeps CPU usage low without adding jitter to the frame times
+    class FrameScheduler
+    {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @param fixedTimeStep seconds simulated on each fixed step
+        /// @param targetFrameRate frames per second to cap the loop to, 0 leaves it uncapped
+        FrameScheduler(double fixedTimeStep, uint32_t targetFrameRate) noexcept;
+
+        /// @brief Starts a new frame, computing the delta time and feeding the fixed step accumulator
+        void BeginFrame() noexcept;
+
+        /// @brief Consumes one fixed step from the accumulator, call in a loop until it returns false
+        /// @return true if a fixed update must run
+        bool ConsumeFixedStep() noexcept;
+
+        /// @brief Ends the CPU work of the frame and waits until the target frame time is reached
+        void EndFrame() noexcept;
+
+        /// @brief Waits for the idle period (used when the window is not active), the simulation doesn't advance
+        /// while idling
+        void WaitIdle() noexcept;
+
+        /// @param targetFrameRate frames per second to cap the loop to, 0 leaves it uncapped
+        void SetTargetFrameRate(uint32_t targetFrameRate) noexcept;
+
+        void SetFixedTimeStep(double fixedTimeStep) noexcept;
+
+        /// @brief Caps the fixed steps run per frame so a slow frame can't spiral into slower ones
+        void SetMaxFixedStepsPerFrame(uint32_t maxSteps) noexcept;
+
+        void SetIdleFrameRate(uint32_t idleFrameRate) noexcept;
+
+        [[nodiscard]] double GetDeltaTime() const noexcept;
+
+        [[nodiscard]] double GetFixedTimeStep() const noexcept;
+
+        [[nodiscard]] const FrameStats &GetLastFrameStats() const noexcept;
+
+      private:
+        /// @brief Waits until the given point in time, sleeping while it's safe and spinning the rest
+        /// @return Time actually spent waiting
+        Clock::duration WaitUntil(Clock::time_point deadline) noexcept;
+
+        /// @brief Updates the running estimate of how long a 1ms OS sleep really takes (Welford's algorithm)
+        void UpdateSleepEstimate(double observedSeconds) noexcept;
+
+        void PublishTime() const noexcept;
+
+        static Clock::duration PeriodFromFrameRate(uint32_t frameRate) noexcept;
+
+        Clock::time_point m_startTime;
+        Clock::time_point m_frameStart;
+        Clock::time_point m_nextDeadline;
+        Clock::duration m_targetPeriod{};
+        Clock::duration m_idlePeriod{};
+
+        double m_fixedTimeStep;
+        double m_deltaTime = 0.0;
+        double m_accumulator = 0.0;
+        uint32_t m_maxFixedSteps = 8;
+        uint32_t m_fixedStepsThisFrame = 0;
+        uint64_t m_frameCount = 0;
+        bool m_resync = true;
+
+        // Sleep error estimation, start pessimistic until we measured the OS
+        double m_sleepEstimate = 5e-3;
+        double m_sleepMean = 5e-3;
+        double m_sleepM2 = 0.0;
+        uint64_t m_sleepSamples = 1;
+
+        FrameStats m_currentStats{};
+        FrameStats m_lastStats{};
+    };
+} // namespace Hush
@@ -0,0 +1,58 @@
+/*! \file Time.hpp
+    \author Kyn21kx
+    \date 2026-10-17
+    \brief Global access to the timing information of the current frame
+*/
+
+#pragma once
+#include <cstdint>
+
+namespace Hush
+{
+    class FrameScheduler;
+
+    /// @brief Read only view of the frame timing, published by the engine's FrameScheduler every frame
+    class Time
+    {
+      public:
+        /// @brief Seconds elapsed between the start of the previous frame and the start of the current one
+        static float GetDeltaTime() noexcept
+        {
+            return S_DELTA_TIME;
+        }
+
+        /// @brief Seconds simulated by every FixedUpdate call
+        static float GetFixedDeltaTime() noexcept
+        {
+            return S_FIXED_DELTA_TIME;
+        }
+
+        /// @brief How far [0, 1) the current frame is between the last fixed step and the next one, used to
+        /// interpolate render state
+        static float GetFixedInterpolationAlpha() noexcept
+        {
+            return S_FIXED_ALPHA;
+        }
+
+        /// @brief Seconds elapsed since the scheduler started
+        static double GetTimeSinceStartup() noexcept
+        {
+            return S_TIME_SINCE_STARTUP;
+        }
+
+        /// @brief Number of frames started since the scheduler started
+        static uint64_t GetFrameCount() noexcept
+        {
+            return S_FRAME_COUNT;
+        }
+
+      private:
+        friend class FrameScheduler;
+
+        static inline float S_DELTA_TIME = 0.0f;
+        static inline float S_FIXED_DELTA_TIME = 0.0f;
+        static inline float S_FIXED_ALPHA = 0.0f;
+        static inline double S_TIME_SINCE_STARTUP = 0.0;
+        static inline uint64_t S_FRAME_COUNT = 0;
+    };
+} // namespace Hush